@@ -0,0 +1,185 @@
+#include <algorithm>   // sort, copy
+#include <cmath>       // exp, fabs
+#include <cstdlib>     // atoll
+#include <iomanip>     // setw, setprecision
+#include <iostream>    // вывод
+#include <limits>      // numeric_limits (края int)
+#include <stdexcept>   // length_error (слишком широкий диапазон)
+#include <vector>      // массивы
+
+#include "../common/bench.hpp"      // общий бенчмарк (прогрев, повторы, медиана/ДИ)
+#include "../common/numa_alloc.hpp" // массив: выравнивание, большие страницы, первое касание
+#include "../common/par_hist.hpp"   // гистограмма по потокам и квантильный скетч
+#include "../common/philox.hpp"     // параллельный счётчиковый генератор
+
+#ifdef _OPENMP
+#include <omp.h>       // библиотека OpenMP
+#endif
+
+using namespace std;    // чтобы не писать std::
+
+// Статистика, которую хотим получить: в task1-task4 были только min / max / mean
+struct Summary {
+    long long mn = 0, mx = 0, mode = 0;
+    double mean = 0, median = 0;
+    long long p90 = 0, p99 = 0;
+
+    bool operator==(const Summary& o) const {
+        return mn == o.mn && mx == o.mx && mode == o.mode && mean == o.mean &&
+               median == o.median && p90 == o.p90 && p99 == o.p99;
+    }
+};
+
+// Эталон: сортируем копию и читаем всё из отсортированного массива
+static Summary summary_sorted(const int* s, long long n) {
+    Summary r;
+    r.mn = s[0];
+    r.mx = s[n - 1];
+    long long sum = 0, best = 0;
+    for (long long i = 0, run = 0; i < n; i++) {
+        sum += s[i];
+        run = (i > 0 && s[i] == s[i - 1]) ? run + 1 : 1;      // длина серии одинаковых
+        if (run > best) { best = run; r.mode = s[i]; }        // первая самая длинная = меньший ключ
+    }
+    r.mean = (double)sum / (double)n;
+    r.median = 0.5 * ((double)s[(n - 1) / 2] + (double)s[n / 2]);
+    r.p90 = s[(long long)(0.90 * (double)(n - 1))];
+    r.p99 = s[(long long)(0.99 * (double)(n - 1))];
+    return r;
+}
+
+// То же из гистограммы (без сортировки)
+static Summary summary_hist(const Histogram& h) {
+    Summary r;
+    r.mn = h.min();
+    r.mx = h.max();
+    r.mode = h.mode();
+    r.mean = h.mean();
+    r.median = h.median();
+    r.p90 = h.percentile(0.90);
+    r.p99 = h.percentile(0.99);
+    return r;
+}
+
+static void print_summary(const char* what, const Summary& s) {
+    cout << left << setw(16) << what << right << " min=" << s.mn << " max=" << s.mx
+         << " mean=" << setprecision(6) << s.mean << " median=" << s.median
+         << " p90=" << s.p90 << " p99=" << s.p99 << " mode=" << s.mode << "\n";
+}
+
+int main(int argc, char** argv) {
+    long long N = (argc > 1) ? atoll(argv[1]) : 5000000;   // как в task4
+
+    cout << "N=" << N << ", threads=" << bench_max_threads()
+         << ", simd=" << stats_isa_name(stats_isa()) << "\n";
+
+    int* arr = numa_alloc_array<int>(N);      // исходные данные
+    int* tmp = numa_alloc_array<int>(N);      // копия для сортировки
+    BenchSuite suite;
+    bool ok = true;
+
+    // ==================== ДИАПАЗОН 1..100 (как в task1-task4) ====================
+
+    philox_int_par(arr, N, 123, 1, 100);      // [1; 100], одинаково при любом числе потоков
+
+    Summary sorted, seq, par;
+    suite.add(bench_measure("range100", "seq", N, [&] {        // сортировка копии
+        sort(tmp, tmp + N);
+        sorted = summary_sorted(tmp, N);
+    }, [&] { copy(arr, arr + N, tmp); }, BenchConfig()));
+    suite.add(bench_measure("range100", "hist1", N, [&] { seq = summary_hist(hist_build(arr, N, 1, 100)); }));
+    suite.add(bench_measure("range100", "hist", N, [&] { par = summary_hist(hist_build_par(arr, N, 1, 100)); }));
+    print_summary("sort:", sorted);
+    print_summary("hist (1 thread):", seq);
+    print_summary("hist (par):", par);
+    ok = ok && seq == sorted && par == sorted;
+
+    // ==================== ДИАПАЗОН 1..10: быстрый путь SIMD ====================
+
+    philox_int_par(arr, N, 123, 1, 10);
+    Summary small, smallScalar;
+    std::vector<long long> sub(4 * hist_stride(10));
+    suite.add(bench_measure("range10", "seq", N, [&] {          // скалярное ядро (4 подгистограммы)
+        Histogram h;
+        h.lo = 1;
+        h.counts.assign(10, 0);
+        h.n = hist_kernel_scalar(arr, N, 1, 10, h.counts.data(), sub.data(), hist_stride(10));
+        smallScalar = summary_hist(h);
+    }));
+    suite.add(bench_measure("range10", "hist1", N, [&] { small = summary_hist(hist_build(arr, N, 1, 10)); }));
+    suite.add(bench_measure("range10", "hist", N, [&] { small = summary_hist(hist_build_par(arr, N, 1, 10)); }));
+    print_summary("range 1..10:", small);
+    ok = ok && small == smallScalar;
+
+    // ==================== КРАЯ int: быстрый путь против скалярного ядра ====================
+
+    // 8 x INT_MAX, 56 x INT_MIN и хвост (не кратно 16); диапазоны у границ int и шире int
+    {
+        const long long imin = numeric_limits<int>::min(), imax = numeric_limits<int>::max();
+        std::vector<int> e(67, (int)imin);
+        for (int i = 0; i < 8; i++) e[(size_t)i * 8] = (int)imax;
+        e[64] = (int)imax - 1;
+        e[66] = (int)imin + 2;
+        bool edgeOk = true;
+        for (long long lo : {imax - 5, imax - 15, imax - 2, imin, imin - 3}) {
+            long long hi = (lo == imax - 5) ? imax + 10 : lo + ((lo == imin) ? 2 : 15);
+            Histogram fast = hist_build(e.data(), (long long)e.size(), lo, hi);
+            std::vector<long long> cnt((size_t)(hi - lo + 1), 0), sub(4 * hist_stride(hi - lo + 1));
+            long long in = hist_kernel_scalar(e.data(), (long long)e.size(), lo, hi - lo + 1, cnt.data(),
+                                              sub.data(), hist_stride(hi - lo + 1));
+            edgeOk = edgeOk && fast.n == in && fast.counts == cnt;
+        }
+        cout << "int edges (simd=" << stats_isa_name(stats_isa()) << " vs scalar): " << (edgeOk ? "OK" : "MISMATCH") << "\n";
+        ok = ok && edgeOk;
+    }
+
+    // ==================== ВЫБОР ГИСТОГРАММА / СКЕТЧ ====================
+
+    // [1; 10] — точная гистограмма; [INT_MIN; INT_MAX] — скетч (hist_build_par отказывается:
+    // 2^32 счётчиков на поток); медиана скетча — в пределах относительной ошибки ALPHA
+    {
+        Distribution narrow = dist_build_par(arr, N, 1, 10);
+        Distribution wide = dist_build_par(arr, N, numeric_limits<int>::min(), numeric_limits<int>::max());
+        bool rejected = false;
+        try { hist_build_par(arr, N, numeric_limits<int>::min(), numeric_limits<int>::max()); }
+        catch (const std::length_error&) { rejected = true; }
+        bool distOk = narrow.exact && !wide.exact && rejected && narrow.count() == N && wide.count() == N &&
+                      narrow.median() == small.median && fabs(wide.median() - small.median) <= QuantileSketch::ALPHA * small.median &&
+                      wide.min() == small.mn && wide.max() == small.mx;
+        cout << "dist_build_par: [1;10] " << (narrow.exact ? "hist" : "sketch") << " median=" << narrow.median()
+             << ", [INT_MIN;INT_MAX] " << (wide.exact ? "hist" : "sketch") << " median=" << wide.median()
+             << ", hist_build_par on int range " << (rejected ? "rejected" : "NOT rejected") << (distOk ? " OK" : " MISMATCH") << "\n";
+        ok = ok && distOk;
+    }
+
+    // ==================== ШИРОКИЙ ДИАПАЗОН: квантильный скетч ====================
+
+    // x = e^(20u) - 1: от 0 до ~5e8, плотность падает как 1/x — гистограмма по ключам не годится
+    std::vector<double> x((size_t)N), xs((size_t)N);
+    philox_uniform_par(x.data(), N, 321, 0.0, 1.0);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < N; i++) x[(size_t)i] = std::exp(20.0 * x[(size_t)i]) - 1.0;
+
+    QuantileSketch sk;
+    suite.add(bench_measure("wide", "seq", N, [&] { sort(xs.begin(), xs.end()); },
+                            [&] { copy(x.begin(), x.end(), xs.begin()); }, BenchConfig()));
+    suite.add(bench_measure("wide", "sketch1", N, [&] { sk = sketch_build(x.data(), N); }));
+    suite.add(bench_measure("wide", "sketch", N, [&] { sk = sketch_build_par(x.data(), N); }));
+
+    cout << "wide range (sketch, alpha=" << QuantileSketch::ALPHA << "):\n";
+    for (double q : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        double exact = xs[(size_t)(q * (double)(N - 1))], est = sk.quantile(q);
+        double rel = exact != 0.0 ? fabs(est - exact) / fabs(exact) : fabs(est);
+        cout << "  q=" << setw(6) << q << " exact=" << setw(14) << exact << " sketch=" << setw(14) << est
+             << " rel_err=" << rel << "\n";
+        ok = ok && rel <= QuantileSketch::ALPHA + 1e-12;
+    }
+
+    suite.print_table();
+    suite.write_csv("hist_results.csv");
+    cout << (ok ? "OK" : "ERROR: mismatch") << ", saved hist_results.csv\n";
+
+    numa_free(arr, N);
+    numa_free(tmp, N);
+    return ok ? 0 : 1;
+}
@@ -1,22 +1,24 @@
 #include <iostream>    // ввод и вывод (cout, endl)
 #include <random>      // генерация случайных чисел (mt19937, distribution)
-#include <chrono>      // измерение времени выполнения
-#include <limits>      // numeric_limits<T>::min / max
+
+#include "../common/bench.hpp"     // общий бенчмарк (прогрев, повторы, медиана/ДИ)
+#include "../common/numa_alloc.hpp" // массив: выравнивание, большие страницы, первое касание
+#include "../common/par_stats.hpp" // однопроходная SIMD-редукция (min/max/sum)
 
 #ifdef _OPENMP
 #include <omp.h>       // библиотека OpenMP
 #endif
 
 using namespace std;    // упрощаем доступ к стандартной библиотеке
-using namespace chrono; // упрощаем работу с таймерами
 
 int main() {
     const int N = 1000000;   // размер массива (1 миллион элементов)
 
     // ==================== СОЗДАНИЕ И ЗАПОЛНЕНИЕ МАССИВА ====================
 
-    // Выделяем память под массив в куче
-    int* arr = new int[N];
+    // Выделяем память под массив: страницы "касаются" параллельно теми же
+    // кусками, что потом обрабатывают потоки (на NUMA — память рядом с потоком)
+    int* arr = numa_alloc_array<int>(N);
 
     // Инициализируем генератор случайных чисел
     mt19937 rng(123);        // фиксированный seed (результаты воспроизводимы)
@@ -31,93 +33,69 @@ int main() {
 
     // ==================== ПОСЛЕДОВАТЕЛЬНЫЙ ПОИСК ====================
 
-    // Засекаем начало последовательного алгоритма
-    auto startSeq = high_resolution_clock::now();
-
     // Начальные значения минимума и максимума
     int minSeq = arr[0];     // предполагаем, что первый элемент — минимум
     int maxSeq = arr[0];     // и максимум
 
-    // Последовательный проход по массиву
-    for (int i = 1; i < N; i++) {
-        if (arr[i] < minSeq) minSeq = arr[i];  // обновляем минимум
-        if (arr[i] > maxSeq) maxSeq = arr[i];  // обновляем максимум
-    }
-
-    // Засекаем конец последовательного алгоритма
-    auto endSeq = high_resolution_clock::now();
-
-    // Считаем время выполнения в микросекундах
-    auto timeSeq =
-        duration_cast<microseconds>(endSeq - startSeq).count();
-
-    // ==================== ПАРАЛЛЕЛЬНЫЙ ПОИСК (OpenMP) ====================
-
-    // Глобальные минимум и максимум
-    int globalMin = numeric_limits<int>::max(); // начальное значение — максимум int
-    int globalMax = numeric_limits<int>::min(); // начальное значение — минимум int
+    // Замер общим бенчмарком: прогрев + повторы, берём медиану
+    BenchResult seq = bench_measure("minmax", "seq", N, [&] {
+        minSeq = arr[0];
+        maxSeq = arr[0];
+        // Последовательный проход по массиву
+        for (int i = 1; i < N; i++) {
+            if (arr[i] < minSeq) minSeq = arr[i];  // обновляем минимум
+            if (arr[i] > maxSeq) maxSeq = arr[i];  // обновляем максимум
+        }
+    });
 
-    // Засекаем начало параллельного алгоритма
-    auto startPar = high_resolution_clock::now();
+    // Медиана времени в микросекундах
+    double timeSeq = seq.median_ms * 1000.0;
 
-#ifdef _OPENMP
-    #pragma omp parallel                     // создаём команду потоков
-    {
-        // Локальные значения минимума и максимума для каждого потока
-        int localMin = numeric_limits<int>::max();
-        int localMax = numeric_limits<int>::min();
-
-        #pragma omp for nowait                // делим цикл по потокам, без ожидания в конце
-        for (int i = 0; i < N; i++) {
-            if (arr[i] < localMin) localMin = arr[i]; // локальный минимум
-            if (arr[i] > localMax) localMax = arr[i]; // локальный максимум
-        }
+    // ==================== ПАРАЛЛЕЛЬНЫЙ ПОИСК (OpenMP + SIMD) ====================
 
-        #pragma omp critical                  // критическая секция
-        {
-            // безопасно обновляем глобальные значения
-            if (localMin < globalMin) globalMin = localMin;
-            if (localMax > globalMax) globalMax = localMax;
-        }
-    }
-#else
-    // Если OpenMP не поддерживается — обычный последовательный проход
-    for (int i = 0; i < N; i++) {
-        if (arr[i] < globalMin) globalMin = arr[i];
-        if (arr[i] > globalMax) globalMax = arr[i];
-    }
-#endif
+    int globalMin = 0;       // глобальный минимум
+    int globalMax = 0;       // глобальный максимум
 
-    // Засекаем конец параллельного алгоритма
-    auto endPar = high_resolution_clock::now();
+    BenchResult par = bench_measure("minmax", "par", N, [&] {
+        // Один проход: каждый поток считает min/max своего куска SIMD-ядром,
+        // затем частичные результаты объединяются (см. common/par_stats.hpp)
+        Stats<int> st = compute_stats_par(arr, N);
+        globalMin = st.min;
+        globalMax = st.max;
+    });
 
-    // Считаем время выполнения параллельного алгоритма
-    auto timePar =
-        duration_cast<microseconds>(endPar - startPar).count();
+    // Медиана времени параллельного алгоритма
+    double timePar = par.median_ms * 1000.0;
 
     // ==================== ВЫВОД РЕЗУЛЬТАТОВ ====================
 
     cout << "Sequential Min: " << minSeq << endl;      // минимум (seq)
     cout << "Sequential Max: " << maxSeq << endl;      // максимум (seq)
-    cout << "Sequential Time: " << timeSeq << " us\n\n"; // время (seq)
+    cout << "Sequential Time: " << timeSeq << " us (median of " << seq.reps << ")\n\n"; // время (seq)
 
     cout << "Parallel Min: " << globalMin << endl;     // минимум (par)
     cout << "Parallel Max: " << globalMax << endl;     // максимум (par)
-    cout << "Parallel Time: " << timePar << " us" << endl; // время (par)
+    cout << "Parallel Time: " << timePar << " us (median of " << par.reps << ")" << endl; // время (par)
 
 #ifdef _OPENMP
     cout << "Threads used: " << omp_get_max_threads() << endl; // число потоков
 #endif
+    cout << "SIMD kernel: " << stats_isa_name(stats_isa()) << endl; // выбранное ядро
 
     // Подсчёт ускорения (speedup)
     if (timePar > 0) {
         cout << "Speedup: "
-             << (double)timeSeq / timePar << "x" << endl;
+             << timeSeq / timePar << "x" << endl;
     }
 
+    // Аппаратные счётчики на один проход (только при PERF_COUNTERS=1):
+    // IPC, промахи LLC / ветвлений / dTLB по потокам
+    perf_print(seq.perf);
+    perf_print(par.perf);
+
     // ==================== ОСВОБОЖДЕНИЕ ПАМЯТИ ====================
 
-    delete[] arr;            // освобождаем динамически выделенную память
+    numa_free(arr, N);       // освобождаем выделенную память
 
     return 0;                // успешное завершение программы
 }
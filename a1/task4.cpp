@@ -1,19 +1,20 @@
 #include <iostream>   // ввод/вывод: cout, endl
 #include <random>     // генератор случайных чисел: mt19937, distribution
-#include <chrono>     // замер времени: high_resolution_clock, duration_cast
+
+#include "../common/bench.hpp"     // общий бенчмарк (прогрев, повторы, медиана/ДИ)
+#include "../common/numa_alloc.hpp" // массив: выравнивание, большие страницы, первое касание
+#include "../common/par_stats.hpp" // однопроходная SIMD-редукция (sum/min/max)
 
 #ifdef _OPENMP
 #include <omp.h>      // OpenMP функции (threads и т.п.)
 #endif
 
 using namespace std;    // чтобы не писать std::
-using namespace chrono; // чтобы не писать chrono::
 
 int main() {
     const int N = 5000000;     // размер массива (5 миллионов элементов)
-    const int RUNS = 5;        // сколько раз повторяем замер (для более стабильного времени)
 
-    int* arr = new int[N];     // выделяем память под массив в куче (heap)
+    int* arr = numa_alloc_array<int>(N); // выделяем память (первое касание параллельно, по кускам потоков)
 
     // ==================== ЗАПОЛНЕНИЕ МАССИВА ====================
 
@@ -34,65 +35,49 @@ int main() {
 
     // ==================== SEQUENTIAL (последовательно) ====================
 
-    // Последовательный подсчёт среднего (RUNS прогонов)
-    long long totalSeq = 0;    // суммарное время всех прогонов (в микросекундах)
-    double avgSeq = 0.0;       // последнее вычисленное среднее (по факту одинаковое каждый прогон)
-
-    for (int r = 0; r < RUNS; r++) {           // повторяем RUNS раз для усреднения времени
-        auto start = high_resolution_clock::now(); // старт таймера
+    // Замер через общий бенчмарк: прогрев, адаптивное число повторов, медиана и 95% ДИ
+    double avgSeq = 0.0;       // вычисленное среднее (одинаковое каждый прогон)
 
+    BenchResult seq = bench_measure("average", "seq", N, [&] {
         long long sumSeq = 0;                  // сумма элементов (последовательная)
         for (int i = 0; i < N; i++) {          // обычный цикл по массиву
             sumSeq += arr[i];                  // прибавляем текущий элемент к сумме
         }
-
-        auto end = high_resolution_clock::now(); // конец таймера
-        totalSeq += duration_cast<microseconds>(end - start).count(); // добавляем время этого прогона в totalSeq
-
         avgSeq = static_cast<double>(sumSeq) / N; // считаем среднее (double, чтобы деление было не целочисленным)
-    }
+    });
 
     // ==================== PARALLEL (параллельно) ====================
 
-    // Параллельный подсчёт среднего через OpenMP reduction (RUNS прогонов)
-    long long totalPar = 0;    // суммарное время параллельных прогонов
+    // Параллельный подсчёт среднего: OpenMP + SIMD
     double avgPar = 0.0;       // среднее значение (параллельная версия)
 
-    for (int r = 0; r < RUNS; r++) {           // повторяем RUNS раз
-        auto start = high_resolution_clock::now(); // старт таймера
-
-        long long sumPar = 0;                  // общая сумма для reduction
-
-#ifdef _OPENMP
-        #pragma omp parallel for reduction(+:sumPar) // параллельный цикл + безопасная сумма через reduction
-#endif
-        for (int i = 0; i < N; i++) {          // каждый поток берёт свой кусок индексов
-            sumPar += arr[i];                  // локально суммирует, а потом OpenMP объединит всё в sumPar
-        }
-
-        auto end = high_resolution_clock::now(); // конец таймера
-        totalPar += duration_cast<microseconds>(end - start).count(); // добавляем время прогона
-
+    BenchResult par = bench_measure("average", "par", N, [&] {
+        // Потоки суммируют свои куски SIMD-ядром (int64-накопители), затем частичные суммы объединяются
+        long long sumPar = compute_stats_par(arr, N).sum;
         avgPar = static_cast<double>(sumPar) / N; // считаем среднее значение
-    }
-
-    // ==================== ИТОГИ (усреднение времени) ====================
+    });
 
-    // Среднее время по прогонам (чтобы было меньше влияния случайных колебаний)
-    double avgTimeSeq = (double)totalSeq / RUNS; // среднее время seq (в микросекундах)
-    double avgTimePar = (double)totalPar / RUNS; // среднее время par (в микросекундах)
+    // ==================== ИТОГИ ====================
 
     // Вывод результатов
     cout << "Sequential average: " << avgSeq << "\n"; // среднее значение (seq)
     cout << "Parallel average:   " << avgPar << "\n"; // среднее значение (par)
-    cout << "Avg time (seq): " << avgTimeSeq << " us\n"; // среднее время seq
-    cout << "Avg time (par): " << avgTimePar << " us\n"; // среднее время par
-
-    // Считаем ускорение (speedup)
-    if (avgTimePar > 0.0) {                        // защита от деления на 0
-        cout << "Speedup: " << (avgTimeSeq / avgTimePar) << "x\n"; // во сколько раз быстрее
+    cout << "Median time (seq): " << seq.median_ms * 1000.0 << " us"   // медиана seq
+         << " (95% CI " << seq.ci_lo_ms * 1000.0 << ".." << seq.ci_hi_ms * 1000.0
+         << ", runs " << seq.reps << ")\n";
+    cout << "Median time (par): " << par.median_ms * 1000.0 << " us"   // медиана par
+         << " (95% CI " << par.ci_lo_ms * 1000.0 << ".." << par.ci_hi_ms * 1000.0
+         << ", runs " << par.reps << ")\n";
+
+    // Считаем ускорение (speedup) по медианам
+    if (par.median_ms > 0.0) {                     // защита от деления на 0
+        cout << "Speedup: " << (seq.median_ms / par.median_ms) << "x\n"; // во сколько раз быстрее
     }
 
-    delete[] arr;       // освобождаем память массива (обязательно для new[])
+    // Аппаратные счётчики на один проход (только при PERF_COUNTERS=1)
+    perf_print(seq.perf);
+    perf_print(par.perf);
+
+    numa_free(arr, N);  // освобождаем память массива
     return 0;           // успешное завершение программы
 }
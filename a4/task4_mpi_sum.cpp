@@ -0,0 +1,65 @@
+#include <mpi.h>                         // MPI
+#include <cstdio>                        // printf
+#include <vector>                        // vector
+
+#include "../common/philox.hpp"          // счётчиковый генератор: каждый процесс генерирует свой кусок
+#include "../common/mpi_hybrid.hpp"      // MPI_Init_thread + потоки OpenMP на процесс
+
+int main(int argc, char** argv) {
+    // гибридный режим: процесс на сокет / узел, внутри — потоки OpenMP
+    // (MPI вызывает только главный поток: MPI_THREAD_FUNNELED)
+    HybridInfo hy = hybrid_init(&argc, &argv);
+
+    int rank = 0;                        // номер процесса
+    int size = 1;                        // число процессов
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);// получаем rank
+    MPI_Comm_size(MPI_COMM_WORLD, &size);// получаем size
+
+    const int N = 10'000'000;            // общий размер массива (можно менять)
+    int base = N / size;                 // базовый размер куска
+    int rem  = N % size;                 // остаток
+
+    int local_n = base + (rank < rem ? 1 : 0); // сколько элементов у текущего процесса
+    long long first = (long long)base * rank + (rank < rem ? rank : rem); // глобальный индекс начала куска
+
+    // каждый процесс сразу генерирует свой кусок (Philox, seed 42, числа 0..10):
+    // данные одинаковы при любом числе процессов, root ничего не рассылает (нет Scatterv)
+    std::vector<int> local(local_n);     // локальный кусок у каждого процесса
+    philox_int_par(local.data(), local_n, 42, 0, 10, first);
+
+    MPI_Barrier(MPI_COMM_WORLD);         // синхронизация перед временем
+    double t1 = MPI_Wtime();             // старт времени
+
+    // сумма кусками: кусок c считают потоки OpenMP, его частичная сумма уходит
+    // в неблокирующую MPI_Ireduce и идёт по сети, пока считается кусок c+1
+    const int CHUNKS = 4;                // число кусков
+    long long part[CHUNKS] = {0};        // частичные суммы кусков (локальные)
+    long long part_all[CHUNKS] = {0};    // они же, сложенные по процессам (на root)
+    MPI_Request reqs[CHUNKS];            // запросы неблокирующих редукций
+    for (int c = 0; c < CHUNKS; c++) {   // по кускам
+        int lo = (int)((long long)local_n * c / CHUNKS);       // начало куска
+        int hi = (int)((long long)local_n * (c + 1) / CHUNKS); // конец куска
+        long long s = 0;                 // сумма куска
+        #pragma omp parallel for simd reduction(+:s)
+        for (int i = lo; i < hi; i++) s += local[i];          // считаем потоками
+        part[c] = s;
+        MPI_Ireduce(&part[c], &part_all[c], 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD, &reqs[c]);
+        int done = 0;                    // продвигаем уже запущенные редукции
+        MPI_Testall(c + 1, reqs, &done, MPI_STATUSES_IGNORE);
+    }
+    MPI_Waitall(CHUNKS, reqs, MPI_STATUSES_IGNORE);           // ждём оставшиеся
+
+    long long total_sum = 0;             // общий результат на root
+    for (int c = 0; c < CHUNKS; c++) total_sum += part_all[c];
+
+    MPI_Barrier(MPI_COMM_WORLD);         // синхронизация
+    double t2 = MPI_Wtime();             // стоп времени
+
+    if (rank == 0) {                     // печатаем только на root
+        printf("Task4 MPI sum | N=%d | processes=%d | threads=%d | cores=%d (%s) | time=%.6f s | sum=%lld\n",
+               N, size, hy.threads, hy.cores(), hy.config(), (t2 - t1), total_sum);
+    }
+
+    MPI_Finalize();                      // завершаем MPI
+    return 0;                            // конец
+}
@@ -0,0 +1,82 @@
+// gemm.hpp
+// Умножение матриц float C = A * B на CPU (row-major, A: N x M, B: M x K, C: N x K —
+// обозначения как в p6). Эталон для проверки OpenCL-ядер, который не медленнее самих ядер:
+//   - блоки GEMM_MC x GEMM_KC матрицы A и GEMM_KC x GEMM_NC матрицы B остаются в L1/L2
+//     (полоса B 256 x 256 float = 256 КБ), блоки (строки, столбцы) C — OpenMP;
+//   - микроядро: GEMM_MR строк x GEMM_NR столбцов C в регистрах на всём цикле по k
+//     (8 zmm при 4 x 32 — столько независимых FMA хватает, чтобы скрыть задержку),
+//     на одну загрузку строки B — GEMM_MR FMA; края — простым циклом i-k-j (SIMD);
+//   - gemm_naive — исходный тройной цикл с double-накопителем (для проверки).
+// Накопление во float: на M = 512 отличие от double ~1e-4, как у OpenCL-ядер.
+#pragma once
+
+#include <algorithm>  // min, fill
+#include <cstddef>    // size_t
+
+const int GEMM_MR = 4;
+const int GEMM_NR = 32;
+const int GEMM_MC = 64;
+const int GEMM_NC = 256;
+const int GEMM_KC = 256;
+
+// C += A * B для блока m x n с внутренней размерностью kk (произвольные ведущие размерности)
+inline void gemm_tile(float* C, int ldc, const float* A, int lda, const float* B, int ldb,
+                      int m, int n, int kk) {
+    int m4 = m / GEMM_MR * GEMM_MR, n32 = n / GEMM_NR * GEMM_NR;
+    for (int i = 0; i < m4; i += GEMM_MR) {
+        for (int j0 = 0; j0 < n32; j0 += GEMM_NR) {
+            float acc[GEMM_MR][GEMM_NR];
+            for (int r = 0; r < GEMM_MR; ++r)
+                for (int j = 0; j < GEMM_NR; ++j) acc[r][j] = C[(size_t)(i + r) * ldc + j0 + j];
+            for (int k = 0; k < kk; ++k) {
+                const float* b = B + (size_t)k * ldb + j0;
+                for (int r = 0; r < GEMM_MR; ++r) {
+                    float aik = A[(size_t)(i + r) * lda + k];
+                    #pragma omp simd
+                    for (int j = 0; j < GEMM_NR; ++j) acc[r][j] += aik * b[j];
+                }
+            }
+            for (int r = 0; r < GEMM_MR; ++r)
+                for (int j = 0; j < GEMM_NR; ++j) C[(size_t)(i + r) * ldc + j0 + j] = acc[r][j];
+        }
+    }
+    // края: строки m4.. (все столбцы) и столбцы n32.. (строки до m4)
+    for (int i = 0; i < m; ++i) {
+        int j0 = (i < m4) ? n32 : 0;
+        if (j0 == n) continue;
+        float* c = C + (size_t)i * ldc;
+        const float* a = A + (size_t)i * lda;
+        for (int k = 0; k < kk; ++k) {
+            float aik = a[k];
+            const float* b = B + (size_t)k * ldb;
+            #pragma omp simd
+            for (int j = j0; j < n; ++j) c[j] += aik * b[j];
+        }
+    }
+}
+
+// C = A * B на всех потоках OpenMP: задачи — блоки C (GEMM_MC x GEMM_NC), внутри — по GEMM_KC
+inline void gemm_blocked_par(const float* A, const float* B, float* C, int N, int M, int K) {
+    int mb = (N + GEMM_MC - 1) / GEMM_MC, nb = (K + GEMM_NC - 1) / GEMM_NC;
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int I = 0; I < mb; ++I)
+        for (int J = 0; J < nb; ++J) {
+            int i0 = I * GEMM_MC, j0 = J * GEMM_NC;
+            int m = std::min(GEMM_MC, N - i0), n = std::min(GEMM_NC, K - j0);
+            float* c = C + (size_t)i0 * K + j0;
+            for (int i = 0; i < m; ++i) std::fill(c + (size_t)i * K, c + (size_t)i * K + n, 0.0f);
+            for (int k0 = 0; k0 < M; k0 += GEMM_KC)
+                gemm_tile(c, K, A + (size_t)i0 * M + k0, M, B + (size_t)k0 * K + j0, K,
+                          m, n, std::min(GEMM_KC, M - k0));
+        }
+}
+
+// Исходный тройной цикл (double-накопитель)
+inline void gemm_naive(const float* A, const float* B, float* C, int N, int M, int K) {
+    for (int r = 0; r < N; ++r)
+        for (int c = 0; c < K; ++c) {
+            double sum = 0.0;
+            for (int i = 0; i < M; ++i) sum += (double)A[(size_t)r * M + i] * (double)B[(size_t)i * K + c];
+            C[(size_t)r * K + c] = (float)sum;
+        }
+}
@@ -0,0 +1,92 @@
+// bench_accuracy.cpp
+// Точность и скорость суммирования float-массивов (common/accurate_sum.hpp):
+//   naive/float   — float local_sum += x (как в p10/task4_mpi)
+//   naive/double  — double sum += x (как в p10/task1, p9/task1)
+//   pairwise/*    — попарное суммирование (float / double накопители)
+//   neumaier/*    — компенсированное по SIMD-дорожкам (float / double накопители)
+//   */par         — то же на всех потоках OpenMP
+// Наборы данных (float):
+//   uniform  — [0; 1)
+//   offset   — 1e4 + [0; 1)      (большое среднее: float-сумма быстро теряет младшие биты)
+//   cancel   — +-[0; 1e6) + [0; 1) (знаки чередуются, сумма мала по сравнению со слагаемыми)
+//   wide     — +-10^[-8; 8), знаки чередуются (широкий диапазон порядков: тут
+//              ошибается даже double-накопитель, а Ноймайер — нет)
+// Эталон — сумма Ноймайера в long double. Ошибка — относительная |s - ref| / |ref|.
+// Результаты: таблица + accuracy_results.csv.
+//
+// Запуск: ./bench_accuracy [n]   (по умолчанию 5000000 — как в p10/task4_mpi)
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../common/accurate_sum.hpp"
+#include "../common/bench.hpp"
+#include "../common/numa_alloc.hpp"
+#include "../common/philox.hpp"
+
+using namespace std;
+
+volatile double sink = 0.0;   // результат замера, чтобы цикл не выбросили
+
+int main(int argc, char** argv) {
+    long long n = (argc > 1) ? stoll(argv[1]) : 5000000;
+
+    numa_vector<float> a(n);
+    vector<float> tmp(n);
+
+    struct Variant { string name; function<double(const float*, long long)> fn; };
+    vector<Variant> variants = {
+        {"naive/float",     [](const float* x, long long m) { return (double)sum_naive<float>(x, m); }},
+        {"naive/double",    [](const float* x, long long m) { return sum_naive<double>(x, m); }},
+        {"pairwise/float",  [](const float* x, long long m) { return (double)sum_pairwise<float>(x, m); }},
+        {"pairwise/double", [](const float* x, long long m) { return sum_pairwise<double>(x, m); }},
+        {"neumaier/float",  [](const float* x, long long m) { return (double)sum_neumaier<float>(x, m); }},
+        {"neumaier/double", [](const float* x, long long m) { return sum_neumaier<double>(x, m); }},
+        {"pairwise/par",    [](const float* x, long long m) { return sum_pairwise_par<double>(x, m); }},
+        {"neumaier/par",    [](const float* x, long long m) { return sum_accurate_par(x, m); }},
+    };
+
+    ofstream csv("accuracy_results.csv");
+    csv << "data,variant,n,threads,median_ms,gbs,rel_error\n";
+    cout << left << setw(9) << "data" << setw(17) << "variant" << right << setw(12) << "median_ms"
+         << setw(9) << "GB/s" << setw(14) << "rel_error" << "\n";
+
+    for (string data : {"uniform", "offset", "cancel", "wide"}) {
+        // ---------- данные ----------
+        philox_uniform_par(a.data(), n, 123, 0.f, 1.f);
+        if (data == "offset") {
+            for (long long i = 0; i < n; ++i) a[i] += 1e4f;
+        } else if (data == "cancel") {
+            philox_uniform_par(tmp.data(), n, 456, 0.f, 1e6f);
+            for (long long i = 0; i < n; ++i) a[i] += (i & 1) ? -tmp[i] : tmp[i];
+        } else if (data == "wide") {
+            philox_uniform_par(tmp.data(), n, 789, -8.f, 8.f);
+            for (long long i = 0; i < n; ++i) a[i] = (i & 1 ? -1.f : 1.f) * a[i] * powf(10.f, tmp[i]);
+        }
+
+        // эталон: Ноймайер в long double
+        NeumaierSum<long double> ref;
+        for (long long i = 0; i < n; ++i) ref.add((long double)a[i]);
+        long double exact = ref.value();
+
+        for (const auto& v : variants) {
+            double s = 0.0;
+            BenchResult r = bench_measure(v.name, data, n, [&] { s = v.fn(a.data(), n); sink = s; });
+            double err = exact != 0 ? (double)(fabsl((long double)s - exact) / fabsl(exact)) : fabs(s);
+            double gbs = (double)n * sizeof(float) / (r.median_ms * 1e-3) / 1e9;
+            char buf[160];
+            snprintf(buf, sizeof(buf), "%-9s%-17s%12.4f%9.2f%14.3e\n",
+                     data.c_str(), v.name.c_str(), r.median_ms, gbs, err);
+            cout << buf;
+            csv << data << "," << v.name << "," << n << "," << r.threads << ","
+                << r.median_ms << "," << gbs << "," << err << "\n";
+        }
+    }
+    cout << "Saved: accuracy_results.csv\n";
+    return 0;
+}
@@ -0,0 +1,106 @@
+// bench_compare.cpp
+// Единый запуск сравнений "последовательно vs параллельно" из заданий
+// на общем бенчмарке (common/bench.hpp):
+//   minmax    — a1/task3, a2/task2 (поиск min/max, int 1..100)
+//   average   — a1/task4, p1/task3 (среднее, int 1..100)
+//   sum_sumsq — p10/task1 (сумма и сумма квадратов, double [0;1))
+//   merge     — p2 (сортировка слиянием, int 1..100000)
+//   radix     — p2 (radix-сортировка, int 1..100000)
+// Для каждого размера: seq один раз, par — для каждого числа потоков 1,2,4,...
+// Результаты: таблица в консоль + bench_results.csv + bench_results.json.
+//
+// Запуск: ./bench_compare [size1 size2 ...]   (по умолчанию 10000 1000000 10000000)
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../common/bench.hpp"
+#include "../common/numa_alloc.hpp"
+#include "../common/par_stats.hpp"
+#include "../common/par_sort.hpp"
+#include "../common/radix_sort.hpp"
+
+using namespace std;
+
+volatile long long sinkI = 0;   // чтобы компилятор не выкинул последовательные циклы
+volatile double sinkD = 0.0;
+
+int main(int argc, char** argv) {
+    vector<long long> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(stoll(argv[i]));
+    if (sizes.empty()) sizes = {10000, 1000000, 10000000};
+
+    vector<int> threads = bench_thread_counts();   // до изменения числа потоков
+    BenchSuite suite;
+
+    BenchConfig sortCfg;                           // сортировки долгие: без прогрева
+    sortCfg.warmup = 0;
+    sortCfg.min_reps = 3;
+
+    for (long long n : sizes) {
+        // ---------- данные ----------
+        numa_vector<int> small(n), keys(n);   // первое касание параллельно (NUMA)
+        numa_vector<double> real(n);
+        mt19937 rng(123);
+        uniform_int_distribution<int> d100(1, 100);
+        uniform_int_distribution<int> d100k(1, 100000);
+        uniform_real_distribution<double> d01(0.0, 1.0);
+        for (long long i = 0; i < n; ++i) {
+            small[i] = d100(rng);
+            keys[i] = d100k(rng);
+            real[i] = d01(rng);
+        }
+        numa_vector<int> work(n);
+        auto copyKeys = [&] { copy(keys.begin(), keys.end(), work.begin()); };
+
+        // ---------- последовательные версии (как в заданиях) ----------
+        bench_set_threads(1);
+        suite.add(bench_measure("minmax", "seq", n, [&] {
+            int mn = small[0], mx = small[0];
+            for (long long i = 1; i < n; ++i) {
+                if (small[i] < mn) mn = small[i];
+                if (small[i] > mx) mx = small[i];
+            }
+            sinkI = mn + mx;
+        }));
+        suite.add(bench_measure("average", "seq", n, [&] {
+            long long sum = 0;
+            for (long long i = 0; i < n; ++i) sum += small[i];
+            sinkI = sum;
+        }));
+        suite.add(bench_measure("sum_sumsq", "seq", n, [&] {
+            double sum = 0.0, sumsq = 0.0;
+            for (long long i = 0; i < n; ++i) { sum += real[i]; sumsq += real[i] * real[i]; }
+            sinkD = sum + sumsq;
+        }));
+        suite.add(bench_measure("merge", "seq", n, [&] { merge_sort(work.data(), n); }, copyKeys, sortCfg));
+        suite.add(bench_measure("radix", "seq", n, [&] { radix_sort(work.data(), n); }, copyKeys, sortCfg));
+
+        // ---------- параллельные версии, перебор потоков ----------
+        for (int t : threads) {
+            bench_set_threads(t);
+            suite.add(bench_measure("minmax", "par", n, [&] {
+                Stats<int> s = compute_stats_par(small.data(), n);
+                sinkI = s.min + s.max;
+            }));
+            suite.add(bench_measure("average", "par", n, [&] {
+                sinkI = compute_stats_par(small.data(), n).sum;
+            }));
+            suite.add(bench_measure("sum_sumsq", "par", n, [&] {
+                Stats<double> s = compute_stats_par(real.data(), n);
+                sinkD = s.sum + s.sumsq;
+            }));
+            suite.add(bench_measure("merge", "par", n, [&] { merge_sort_par(work.data(), n); }, copyKeys, sortCfg));
+            suite.add(bench_measure("radix", "par", n, [&] { radix_sort_par(work.data(), n); }, copyKeys, sortCfg));
+        }
+    }
+
+    cout << "simd=" << stats_isa_name(stats_isa()) << "\n";
+    suite.print_table();
+    suite.write_csv("bench_results.csv");
+    suite.write_json("bench_results.json");
+    cout << "Saved: bench_results.csv, bench_results.json\n";
+    return 0;
+}
@@ -0,0 +1,273 @@
+// accurate_sum.hpp
+// Точное суммирование (в том числе float-данных) без потери скорости:
+//  - sum_naive     — обычный цикл (как сейчас в заданиях), для сравнения;
+//  - sum_pairwise  — попарное (каскадное) суммирование: блоки по PW_BLOCK
+//                    суммируются векторно, блоки складываются деревом;
+//                    ошибка растёт как log n, а не n;
+//  - sum_neumaier  — компенсированное суммирование Ноймайера (улучшенный Кахан)
+//                    по SIMD-дорожкам: у каждой дорожки своя пара (s, c).
+//                    Накопитель Acc может быть шире данных: float-данные с
+//                    double-накопителем дают точность double при скорости,
+//                    близкой к наивному циклу (узкое место — память);
+//  - *_par         — то же на всех потоках OpenMP; частичные суммы потоков (пары (s, c))
+//                    сливаются в порядке потоков — результат повторяется от запуска к запуску.
+//                    Для своих циклов есть `#pragma omp declare reduction(neumaier_d ...)`
+//                    (порядок слияния там задаёт реализация OpenMP):
+//                        NeumaierSum<double> acc;
+//                        #pragma omp parallel for reduction(neumaier_d : acc)
+//                        for (...) acc.add(x);
+//  - sum_stats     — за один проход сумма и сумма квадратов (обе Ноймайер,
+//                    double) плюс min/max и n: всё, что нужно для mean/variance,
+//                    одной структурой SumStats (её удобно сливать одной редукцией).
+// MPI-операция для тех же пар — в accurate_sum_mpi.hpp, для SumStats — в mpi_stats.hpp.
+// ВАЖНО: компенсация работает только без -ffast-math (иначе компилятор
+// "упрощает" (s - t) + x до нуля). Скорость на уровне наивного цикла и выше — только с
+// -march=native (AVX2 / AVX-512); на базовом SSE2 компенсированные ядра в 2-3 раза медленнее.
+#pragma once
+
+#include <cmath>       // fabs
+#include <cstddef>     // size_t
+#include <limits>      // infinity
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __FAST_MATH__
+#warning "accurate_sum.hpp: -ffast-math ломает компенсированное суммирование"
+#endif
+
+// Сколько независимых дорожек (накопителей) в векторных ядрах: 16 float = один zmm
+const int ACC_LANES = 16;
+// Размер листа попарного суммирования
+const long long PW_BLOCK = 256;
+
+// Пара Ноймайера: сумма s и накопленная ошибка округления c; значение = s + c
+template <typename Acc>
+struct NeumaierSum {
+    Acc s = 0;
+    Acc c = 0;
+
+    void add(Acc x) {
+        Acc t = s + x;
+        // младшие биты теряет то слагаемое, которое меньше по модулю
+        c += (std::fabs(s) >= std::fabs(x)) ? ((s - t) + x) : ((x - t) + s);
+        s = t;
+    }
+    void merge(const NeumaierSum& o) {
+        add(o.s);
+        c += o.c;
+    }
+    Acc value() const { return s + c; }
+};
+
+// Редукции OpenMP по парам (объединение частичных сумм потоков)
+#pragma omp declare reduction(neumaier_d : NeumaierSum<double> : omp_out.merge(omp_in)) \
+    initializer(omp_priv = NeumaierSum<double>())
+#pragma omp declare reduction(neumaier_f : NeumaierSum<float> : omp_out.merge(omp_in)) \
+    initializer(omp_priv = NeumaierSum<float>())
+
+// ==================== ОДИН ПОТОК ====================
+
+// Обычный цикл с накопителем Acc (для сравнения; компилятор НЕ векторизует его
+// без -ffast-math, т.к. сложение float не ассоциативно)
+template <typename Acc, typename T>
+inline Acc sum_naive(const T* a, long long n) {
+    Acc s = 0;
+    for (long long i = 0; i < n; ++i) s += (Acc)a[i];
+    return s;
+}
+
+// Лист попарного суммирования: ACC_LANES независимых накопителей (векторизуется)
+template <typename Acc, typename T>
+inline Acc sum_lanes(const T* a, long long n) {
+    Acc lane[ACC_LANES] = {};
+    long long full = n / ACC_LANES * ACC_LANES;
+    for (long long i = 0; i < full; i += ACC_LANES) {
+        #pragma omp simd
+        for (int l = 0; l < ACC_LANES; ++l) lane[l] += (Acc)a[i + l];
+    }
+    for (long long i = full; i < n; ++i) lane[0] += (Acc)a[i];
+    // дорожки тоже попарно
+    for (int w = ACC_LANES / 2; w > 0; w /= 2)
+        for (int l = 0; l < w; ++l) lane[l] += lane[l + w];
+    return lane[0];
+}
+
+// Попарное суммирование: делим пополам (по границе блока), пока кусок не станет листом
+template <typename Acc, typename T>
+inline Acc sum_pairwise(const T* a, long long n) {
+    if (n <= PW_BLOCK) return sum_lanes<Acc>(a, n);
+    long long half = (n / 2 + PW_BLOCK - 1) / PW_BLOCK * PW_BLOCK;
+    return sum_pairwise<Acc>(a, half) + sum_pairwise<Acc>(a + half, n - half);
+}
+
+// Ноймайер по дорожкам; возвращает пару (чтобы её можно было сливать дальше)
+template <typename Acc, typename T>
+inline NeumaierSum<Acc> sum_neumaier_acc(const T* a, long long n) {
+    Acc s[ACC_LANES] = {}, c[ACC_LANES] = {};
+    long long full = n / ACC_LANES * ACC_LANES;
+    for (long long i = 0; i < full; i += ACC_LANES) {
+        #pragma omp simd
+        for (int l = 0; l < ACC_LANES; ++l) {
+            Acc x = (Acc)a[i + l];
+            Acc t = s[l] + x;
+            Acc e = (std::fabs(s[l]) >= std::fabs(x)) ? ((s[l] - t) + x) : ((x - t) + s[l]);
+            c[l] += e;
+            s[l] = t;
+        }
+    }
+    NeumaierSum<Acc> r;
+    for (int l = 0; l < ACC_LANES; ++l) {
+        r.add(s[l]);
+        r.c += c[l];
+    }
+    for (long long i = full; i < n; ++i) r.add((Acc)a[i]);
+    return r;
+}
+
+template <typename Acc, typename T>
+inline Acc sum_neumaier(const T* a, long long n) {
+    return sum_neumaier_acc<Acc>(a, n).value();
+}
+
+// Точная сумма float-массива: Ноймайер с double-накопителями
+inline double sum_accurate(const float* a, long long n) { return sum_neumaier<double>(a, n); }
+inline double sum_accurate(const double* a, long long n) { return sum_neumaier<double>(a, n); }
+
+// Сумма, сумма квадратов, min, max за один проход
+struct SumStats {
+    NeumaierSum<double> sum;
+    NeumaierSum<double> sumsq;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    long long n = 0;
+
+    void merge(const SumStats& o) {
+        sum.merge(o.sum);
+        sumsq.merge(o.sumsq);
+        min = o.min < min ? o.min : min;
+        max = o.max > max ? o.max : max;
+        n += o.n;
+    }
+    double mean() const { return n > 0 ? sum.value() / (double)n : 0.0; }
+    // sumsq/n - mean^2: суммы компенсированные, но при |mean| >> stddev
+    // вычитание всё равно теряет знаки — для таких данных есть Moments (stream_stats.hpp)
+    double variance() const {
+        if (n == 0) return 0.0;
+        double m = mean(), v = sumsq.value() / (double)n - m * m;
+        return v > 0.0 ? v : 0.0;
+    }
+};
+
+// Те же дорожки, что в sum_neumaier_acc, но две пары (x и x*x) и min/max
+template <typename T>
+inline SumStats sum_stats(const T* a, long long n) {
+    double s[ACC_LANES] = {}, c[ACC_LANES] = {}, q[ACC_LANES] = {}, qc[ACC_LANES] = {};
+    double mn[ACC_LANES], mx[ACC_LANES];
+    for (int l = 0; l < ACC_LANES; ++l) {
+        mn[l] = std::numeric_limits<double>::infinity();
+        mx[l] = -std::numeric_limits<double>::infinity();
+    }
+    long long full = n / ACC_LANES * ACC_LANES;
+    for (long long i = 0; i < full; i += ACC_LANES) {
+        #pragma omp simd
+        for (int l = 0; l < ACC_LANES; ++l) {
+            double x = (double)a[i + l];
+            double t = s[l] + x;
+            c[l] += (std::fabs(s[l]) >= std::fabs(x)) ? ((s[l] - t) + x) : ((x - t) + s[l]);
+            s[l] = t;
+            double x2 = x * x;
+            double u = q[l] + x2;
+            qc[l] += (q[l] >= x2) ? ((q[l] - u) + x2) : ((x2 - u) + q[l]);   // оба >= 0
+            q[l] = u;
+            mn[l] = x < mn[l] ? x : mn[l];
+            mx[l] = x > mx[l] ? x : mx[l];
+        }
+    }
+    SumStats r;
+    for (int l = 0; l < ACC_LANES; ++l) {
+        r.sum.add(s[l]);
+        r.sum.c += c[l];
+        r.sumsq.add(q[l]);
+        r.sumsq.c += qc[l];
+        r.min = mn[l] < r.min ? mn[l] : r.min;
+        r.max = mx[l] > r.max ? mx[l] : r.max;
+    }
+    for (long long i = full; i < n; ++i) {
+        double x = (double)a[i];
+        r.sum.add(x);
+        r.sumsq.add(x * x);
+        r.min = x < r.min ? x : r.min;
+        r.max = x > r.max ? x : r.max;
+    }
+    r.n = n;
+    return r;
+}
+
+// ==================== ВСЕ ПОТОКИ OpenMP ====================
+// Куски потоков [n*t/p; n*(t+1)/p), как в compute_stats_par и numa_first_touch.
+
+// Части потоков (part[t] — кусок потока t) сливаются в порядке потоков, а не в порядке
+// завершения, как у reduction(...): результат одинаков от запуска к запуску
+template <typename Part, typename Fn>
+inline std::vector<Part> acc_parts_par(long long n, Fn&& fn) {
+    int nt = 1;
+#ifdef _OPENMP
+    nt = omp_get_max_threads();
+#endif
+    std::vector<Part> part((size_t)nt);
+    #pragma omp parallel num_threads(nt)
+    {
+        long long t = 0, used = 1;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+        used = omp_get_num_threads();
+#endif
+        long long lo = n * t / used, hi = n * (t + 1) / used;
+        part[(size_t)t] = fn(lo, hi);
+    }
+    return part;
+}
+
+template <typename Acc, typename T>
+inline Acc sum_pairwise_par(const T* a, long long n) {
+    std::vector<Acc> part = acc_parts_par<Acc>(n, [&](long long lo, long long hi) {
+        return sum_pairwise<Acc>(a + lo, hi - lo);
+    });
+    Acc total = 0;
+    for (Acc p : part) total += p;
+    return total;
+}
+
+template <typename T>
+inline NeumaierSum<double> sum_neumaier_par_acc(const T* a, long long n) {
+    std::vector<NeumaierSum<double>> part = acc_parts_par<NeumaierSum<double>>(n, [&](long long lo, long long hi) {
+        return sum_neumaier_acc<double>(a + lo, hi - lo);
+    });
+    NeumaierSum<double> acc;
+    for (const auto& p : part) acc.merge(p);
+    return acc;
+}
+
+template <typename T>
+inline double sum_accurate_par(const T* a, long long n) {
+    return sum_neumaier_par_acc(a, n).value();
+}
+
+// SumStats всеми потоками: части сливаются в порядке потоков (результат не зависит от расписания)
+template <typename T>
+inline SumStats sum_stats_par(const T* a, long long n) {
+    int nt = 1;
+#ifdef _OPENMP
+    nt = omp_get_max_threads();
+#endif
+    if (nt <= 1 || n < 4096) return sum_stats(a, n);
+    std::vector<SumStats> part = acc_parts_par<SumStats>(n, [&](long long lo, long long hi) {
+        return sum_stats(a + lo, hi - lo);
+    });
+    SumStats r;
+    for (const auto& p : part) r.merge(p);
+    return r;
+}
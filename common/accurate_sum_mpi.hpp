@@ -0,0 +1,49 @@
+// accurate_sum_mpi.hpp
+// Компенсированная сумма между процессами MPI: пара Ноймайера (s, c) как
+// производный тип (2 x MPI_DOUBLE) и пользовательская операция MPI_Op,
+// которая сливает пары так же, как OpenMP-редукция neumaier_d.
+//
+//   NeumaierSum<double> local = sum_neumaier_par_acc(a, n), global;
+//   MPI_Reduce(&local, &global, 1, neumaier_mpi_type(), neumaier_mpi_op(), 0, comm);
+//   double sum = global.value();
+//
+// Операция объявлена некоммутативной: MPI сливает части в порядке rank'ов,
+// поэтому результат не меняется от запуска к запуску.
+// Тип и операция создаются при первом вызове (после MPI_Init).
+#pragma once
+
+#include <mpi.h>
+
+#include "accurate_sum.hpp"
+
+static_assert(sizeof(NeumaierSum<double>) == 2 * sizeof(double), "NeumaierSum<double>: ровно два double");
+
+inline MPI_Datatype neumaier_mpi_type() {
+    static MPI_Datatype type = [] {
+        MPI_Datatype t;
+        MPI_Type_contiguous(2, MPI_DOUBLE, &t);
+        MPI_Type_commit(&t);
+        return t;
+    }();
+    return type;
+}
+
+// inout[i] = in[i] (+) inout[i]; in — от процессов с меньшими номерами
+inline void neumaier_mpi_merge(void* in, void* inout, int* len, MPI_Datatype*) {
+    const NeumaierSum<double>* a = (const NeumaierSum<double>*)in;
+    NeumaierSum<double>* b = (NeumaierSum<double>*)inout;
+    for (int i = 0; i < *len; ++i) {
+        NeumaierSum<double> r = a[i];
+        r.merge(b[i]);
+        b[i] = r;
+    }
+}
+
+inline MPI_Op neumaier_mpi_op() {
+    static MPI_Op op = [] {
+        MPI_Op o;
+        MPI_Op_create(&neumaier_mpi_merge, 0, &o);   // 0 — некоммутативная
+        return o;
+    }();
+    return op;
+}
@@ -0,0 +1,351 @@
+// bench.hpp
+// Общий микро-бенчмарк вместо ручных high_resolution_clock в каждой программе.
+//  - прогрев (warmup) перед замерами;
+//  - адаптивное число повторов: пока не набрали min_time_s и min_reps;
+//  - очень короткие ядра (меньше target_sample_s) крутятся пачками по inner раз,
+//    чтобы один замер был заметно больше разрешения таймера;
+//  - статистика: mean, stddev, min, median, p90, p99 и 95% доверительный
+//    интервал медианы (по порядковым статистикам);
+//  - перебор числа потоков (с привязкой потоков к ядрам на Linux);
+//  - вывод таблицы, CSV и JSON для отслеживания регрессий;
+//  - при PERF_COUNTERS=1 вокруг замеров снимаются аппаратные счётчики
+//    (common/perf_counters.hpp): IPC, промахи LLC/TLB/ветвлений на вызов.
+#pragma once
+
+#include <algorithm> // sort, min, max
+#include <chrono>    // steady_clock
+#include <cmath>     // sqrt, floor, ceil
+#include <cstdio>    // snprintf
+#include <cstdlib>   // getenv
+#include <fstream>   // CSV / JSON
+#include <iomanip>   // setw
+#include <iostream>  // таблица
+#include <string>
+#include <vector>
+
+#include "perf_counters.hpp" // аппаратные счётчики (по умолчанию выключены)
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>   // sched_setaffinity
+#endif
+
+// Параметры одного замера
+struct BenchConfig {
+    int warmup = 1;                 // прогревочные запуски (не учитываются)
+    int min_reps = 5;               // минимум замеров
+    int max_reps = 1000;            // максимум замеров
+    double min_time_s = 0.2;        // мерить, пока суммарно не набежит столько секунд
+    double target_sample_s = 1e-4;  // короче — группируем вызовы по inner штук
+};
+
+// Результат замера (времена — на ОДИН вызов функции, в миллисекундах)
+struct BenchResult {
+    std::string name;               // что мерили
+    std::string variant;            // seq / par / ...
+    long long size = 0;             // размер задачи
+    int threads = 1;                // число потоков OpenMP
+    int reps = 0;                   // сколько замеров
+    long long inner = 1;            // вызовов в одном замере
+    double mean_ms = 0, stddev_ms = 0, min_ms = 0;
+    double median_ms = 0, p90_ms = 0, p99_ms = 0;
+    double ci_lo_ms = 0, ci_hi_ms = 0; // 95% ДИ медианы
+    PerfRegion perf;                // счётчики по потокам за все замеры (пусто, если выключено)
+
+    // Оценка трафика памяти по промахам LLC (строка 64 байта), ГБ/с; -1 — нет данных
+    double llc_gbs() const {
+        PerfValues pc = perf.per_call();
+        if (!pc.valid(PERF_LLC_MISS) || median_ms <= 0) return -1.0;
+        return pc.v[PERF_LLC_MISS] * 64.0 / (median_ms * 1e-3) / 1e9;
+    }
+};
+
+inline double bench_now_s() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline int bench_max_threads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Перцентиль по отсортированной выборке (линейная интерполяция)
+inline double bench_percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    double pos = q * (double)(sorted.size() - 1);
+    size_t i = (size_t)pos;
+    double frac = pos - (double)i;
+    if (i + 1 >= sorted.size()) return sorted.back();
+    return sorted[i] * (1.0 - frac) + sorted[i + 1] * frac;
+}
+
+// Заполняем статистику по выборке времён (мс на вызов)
+inline void bench_summarize(BenchResult& r, std::vector<double> ms) {
+    std::sort(ms.begin(), ms.end());
+    size_t n = ms.size();
+    r.reps = (int)n;
+    if (n == 0) return;
+    double sum = 0.0;
+    for (double x : ms) sum += x;
+    r.mean_ms = sum / (double)n;
+    double sq = 0.0;
+    for (double x : ms) sq += (x - r.mean_ms) * (x - r.mean_ms);
+    r.stddev_ms = n > 1 ? std::sqrt(sq / (double)(n - 1)) : 0.0;
+    r.min_ms = ms.front();
+    r.median_ms = bench_percentile(ms, 0.50);
+    r.p90_ms = bench_percentile(ms, 0.90);
+    r.p99_ms = bench_percentile(ms, 0.99);
+    // ДИ медианы: ранги n/2 -+ 1.96*sqrt(n)/2 (нормальное приближение биномиального)
+    double half = 0.98 * std::sqrt((double)n);
+    long long lo = (long long)std::floor((double)n / 2.0 - half);
+    long long hi = (long long)std::ceil((double)n / 2.0 + half);
+    lo = std::max(0LL, lo);
+    hi = std::min((long long)n - 1, hi);
+    r.ci_lo_ms = ms[(size_t)lo];
+    r.ci_hi_ms = ms[(size_t)hi];
+}
+
+// Замер fn(); setup() вызывается перед КАЖДЫМ вызовом fn и не входит во время
+// (например, копирование несортированного массива). При наличии setup
+// вызовы не группируются (inner = 1).
+template <typename Fn, typename Setup>
+inline BenchResult bench_measure(const std::string& name, const std::string& variant,
+                                 long long size, Fn&& fn, Setup&& setup,
+                                 const BenchConfig& cfg, bool has_setup = true) {
+    BenchResult r;
+    r.name = name;
+    r.variant = variant;
+    r.size = size;
+    r.threads = bench_max_threads();
+    r.perf.name = name + "/" + variant;
+
+    // прогрев; заодно оцениваем длительность одного вызова
+    double one = 0.0;
+    std::vector<double> ms;
+    for (int w = 0; w < cfg.warmup; ++w) {
+        setup();
+        double t0 = bench_now_s();
+        fn();
+        one = bench_now_s() - t0;
+    }
+    if (cfg.warmup == 0) {
+        // без прогрева первый вызов сразу идёт в выборку (долгие сортировки)
+        setup();
+        double t0 = bench_now_s();
+        fn();
+        one = bench_now_s() - t0;
+        ms.push_back(one * 1e3);
+    }
+
+    long long inner = 1;
+    if (!has_setup && one < cfg.target_sample_s)
+        inner = std::max(1LL, (long long)(cfg.target_sample_s / std::max(one, 1e-9)));
+    r.inner = inner;
+    double spent = (cfg.warmup == 0) ? one : 0.0;
+    while ((int)ms.size() < cfg.max_reps &&
+           ((int)ms.size() < cfg.min_reps || spent < cfg.min_time_s)) {
+        setup();
+        double dt;
+        {
+            PerfScope ps(r.perf, inner);            // снимки счётчиков вне интервала времени
+            double t0 = bench_now_s();
+            for (long long k = 0; k < inner; ++k) fn();
+            dt = bench_now_s() - t0;
+        }
+        spent += dt;
+        ms.push_back(dt * 1e3 / (double)inner);
+    }
+    bench_summarize(r, ms);
+    return r;
+}
+
+// Вариант без setup: короткие вызовы группируются
+template <typename Fn>
+inline BenchResult bench_measure(const std::string& name, const std::string& variant,
+                                 long long size, Fn&& fn, const BenchConfig& cfg = BenchConfig()) {
+    return bench_measure(name, variant, size, fn, [] {}, cfg, false);
+}
+
+// ==================== ПОТОКИ ====================
+
+// Список ядер, доступных процессу (снимок при первом вызове)
+inline const std::vector<int>& bench_cpus() {
+    static const std::vector<int> cpus = [] {
+        std::vector<int> v;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            for (int c = 0; c < CPU_SETSIZE; ++c)
+                if (CPU_ISSET(c, &set)) v.push_back(c);
+#endif
+        return v;
+    }();
+    return cpus;
+}
+
+// Устанавливаем число потоков и (на Linux) привязываем поток t к ядру t.
+// Отключить привязку: BENCH_PIN=0
+inline void bench_set_threads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+    const char* env = std::getenv("BENCH_PIN");
+    bool pin = !(env && env[0] == '0');
+#ifdef __linux__
+    const std::vector<int>& cpus = bench_cpus();
+    if (pin && !cpus.empty()) {
+        #pragma omp parallel
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpus[(size_t)omp_get_thread_num() % cpus.size()], &set);
+            sched_setaffinity(0, sizeof(set), &set);
+        }
+    }
+#else
+    (void)pin;
+#endif
+#else
+    (void)threads;
+#endif
+}
+
+// 1, 2, 4, ... до max_threads (и сам max_threads, если он не степень двойки)
+inline std::vector<int> bench_thread_counts(int max_threads = 0) {
+    if (max_threads <= 0) max_threads = bench_max_threads();
+    std::vector<int> v;
+    for (int t = 1; t <= max_threads; t *= 2) v.push_back(t);
+    if (v.back() != max_threads) v.push_back(max_threads);
+    return v;
+}
+
+// ==================== НАБОР РЕЗУЛЬТАТОВ ====================
+
+class BenchSuite {
+public:
+    std::vector<BenchResult> results;
+
+    const BenchResult& add(const BenchResult& r) {
+        results.push_back(r);
+        return results.back();
+    }
+
+    // Медиана seq-варианта с тем же name/size (для ускорения)
+    double baseline_ms(const BenchResult& r, const std::string& base_variant = "seq") const {
+        for (const auto& b : results)
+            if (b.name == r.name && b.size == r.size && b.variant == base_variant)
+                return b.median_ms;
+        return 0.0;
+    }
+
+    void print_table(std::ostream& os = std::cout) const {
+        os << std::left << std::setw(14) << "name" << std::setw(8) << "variant"
+           << std::right << std::setw(12) << "size" << std::setw(5) << "thr"
+           << std::setw(7) << "reps" << std::setw(12) << "median_ms"
+           << std::setw(24) << "95% CI" << std::setw(12) << "p90_ms"
+           << std::setw(12) << "p99_ms" << std::setw(9) << "speedup";
+        if (has_perf()) os << std::setw(7) << "IPC" << std::setw(14) << "llc_miss" << std::setw(9) << "llc_GB/s";
+        os << "\n";
+        for (const auto& r : results) {
+            char ci[64];
+            std::snprintf(ci, sizeof(ci), "[%.4f; %.4f]", r.ci_lo_ms, r.ci_hi_ms);
+            double base = baseline_ms(r);
+            os << std::left << std::setw(14) << r.name << std::setw(8) << r.variant
+               << std::right << std::setw(12) << r.size << std::setw(5) << r.threads
+               << std::setw(7) << r.reps << std::setw(12) << std::fixed << std::setprecision(4)
+               << r.median_ms << std::setw(24) << ci << std::setw(12) << r.p90_ms
+               << std::setw(12) << r.p99_ms << std::setw(9) << std::setprecision(2)
+               << (base > 0 && r.median_ms > 0 ? base / r.median_ms : 0.0);
+            if (has_perf()) {
+                PerfValues pc = r.perf.per_call();
+                os << std::setw(7) << pc.ipc() << std::setw(14) << std::setprecision(0)
+                   << pc.v[PERF_LLC_MISS] << std::setw(9) << std::setprecision(2) << r.llc_gbs();
+            }
+            os << "\n";
+            os.unsetf(std::ios::floatfield);
+        }
+    }
+
+    // Есть ли в наборе замеры со счётчиками
+    bool has_perf() const {
+        for (const auto& r : results)
+            if (!r.perf.empty()) return true;
+        return false;
+    }
+
+    // Счётчики на вызов по каждому замеру (построчно, с разбивкой по потокам)
+    void print_perf(std::ostream& os = std::cout) const {
+        for (const auto& r : results) {
+            if (r.perf.empty()) continue;
+            os << "size=" << r.size << " threads=" << r.threads << " ";
+            perf_print(r.perf, os);
+        }
+    }
+
+    bool write_csv(const std::string& path) const {
+        std::ofstream f(path);
+        if (!f) return false;
+        f << "name,variant,size,threads,reps,inner,mean_ms,stddev_ms,min_ms,"
+             "median_ms,p90_ms,p99_ms,ci95_lo_ms,ci95_hi_ms,speedup";
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e) f << "," << perf_event_name(e);
+        f << ",ipc,llc_gbs\n";
+        f << std::setprecision(9);
+        for (const auto& r : results) {
+            double base = baseline_ms(r);
+            f << r.name << "," << r.variant << "," << r.size << "," << r.threads << ","
+              << r.reps << "," << r.inner << "," << r.mean_ms << "," << r.stddev_ms << ","
+              << r.min_ms << "," << r.median_ms << "," << r.p90_ms << "," << r.p99_ms << ","
+              << r.ci_lo_ms << "," << r.ci_hi_ms << ","
+              << (base > 0 && r.median_ms > 0 ? base / r.median_ms : 0.0);
+            PerfValues pc = r.perf.per_call();       // на вызов, сумма по потокам; -1 если нет
+            for (int e = 0; e < PERF_NUM_EVENTS; ++e) f << "," << pc.v[e];
+            f << "," << pc.ipc() << "," << r.llc_gbs() << "\n";
+        }
+        return true;
+    }
+
+    bool write_json(const std::string& path) const {
+        std::ofstream f(path);
+        if (!f) return false;
+        f << std::setprecision(9) << "[\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            f << "  {\"name\": \"" << r.name << "\", \"variant\": \"" << r.variant
+              << "\", \"size\": " << r.size << ", \"threads\": " << r.threads
+              << ", \"reps\": " << r.reps << ", \"inner\": " << r.inner
+              << ", \"mean_ms\": " << r.mean_ms << ", \"stddev_ms\": " << r.stddev_ms
+              << ", \"min_ms\": " << r.min_ms << ", \"median_ms\": " << r.median_ms
+              << ", \"p90_ms\": " << r.p90_ms << ", \"p99_ms\": " << r.p99_ms
+              << ", \"ci95_ms\": [" << r.ci_lo_ms << ", " << r.ci_hi_ms << "]";
+            if (!r.perf.empty()) {
+                // счётчики на вызов: сумма и по потокам
+                auto obj = [&](const PerfValues& v) {
+                    f << "{";
+                    for (int e = 0; e < PERF_NUM_EVENTS; ++e)
+                        f << "\"" << perf_event_name(e) << "\": " << v.v[e] << ", ";
+                    f << "\"ipc\": " << v.ipc() << "}";
+                };
+                double k = 1.0 / (double)r.perf.calls;
+                f << ", \"perf\": {\"calls\": " << r.perf.calls << ", \"llc_gbs\": " << r.llc_gbs()
+                  << ", \"total\": ";
+                obj(r.perf.per_call());
+                f << ", \"threads\": [";
+                for (size_t t = 0; t < r.perf.threads.size(); ++t) {
+                    if (t) f << ", ";
+                    obj(r.perf.threads[t].scaled(k));
+                }
+                f << "]}";
+            }
+            f << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        f << "]\n";
+        return true;
+    }
+};
@@ -0,0 +1,333 @@
+// cl_runtime.hpp
+// Переиспользуемый слой OpenCL: полная подготовка (платформы, контекст, очередь,
+// компиляция kernel.cl, буферы) делается один раз, а не на каждый запуск.
+//  - cl_runtime(type) — устройство, контекст и очередь (с профилированием) создаются
+//    при первом вызове и живут до cl_runtime_release_all(); повторный вызов — без
+//    перебора платформ. Если устройства нужного типа нет, запоминается и это;
+//  - cl_source(rt, path) — текст ядра читается с диска один раз;
+//  - cl_program_get(rt, src, options) — программа ищется в памяти, затем в дисковом
+//    кэше бинарников (CL_CACHE_DIR, по умолчанию .clcache), и только потом
+//    компилируется из исходника; бинарник сохраняется в кэш. Ключ кэша — хеш
+//    имени устройства, версии драйвера, опций сборки и текста исходника: после
+//    обновления драйвера или правки kernel.cl программа собирается заново;
+//  - cl_kernel_get(rt, src, options, name) — объекты kernel тоже живут в кэше;
+//  - cl_buffer_acquire / cl_buffer_release — пул буферов: освобождённый буфер
+//    достаётся следующему запросу с теми же флагами и подходящим размером.
+// rt.last_program_from — откуда взялась последняя программа (memory / disk / source),
+// для отчёта о холодном и тёплом старте.
+// Один поток хоста: аргументы кэшированных kernel общие.
+#pragma once
+
+#ifndef CL_TARGET_OPENCL_VERSION
+#define CL_TARGET_OPENCL_VERSION 120
+#endif
+#include <CL/cl.h>
+
+#include <chrono>      // время подготовки
+#include <cstdio>      // rename, snprintf
+#include <cstdlib>     // exit, getenv
+#include <filesystem>  // create_directories
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <unistd.h>    // getpid
+
+// Проверка ошибок OpenCL: если err != CL_SUCCESS, печатаем и выходим
+inline void cl_check(cl_int err, const char* msg) {
+    if (err != CL_SUCCESS) {
+        std::cerr << "OpenCL error: " << msg << " (code " << err << ")\n";
+        std::exit(1);
+    }
+}
+
+// Чтение текстового файла целиком (исходник ядра)
+inline std::string cl_load_text(const std::string& path) {
+    std::ifstream f(path);
+    if (!f) {
+        std::cerr << "Cannot open file: " << path << "\n";
+        std::exit(1);
+    }
+    return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+}
+
+// Имя платформы OpenCL (например, "NVIDIA CUDA" или "Portable Computing Language")
+inline std::string cl_platform_name(cl_platform_id p) {
+    size_t sz = 0;
+    clGetPlatformInfo(p, CL_PLATFORM_NAME, 0, nullptr, &sz);
+    std::string s(sz, '\0');
+    clGetPlatformInfo(p, CL_PLATFORM_NAME, sz, s.data(), nullptr);
+    while (!s.empty() && (s.back()=='\0' || s.back()=='\n' || s.back()=='\r')) s.pop_back();
+    return s;
+}
+
+// Строковое свойство устройства (CL_DEVICE_NAME, CL_DRIVER_VERSION, ...)
+inline std::string cl_device_string(cl_device_id d, cl_device_info param) {
+    size_t sz = 0;
+    clGetDeviceInfo(d, param, 0, nullptr, &sz);
+    std::string s(sz, '\0');
+    clGetDeviceInfo(d, param, sz, s.data(), nullptr);
+    while (!s.empty() && (s.back()=='\0' || s.back()=='\n' || s.back()=='\r')) s.pop_back();
+    return s;
+}
+
+// Выбор устройства: для GPU сначала NVIDIA (в Colab — Tesla T4), иначе первое устройство нужного типа
+inline bool cl_pick_device(cl_device_type typeWanted, cl_platform_id& outPlatform, cl_device_id& outDevice) {
+    cl_uint numPlatforms = 0;
+    if (clGetPlatformIDs(0, nullptr, &numPlatforms) != CL_SUCCESS || numPlatforms == 0) return false;
+
+    std::vector<cl_platform_id> platforms(numPlatforms);
+    cl_check(clGetPlatformIDs(numPlatforms, platforms.data(), nullptr), "clGetPlatformIDs");
+
+    for (int pass = (typeWanted == CL_DEVICE_TYPE_GPU ? 0 : 1); pass < 2; ++pass) {
+        for (auto p : platforms) {
+            if (pass == 0 && cl_platform_name(p).find("NVIDIA") == std::string::npos) continue;
+            cl_uint numDev = 0;
+            cl_int err = clGetDeviceIDs(p, typeWanted, 0, nullptr, &numDev);
+            if (err != CL_SUCCESS || numDev == 0) continue;
+
+            std::vector<cl_device_id> devs(numDev);
+            cl_check(clGetDeviceIDs(p, typeWanted, numDev, devs.data(), nullptr), "clGetDeviceIDs");
+            outPlatform = p;
+            outDevice = devs[0];
+            return true;
+        }
+    }
+    return false;
+}
+
+// FNV-1a 64 — ключ дискового кэша
+inline unsigned long long cl_hash(const std::string& s, unsigned long long h = 1469598103934665603ull) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+struct ClRuntime {
+    cl_device_type type = CL_DEVICE_TYPE_CPU;
+    cl_platform_id platform = nullptr;
+    cl_device_id device = nullptr;
+    cl_context context = nullptr;
+    cl_command_queue queue = nullptr;
+    std::string device_key;                      // "<устройство> | <драйвер>"
+
+    std::map<std::string, std::string> sources;  // путь -> текст
+    std::map<std::string, cl_program> programs;  // опции + хеш исходника -> программа
+    std::map<std::string, cl_kernel> kernels;    // ключ программы + имя -> kernel
+
+    struct PooledBuffer {
+        cl_mem mem;
+        cl_mem_flags flags;
+        size_t bytes;
+        bool busy;
+    };
+    std::vector<PooledBuffer> buffers;
+
+    const char* last_program_from = "";          // memory / disk / source
+    double init_ms = 0.0;                        // платформа + контекст + очередь (один раз)
+};
+
+inline std::map<cl_device_type, ClRuntime*>& cl_runtimes() {
+    static std::map<cl_device_type, ClRuntime*> rts;
+    return rts;
+}
+
+inline double cl_now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Среда для типа устройства; nullptr — устройства нет (результат тоже запоминается)
+inline ClRuntime* cl_runtime(cl_device_type type) {
+    auto& rts = cl_runtimes();
+    auto it = rts.find(type);
+    if (it != rts.end()) return it->second;
+
+    double t0 = cl_now_ms();
+    ClRuntime* rt = new ClRuntime();
+    rt->type = type;
+    if (!cl_pick_device(type, rt->platform, rt->device)) {
+        delete rt;
+        rts[type] = nullptr;
+        return nullptr;
+    }
+    rt->device_key = cl_device_string(rt->device, CL_DEVICE_NAME) + " | " +
+                     cl_device_string(rt->device, CL_DRIVER_VERSION);
+
+    cl_int err = CL_SUCCESS;
+    rt->context = clCreateContext(nullptr, 1, &rt->device, nullptr, nullptr, &err);
+    cl_check(err, "clCreateContext");
+    rt->queue = clCreateCommandQueue(rt->context, rt->device, CL_QUEUE_PROFILING_ENABLE, &err);
+    cl_check(err, "clCreateCommandQueue");
+    rt->init_ms = cl_now_ms() - t0;
+    rts[type] = rt;
+    return rt;
+}
+
+inline const std::string& cl_source(ClRuntime& rt, const std::string& path) {
+    auto it = rt.sources.find(path);
+    if (it == rt.sources.end()) it = rt.sources.emplace(path, cl_load_text(path)).first;
+    return it->second;
+}
+
+// Каталог дискового кэша бинарников
+inline std::string cl_cache_dir() {
+    const char* env = std::getenv("CL_CACHE_DIR");
+    return (env && *env) ? env : ".clcache";
+}
+
+// Бинарник собранной программы (одно устройство) -> файл; запись через временный файл + rename,
+// чтобы параллельный запуск не прочитал половину
+inline void cl_cache_store(cl_program program, const std::string& path) {
+    size_t size = 0;
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &size, nullptr) != CL_SUCCESS || size == 0)
+        return;
+    std::vector<unsigned char> bin(size);
+    unsigned char* ptr = bin.data();
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(ptr), &ptr, nullptr) != CL_SUCCESS) return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(cl_cache_dir(), ec);
+    std::string tmp = path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream f(tmp, std::ios::binary);
+        if (!f) return;
+        f.write((const char*)bin.data(), (std::streamsize)bin.size());
+    }
+    std::rename(tmp.c_str(), path.c_str());
+}
+
+// Программа из кэша бинарника; nullptr — файла нет или бинарник не подошёл
+inline cl_program cl_cache_load(ClRuntime& rt, const std::string& path, const std::string& options) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return nullptr;
+    std::vector<unsigned char> bin((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (bin.empty()) return nullptr;
+
+    const unsigned char* ptr = bin.data();
+    size_t size = bin.size();
+    cl_int status = CL_SUCCESS, err = CL_SUCCESS;
+    cl_program program = clCreateProgramWithBinary(rt.context, 1, &rt.device, &size, &ptr, &status, &err);
+    if (err != CL_SUCCESS || status != CL_SUCCESS) {
+        if (program) clReleaseProgram(program);
+        return nullptr;
+    }
+    // бинарник тоже "собирается" (на GPU — PTX -> машинный код), но без фронтенда компилятора
+    if (clBuildProgram(program, 1, &rt.device, options.c_str(), nullptr, nullptr) != CL_SUCCESS) {
+        clReleaseProgram(program);
+        return nullptr;
+    }
+    return program;
+}
+
+// Ключ программы (и имя файла в кэше): устройство + драйвер, опции, текст исходника
+inline std::string cl_program_key(const ClRuntime& rt, const std::string& src, const std::string& options) {
+    unsigned long long h = cl_hash(src, cl_hash(options + '\n', cl_hash(rt.device_key + '\n')));
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", h);
+    return name;
+}
+
+// Программа: память -> диск -> компиляция из исходника.
+// quiet: при ошибке компиляции вернуть nullptr без лога (перебор конфигураций),
+// иначе — лог и выход
+inline cl_program cl_program_get(ClRuntime& rt, const std::string& src, const std::string& options,
+                                 bool quiet = false) {
+    std::string name = cl_program_key(rt, src, options);
+    auto it = rt.programs.find(name);
+    if (it != rt.programs.end()) {
+        rt.last_program_from = "memory";
+        return it->second;
+    }
+
+    std::string path = cl_cache_dir() + "/" + name + ".bin";
+    cl_program program = cl_cache_load(rt, path, options);
+    if (program) {
+        rt.last_program_from = "disk";
+    } else {
+        cl_int err = CL_SUCCESS;
+        const char* srcPtr = src.c_str();
+        size_t srcLen = src.size();
+        program = clCreateProgramWithSource(rt.context, 1, &srcPtr, &srcLen, &err);
+        cl_check(err, "clCreateProgramWithSource");
+
+        err = clBuildProgram(program, 1, &rt.device, options.c_str(), nullptr, nullptr);
+        if (err != CL_SUCCESS) {
+            if (quiet) {
+                clReleaseProgram(program);
+                return nullptr;
+            }
+            size_t logSize = 0;
+            clGetProgramBuildInfo(program, rt.device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &logSize);
+            std::string log(logSize, '\0');
+            clGetProgramBuildInfo(program, rt.device, CL_PROGRAM_BUILD_LOG, logSize, log.data(), nullptr);
+            std::cerr << "Build log:\n" << log << "\n";
+            cl_check(err, "clBuildProgram");
+        }
+        cl_cache_store(program, path);
+        rt.last_program_from = "source";
+    }
+    rt.programs[name] = program;
+    return program;
+}
+
+inline cl_kernel cl_kernel_get(ClRuntime& rt, const std::string& src, const std::string& options,
+                               const char* kernelName, bool quiet = false) {
+    std::string key = cl_program_key(rt, src, options) + "/" + kernelName;
+    auto it = rt.kernels.find(key);
+    if (it != rt.kernels.end()) {
+        rt.last_program_from = "memory";
+        return it->second;
+    }
+    cl_program program = cl_program_get(rt, src, options, quiet);
+    if (!program) return nullptr;
+
+    cl_int err = CL_SUCCESS;
+    cl_kernel kernel = clCreateKernel(program, kernelName, &err);
+    if (err != CL_SUCCESS) {
+        if (quiet) return nullptr;
+        cl_check(err, "clCreateKernel");
+    }
+    rt.kernels[key] = kernel;
+    return kernel;
+}
+
+// Буфер из пула: свободный с теми же флагами и размером от bytes до 2 * bytes, иначе новый
+inline cl_mem cl_buffer_acquire(ClRuntime& rt, cl_mem_flags flags, size_t bytes) {
+    ClRuntime::PooledBuffer* best = nullptr;
+    for (auto& b : rt.buffers)
+        if (!b.busy && b.flags == flags && b.bytes >= bytes && b.bytes <= 2 * bytes &&
+            (!best || b.bytes < best->bytes))
+            best = &b;
+    if (best) {
+        best->busy = true;
+        return best->mem;
+    }
+    cl_int err = CL_SUCCESS;
+    cl_mem mem = clCreateBuffer(rt.context, flags, bytes, nullptr, &err);
+    cl_check(err, "clCreateBuffer");
+    rt.buffers.push_back({mem, flags, bytes, true});
+    return mem;
+}
+
+inline void cl_buffer_release(ClRuntime& rt, cl_mem mem) {
+    for (auto& b : rt.buffers)
+        if (b.mem == mem) b.busy = false;
+}
+
+// Освобождение всех сред (в конце main, пока драйвер OpenCL ещё жив)
+inline void cl_runtime_release_all() {
+    for (auto& kv : cl_runtimes()) {
+        ClRuntime* rt = kv.second;
+        if (!rt) continue;
+        for (auto& b : rt->buffers) clReleaseMemObject(b.mem);
+        for (auto& k : rt->kernels) clReleaseKernel(k.second);
+        for (auto& p : rt->programs) clReleaseProgram(p.second);
+        clReleaseCommandQueue(rt->queue);
+        clReleaseContext(rt->context);
+        delete rt;
+    }
+    cl_runtimes().clear();
+}
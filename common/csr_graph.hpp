@@ -0,0 +1,219 @@
+// csr_graph.hpp
+// Разреженный ориентированный граф в формате CSR (compressed sparse row):
+//   row[u] .. row[u + 1] — рёбра вершины u, col[k] — куда, w[k] — вес (int > 0).
+// Память O(N + M) вместо N x N int у плотной матрицы floyd_tiled.hpp: граф
+// с 10^6 вершин и степенью 8 — ~100 МБ, плотная матрица — 4 ТБ.
+//  - csr_from_edges_par(n, edges, m) — построение из списка рёбер на всех потоках:
+//    рёбра по корзинам вершин -> степени -> префиксная сумма (par_scan.hpp) -> раскладка
+//    по строкам -> сортировка каждой строки по (col, w). Результат не зависит
+//    от числа потоков и порядка рёбер во входе;
+//  - csr_gen_floyd(N) — тот же граф, что floyd_gen (задание 3: 30% рёбер, веса 1..20):
+//    строки генерируются дважды (подсчёт, потом запись), без плотной матрицы целиком;
+//  - graph_gen_edges(N, m, seed) — случайный разреженный граф: m рёбер (u, v, w),
+//    u, v — равномерно, w — 1..20 (Philox по номеру ребра: одинаково при любом разбиении);
+//  - csr_to_dense(g, D) — плотная матрица расстояний для проверки Флойдом (только малые N).
+#pragma once
+
+#include <algorithm>  // sort, min
+#include <cstddef>    // size_t
+#include <utility>    // pair
+#include <vector>
+
+#include "floyd_tiled.hpp"  // FLOYD_INF, floyd_gen
+#include "par_scan.hpp"     // scan_inclusive_inplace_par
+#include "philox.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+const int GRAPH_WMAX = 20;   // веса 1..GRAPH_WMAX, как в floyd_gen
+
+struct GraphEdge {
+    int u, v, w;
+};
+
+struct CsrGraph {
+    int n = 0;
+    std::vector<long long> row;   // n + 1 смещений
+    std::vector<int> col, w;      // M рёбер
+
+    long long edges() const { return row.empty() ? 0 : row[(size_t)n]; }
+    long long degree(int u) const { return row[(size_t)u + 1] - row[(size_t)u]; }
+    size_t bytes() const { return row.size() * sizeof(long long) + (col.size() + w.size()) * sizeof(int); }
+};
+
+// Сортировка рёбер каждой строки по (col, w): одинаковый порядок для любого порядка
+// рёбер во входе, и соседи идут по возрастанию — лучше для кэша при обходе
+inline void csr_sort_rows_par(CsrGraph& g) {
+    #pragma omp parallel
+    {
+        std::vector<std::pair<int, int>> tmp;
+        #pragma omp for schedule(dynamic, 1024)
+        for (int u = 0; u < g.n; ++u) {
+            long long b = g.row[(size_t)u], e = g.row[(size_t)u + 1];
+            if (e - b < 2) continue;
+            tmp.resize((size_t)(e - b));
+            for (long long k = b; k < e; ++k) tmp[(size_t)(k - b)] = {g.col[(size_t)k], g.w[(size_t)k]};
+            std::sort(tmp.begin(), tmp.end());
+            for (long long k = b; k < e; ++k) {
+                g.col[(size_t)k] = tmp[(size_t)(k - b)].first;
+                g.w[(size_t)k] = tmp[(size_t)(k - b)].second;
+            }
+        }
+    }
+}
+
+// Рёбра делятся на корзины по старшим битам u (~CSR_BUCKETS вершин подряд на корзину)
+const int CSR_BUCKETS = 4096;
+
+// CSR из списка рёбер (u, v в [0; n)); петли и повторные рёбра сохраняются как есть.
+// Прямая раскладка по строкам (атомарный pos[u]++ и запись в случайное место col / w)
+// на каждом ребре промахивается мимо кэша и TLB. Поэтому два прохода, как у radix_sort.hpp:
+//  1) гистограммы корзин по потокам (куски как schedule(static)) -> смещения -> рёбра
+//     в буфер по корзинам: у каждого потока ~CSR_BUCKETS последовательных потоков записи;
+//  2) корзины параллельно: степени вершин корзины; 3) после скана — раскладка по строкам:
+//     строки одной корзины лежат подряд и помещаются в кэш. Атомарных операций нет.
+inline CsrGraph csr_from_edges_par(int n, const GraphEdge* e, long long m) {
+    CsrGraph g;
+    g.n = n;
+    g.row.assign((size_t)n + 1, 0);
+    g.col.resize((size_t)m);
+    g.w.resize((size_t)m);
+
+    int shift = 0;
+    while (((long long)(n - 1) >> shift) >= CSR_BUCKETS) ++shift;
+    int nb = n > 0 ? ((n - 1) >> shift) + 1 : 1;
+    int nt = 1;
+#ifdef _OPENMP
+    nt = omp_get_max_threads();
+#endif
+    std::vector<long long> cnt((size_t)nt * nb, 0);        // cnt[t * nb + b], потом — смещения
+    std::vector<long long> bstart((size_t)nb + 1, 0);      // начало корзины b в буфере
+    std::vector<GraphEdge> tmp((size_t)m);
+
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        long long lo, hi;
+        scan_chunk(m, t, nt, lo, hi);
+        long long* c = cnt.data() + (size_t)t * nb;
+        // 1) гистограмма корзин своего куска, смещения, раскладка рёбер в tmp по корзинам
+        for (long long k = lo; k < hi; ++k) c[e[k].u >> shift]++;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            long long off = 0;                                // порядок: корзина, затем поток
+            for (int b = 0; b < nb; ++b) {
+                bstart[(size_t)b] = off;
+                for (int q = 0; q < nt; ++q) {
+                    long long x = cnt[(size_t)q * nb + b];
+                    cnt[(size_t)q * nb + b] = off;
+                    off += x;
+                }
+            }
+            bstart[(size_t)nb] = off;
+        }
+        for (long long k = lo; k < hi; ++k) tmp[(size_t)c[e[k].u >> shift]++] = e[k];
+        #pragma omp barrier
+
+        // 2) корзины: степени вершин (вершины корзины — только у одного потока)
+        #pragma omp for schedule(dynamic, 16)
+        for (int b = 0; b < nb; ++b)
+            for (long long k = bstart[(size_t)b]; k < bstart[(size_t)b + 1]; ++k) g.row[(size_t)tmp[(size_t)k].u + 1]++;
+    }
+    scan_inclusive_inplace_par(g.row.data() + 1, (long long)n);
+
+    // 3) корзины: раскладка по строкам, pos — следующие свободные места строк корзины
+    #pragma omp parallel num_threads(nt)
+    {
+        std::vector<long long> pos;
+        #pragma omp for schedule(dynamic, 16)
+        for (int b = 0; b < nb; ++b) {
+            int v0 = b << shift, v1 = std::min(n, (b + 1) << shift);
+            pos.assign(g.row.begin() + v0, g.row.begin() + v1);
+            for (long long k = bstart[(size_t)b]; k < bstart[(size_t)b + 1]; ++k) {
+                const GraphEdge& x = tmp[(size_t)k];
+                long long at = pos[(size_t)(x.u - v0)]++;
+                g.col[(size_t)at] = x.v;
+                g.w[(size_t)at] = x.w;
+            }
+        }
+    }
+
+    // порядок рёбер в строке уже не зависит от потоков (раскладка устойчивая);
+    // сортировка по (col, w) — соседи по возрастанию, лучше для кэша при обходе
+    csr_sort_rows_par(g);
+    return g;
+}
+
+// Граф задания 3 (floyd_gen) сразу в CSR: D[i][j] < FLOYD_INF и i != j — ребро i -> j
+inline CsrGraph csr_gen_floyd(int N) {
+    CsrGraph g;
+    g.n = N;
+    g.row.assign((size_t)N + 1, 0);
+    #pragma omp parallel
+    {
+        std::vector<int> buf((size_t)N);
+        #pragma omp for schedule(static)
+        for (int i = 0; i < N; ++i) {
+            floyd_gen(buf.data(), N, i, 0, N);
+            long long c = 0;
+            for (int j = 0; j < N; ++j) c += (j != i && buf[(size_t)j] < FLOYD_INF);
+            g.row[(size_t)i + 1] = c;
+        }
+    }
+    scan_inclusive_inplace_par(g.row.data() + 1, (long long)N);
+    g.col.resize((size_t)g.edges());
+    g.w.resize((size_t)g.edges());
+    #pragma omp parallel
+    {
+        std::vector<int> buf((size_t)N);
+        #pragma omp for schedule(static)
+        for (int i = 0; i < N; ++i) {
+            floyd_gen(buf.data(), N, i, 0, N);
+            long long k = g.row[(size_t)i];
+            for (int j = 0; j < N; ++j)
+                if (j != i && buf[(size_t)j] < FLOYD_INF) {
+                    g.col[(size_t)k] = j;
+                    g.w[(size_t)k++] = buf[(size_t)j];
+                }
+        }
+    }
+    return g;
+}
+
+// m случайных рёбер: ребро k — (u, v, w) из трёх потоков Philox с одним смещением k
+inline std::vector<GraphEdge> graph_gen_edges(int N, long long m, unsigned long long seed = FLOYD_SEED) {
+    std::vector<GraphEdge> e((size_t)m);
+    const int CH = 256;
+    #pragma omp parallel
+    {
+        int u[CH], v[CH], w[CH];
+        #pragma omp for schedule(static)
+        for (long long c0 = 0; c0 < m; c0 += CH) {
+            int c = (int)std::min<long long>(CH, m - c0);
+            philox_int(u, c, seed, 0, N - 1, c0);
+            philox_int(v, c, seed + 1, 0, N - 1, c0);
+            philox_int(w, c, seed + 2, 1, GRAPH_WMAX, c0);
+            for (int t = 0; t < c; ++t) e[(size_t)(c0 + t)] = {u[t], v[t], w[t]};
+        }
+    }
+    return e;
+}
+
+// Плотная матрица N x N: FLOYD_INF — нет ребра, 0 на диагонали, из повторных рёбер — минимум
+inline void csr_to_dense(const CsrGraph& g, int* D) {
+    int N = g.n;
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; ++i) {
+        int* d = D + (size_t)i * N;
+        std::fill(d, d + N, FLOYD_INF);
+        for (long long k = g.row[(size_t)i]; k < g.row[(size_t)i + 1]; ++k)
+            d[g.col[(size_t)k]] = std::min(d[g.col[(size_t)k]], g.w[(size_t)k]);
+        d[i] = 0;
+    }
+}
@@ -0,0 +1,124 @@
+// floyd_tiled.hpp
+// Блочный (tiled) Флойд–Уоршелл: матрица расстояний int делится на плитки
+// FLOYD_BLOCK x FLOYD_BLOCK, раунд K (для блока промежуточных вершин K):
+//   1) ведущая плитка (K, K) — обычный Флойд внутри плитки;
+//   2) плитки строки K и столбца K — через ведущую плитку;
+//   3) остальные плитки (I, J): D_IJ = min(D_IJ, D_IK (x) D_KJ) — min-plus
+//      "умножение" независимых плиток (основная работа, O(N^3)).
+// Ядра без ветвлений: min(c, a + b) векторизуется (vpminsd / vpaddd), отсутствие
+// ребра — FLOYD_INF = 1e9: INF + INF = 2e9 ещё помещается в int, поэтому сумма
+// не переполняется и проверка "a >= INF" не нужна. Плитка 64 x 64 int = 16 КБ —
+// три плитки (C, A, B) остаются в L1/L2.
+//  - minplus_tile / fw_tile_dep — ядра над плитками с произвольной ведущей
+//    размерностью (подходят и для полной матрицы, и для локальной части в MPI);
+//  - floyd_blocked_par(D, N) — версия для одного узла (OpenMP по плиткам);
+//  - floyd_naive(D, N) — исходный построчный алгоритм (для сравнения);
+//  - floyd_gen — граф задания 3 (30% рёбер с весом 1..20) по глобальным индексам
+//    через Philox: одинаковый при любом разбиении между процессами и потоками.
+#pragma once
+
+#include <algorithm>  // min
+#include <cstddef>    // size_t
+
+#include "philox.hpp"
+#include "tile_kernel.hpp"  // микроядро C (op)= A x B
+
+const int FLOYD_INF = 1000000000;   // нет ребра (как в задании)
+const int FLOYD_BLOCK = 64;         // сторона плитки
+const unsigned long long FLOYD_SEED = 123;
+
+// ==================== ЯДРА ====================
+
+// C = min(C, A (x) B) для плитки m x n с внутренней размерностью kk.
+// C не должна пересекаться с A и B. Микроядро FLOYD_MR x FLOYD_NR — общее с GEMM
+// (tile_kernel.hpp), операция — min-plus
+const int FLOYD_MR = 4;
+const int FLOYD_NR = 32;
+
+inline void minplus_tile(int* C, int ldc, const int* A, int lda, const int* B, int ldb,
+                         int m, int n, int kk) {
+    tile_kernel<FLOYD_MR, FLOYD_NR, TileMinPlus>(C, ldc, A, lda, B, ldb, m, n, kk);
+}
+
+// То же, но A или B могут совпадать с C (ведущая плитка, строка и столбец K):
+// k — внешний цикл, как в обычном Флойде. Элементы, которые читаются на шаге k
+// (C[i][k] и C[k][j]), на этом шаге не меняются, т.к. диагональ = 0
+inline void fw_tile_dep(int* C, int ldc, const int* A, int lda, const int* B, int ldb,
+                        int m, int n, int kk) {
+    for (int k = 0; k < kk; ++k) {
+        const int* b = B + (size_t)k * ldb;
+        for (int i = 0; i < m; ++i) {
+            int* c = C + (size_t)i * ldc;
+            int aik = A[(size_t)i * lda + k];
+            #pragma omp simd
+            for (int j = 0; j < n; ++j) {
+                int v = aik + b[j];             // не std::min: ссылка на временное мешает векторизации
+                c[j] = c[j] < v ? c[j] : v;
+            }
+        }
+    }
+}
+
+// ==================== ОДИН УЗЕЛ ====================
+
+// Исходный алгоритм: по k, строка за строкой, с проверками на INF
+inline void floyd_naive(int* D, int N) {
+    for (int k = 0; k < N; ++k) {
+        const int* dk = D + (size_t)k * N;
+        for (int i = 0; i < N; ++i) {
+            int dik = D[(size_t)i * N + k];
+            if (dik >= FLOYD_INF) continue;
+            int* di = D + (size_t)i * N;
+            for (int j = 0; j < N; ++j) {
+                if (dk[j] >= FLOYD_INF) continue;
+                int nd = dik + dk[j];
+                if (nd < di[j]) di[j] = nd;
+            }
+        }
+    }
+}
+
+// Блочный Флойд на всех потоках OpenMP: фазы 2 и 3 — параллельно по плиткам
+inline void floyd_blocked_par(int* D, int N, int bs = FLOYD_BLOCK) {
+    int nt = (N + bs - 1) / bs;
+    auto tile = [&](int I, int J) { return D + (size_t)I * bs * N + (size_t)J * bs; };
+    auto dim = [&](int I) { return std::min(bs, N - I * bs); };
+    for (int K = 0; K < nt; ++K) {
+        int dk = dim(K);
+        int* kk = tile(K, K);
+        fw_tile_dep(kk, N, kk, N, kk, N, dk, dk, dk);
+
+        // строка K (t < nt) и столбец K (t >= nt)
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int t = 0; t < 2 * nt; ++t) {
+            int J = t % nt;
+            if (J == K) continue;
+            if (t < nt) fw_tile_dep(tile(K, J), N, kk, N, tile(K, J), N, dk, dim(J), dk);
+            else        fw_tile_dep(tile(J, K), N, tile(J, K), N, kk, N, dim(J), dk, dk);
+        }
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int I = 0; I < nt; ++I)
+            for (int J = 0; J < nt; ++J) {
+                if (I == K || J == K) continue;
+                minplus_tile(tile(I, J), N, tile(I, K), N, tile(K, J), N, dim(I), dim(J), dk);
+            }
+    }
+}
+
+// ==================== ГРАФ ====================
+
+// out[t] = D[gi][gc0 + t], t < n: ребро с вероятностью 0.30, вес 1..20, иначе INF; D[i][i] = 0
+inline void floyd_gen(int* out, int N, int gi, int gc0, int n) {
+    const int CH = 256;
+    double pr[CH];
+    int w[CH];
+    for (int c0 = 0; c0 < n; c0 += CH) {
+        int c = std::min(CH, n - c0);
+        long long off = (long long)gi * N + gc0 + c0;
+        philox_uniform(pr, c, FLOYD_SEED, 0.0, 1.0, off);
+        philox_int(w, c, FLOYD_SEED + 1, 1, 20, off);
+        for (int t = 0; t < c; ++t)
+            out[c0 + t] = (gi == gc0 + c0 + t) ? 0 : (pr[t] < 0.30 ? w[t] : FLOYD_INF);
+    }
+}
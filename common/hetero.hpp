@@ -0,0 +1,207 @@
+// hetero.hpp
+// Совместная обработка массива CPU (потоки OpenMP) и ускорителем (асинхронная очередь,
+// например OpenCL) вместо фиксированного деления пополам, как в p8/task3_hybrid.cu и
+// a4/task3_hybrid_cpu_gpu.cu. Что делать с диапазоном [b, e), задаёт вызывающий:
+//  - HeteroCpuFn cpu(b, e) — обработать диапазон в текущем потоке (делит по потокам executor);
+//  - HeteroDevice dev: submit(b, e) ставит копирование + ядро + копирование назад в очередь
+//    и сразу возвращается, finish() ждёт всё поставленное и возвращает время устройства (мс).
+// Режимы HeteroExecutor::run(n, mode):
+//  - CpuOnly / DevOnly — всё на одном исполнителе (база и пропускная способность по одиночке);
+//  - Fixed    — постоянная доля устройства (fixed_ratio = 0.5 — как в заданиях);
+//  - Adaptive — после каждого вызова оценки скорости (элементов в мс) обоих исполнителей
+//               обновляются скользящим средним, следующая доля устройства = Rd / (Rc + Rd):
+//               при такой доле оба заканчивают одновременно. У каждого остаётся не меньше
+//               min_share, иначе нечем мерить, если условия изменятся;
+//  - Dynamic  — без заранее заданной доли: общий счётчик, потоки CPU берут куски по
+//               cpu_chunk, поток 0 ведёт устройство и берёт куски до dev_chunk (к концу
+//               массива меньше — по оценке скорости, чтобы устройство не держало хвост).
+//               Поток 0 занят устройством, поэтому потоков не меньше двух.
+// Идеал для отчёта: n / (Rc_solo + Rd_solo) — если бы скорости просто складывались.
+#pragma once
+
+#include <algorithm>   // min, max
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using HeteroCpuFn = std::function<void(long long, long long)>;
+
+struct HeteroDevice {
+    std::function<void(long long, long long)> submit;  // поставить [b, e) в очередь, не ждать
+    std::function<double()> finish;                    // дождаться всего; время устройства, мс
+};
+
+enum class HeteroMode { CpuOnly, DevOnly, Fixed, Adaptive, Dynamic };
+
+inline const char* hetero_mode_name(HeteroMode m) {
+    switch (m) {
+        case HeteroMode::CpuOnly:  return "cpu";
+        case HeteroMode::DevOnly:  return "device";
+        case HeteroMode::Fixed:    return "fixed";
+        case HeteroMode::Adaptive: return "adaptive";
+        default:                   return "dynamic";
+    }
+}
+
+struct HeteroConfig {
+    double fixed_ratio = 0.5;        // доля устройства в Fixed (и стартовая в Adaptive)
+    double alpha = 0.5;              // вес нового замера в скользящей оценке скорости
+    double min_share = 0.02;         // минимальная доля каждого исполнителя в Adaptive
+    long long cpu_chunk = 1 << 16;   // Dynamic: кусок потока CPU
+    long long dev_chunk = 1 << 21;   // Dynamic: наибольший кусок устройства
+};
+
+// Итог одного вызова run
+struct HeteroStep {
+    double ratio = 0;                // фактическая доля устройства
+    long long n_cpu = 0, n_dev = 0;
+    double cpu_ms = 0;               // время части CPU (стена)
+    double dev_ms = 0;               // время устройства (по finish)
+    double total_ms = 0;             // весь вызов
+    int dev_chunks = 0;              // сколько кусков взяло устройство
+};
+
+class HeteroExecutor {
+public:
+    HeteroExecutor(HeteroCpuFn cpu, HeteroDevice dev, HeteroConfig cfg = HeteroConfig())
+        : cpu_(std::move(cpu)), dev_(std::move(dev)), cfg_(cfg), ratio_(cfg.fixed_ratio) {}
+
+    double ratio() const { return ratio_; }      // текущая доля устройства (Adaptive)
+    double cpu_rate() const { return rc_; }      // оценка скорости CPU, элементов / мс
+    double dev_rate() const { return rd_; }      // оценка скорости устройства, элементов / мс
+
+    HeteroStep run(long long n, HeteroMode mode) {
+        if (mode == HeteroMode::Dynamic) return run_dynamic(n);
+        double r = mode == HeteroMode::CpuOnly ? 0.0
+                 : mode == HeteroMode::DevOnly ? 1.0
+                 : mode == HeteroMode::Fixed   ? cfg_.fixed_ratio
+                 : ratio_;
+        HeteroStep s = run_split(n, r);
+        if (mode == HeteroMode::Adaptive) {
+            observe(s);
+            if (rc_ > 0 && rd_ > 0) ratio_ = rd_ / (rc_ + rd_);
+            ratio_ = std::min(1.0 - cfg_.min_share, std::max(cfg_.min_share, ratio_));
+        }
+        return s;
+    }
+
+private:
+    static double now_ms() {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Скользящие оценки скорости по итогам вызова
+    void observe(const HeteroStep& s) {
+        if (s.n_cpu > 0 && s.cpu_ms > 0) {
+            double r = (double)s.n_cpu / s.cpu_ms;
+            rc_ = rc_ > 0 ? (1 - cfg_.alpha) * rc_ + cfg_.alpha * r : r;
+        }
+        if (s.n_dev > 0 && s.dev_ms > 0) {
+            double r = (double)s.n_dev / s.dev_ms;
+            rd_ = rd_ > 0 ? (1 - cfg_.alpha) * rd_ + cfg_.alpha * r : r;
+        }
+    }
+
+    // CPU — [0, n_cpu), устройство — [n_cpu, n): сначала ставим работу устройству,
+    // пока оно считает, потоки CPU обрабатывают свою часть
+    HeteroStep run_split(long long n, double r) {
+        HeteroStep s;
+        s.n_dev = (long long)((double)n * r + 0.5);
+        s.n_cpu = n - s.n_dev;
+        s.ratio = n > 0 ? (double)s.n_dev / (double)n : 0.0;
+        double t0 = now_ms();
+        if (s.n_dev > 0) {
+            dev_.submit(s.n_cpu, n);
+            s.dev_chunks = 1;
+        }
+        if (s.n_cpu > 0) {
+            long long nc = s.n_cpu;
+            #pragma omp parallel
+            {
+#ifdef _OPENMP
+                int t = omp_get_thread_num(), used = omp_get_num_threads();
+#else
+                int t = 0, used = 1;
+#endif
+                cpu_(nc * t / used, nc * (t + 1) / used);
+            }
+        }
+        s.cpu_ms = now_ms() - t0;
+        if (s.n_dev > 0) s.dev_ms = dev_.finish();
+        s.total_ms = now_ms() - t0;
+        return s;
+    }
+
+    // Общий счётчик: поток 0 — устройство, остальные — CPU
+    HeteroStep run_dynamic(long long n) {
+        HeteroStep s;
+        std::atomic<long long> next{0};
+        long long nDev = 0;
+        int devChunks = 0;
+        double devMs = 0;
+#ifdef _OPENMP
+        int nt = std::max(2, omp_get_max_threads());
+#endif
+        double t0 = now_ms();
+        #pragma omp parallel num_threads(nt)
+        {
+#ifdef _OPENMP
+            int t = omp_get_thread_num(), used = omp_get_num_threads();
+#else
+            int t = 0, used = 1;
+#endif
+            if (t == 0) {
+                for (;;) {
+                    long long rem = n - next.load(std::memory_order_relaxed);
+                    if (rem <= 0) break;
+                    // к концу массива — доля остатка по оценке скорости, но не меньше куска CPU
+                    double share = (rc_ > 0 && rd_ > 0) ? rd_ / (rc_ + rd_) : cfg_.fixed_ratio;
+                    if (used == 1) share = 1.0;     // OpenMP без потоков: всё на устройство
+                    long long len = std::min(cfg_.dev_chunk,
+                                             std::max(cfg_.cpu_chunk, (long long)((double)rem * share)));
+                    long long b = next.fetch_add(len, std::memory_order_relaxed);
+                    if (b >= n) break;
+                    long long e = std::min(n, b + len);
+                    dev_.submit(b, e);
+                    double ms = dev_.finish();
+                    devMs += ms;
+                    nDev += e - b;
+                    ++devChunks;
+                    if (ms > 0) {
+                        double r = (double)(e - b) / ms;
+                        rd_ = rd_ > 0 ? (1 - cfg_.alpha) * rd_ + cfg_.alpha * r : r;
+                    }
+                }
+            } else {
+                for (;;) {
+                    long long b = next.fetch_add(cfg_.cpu_chunk, std::memory_order_relaxed);
+                    if (b >= n) break;
+                    cpu_(b, std::min(n, b + cfg_.cpu_chunk));
+                }
+            }
+        }
+        s.total_ms = now_ms() - t0;
+        s.n_dev = nDev;
+        s.n_cpu = n - nDev;
+        s.ratio = n > 0 ? (double)nDev / (double)n : 0.0;
+        s.dev_ms = devMs;
+        s.cpu_ms = s.total_ms;            // потоки CPU работают до конца вызова
+        s.dev_chunks = devChunks;
+        if (s.n_cpu > 0 && s.cpu_ms > 0) {
+            double r = (double)s.n_cpu / s.cpu_ms;
+            rc_ = rc_ > 0 ? (1 - cfg_.alpha) * rc_ + cfg_.alpha * r : r;
+        }
+        return s;
+    }
+
+    HeteroCpuFn cpu_;
+    HeteroDevice dev_;
+    HeteroConfig cfg_;
+    double ratio_;
+    double rc_ = 0, rd_ = 0;
+};
@@ -0,0 +1,286 @@
+// iter_solve.hpp
+// Итерационные методы для плотных систем задания 2 (p9/task2_gauss): Якоби и
+// сопряжённые градиенты (CG). На матрицах с диагональным преобладанием они сходятся
+// за десятки проходов O(N^2) вместо O(N^3) исключения Гаусса.
+//  - система [A | b] генерируется по глобальным индексам (linsys_gen) — тот же Philox
+//    и тот же seed, что в task2_gauss: одинаковая система при любом разбиении;
+//    LinsysKind::SymDominant — симметричный вариант (a_ij = a_ji) с тем же преобладанием:
+//    симметричная матрица со строгим диагональным преобладанием и a_ii > 0 положительно
+//    определена — её решают и CG, и Якоби (CG на несимметричной матрице не сходится);
+//  - строки делятся кусками [r0; r1) (linsys_rows): у процесса / узла свои строки A и b;
+//  - произведение матрицы на вектор — OpenMP по строкам, по 4 строки за проход
+//    (x читается один раз на 4 строки), SIMD-редукция внутри строки;
+//  - алгоритм написан один раз, обмены — через Comm: sum(v, n) — сумма по всем
+//    (скалярные произведения), gather(xl, x) — полный вектор из кусков. Здесь —
+//    IterCommLocal (один узел), в iter_solve_mpi.hpp — MPI_Allreduce / MPI_Allgatherv;
+//  - останов по невязке: ||b - A x||_2 / ||b||_2 <= tol; на каждой итерации — время
+//    (всего, произведение на вектор, обмены) и невязка в IterResult::history.
+#pragma once
+
+#include <algorithm>  // min
+#include <chrono>     // steady_clock
+#include <cmath>      // sqrt
+#include <cstdint>
+#include <vector>
+
+#include "philox.hpp"
+
+const unsigned long long LINSYS_SEED = 123;   // как SEED в task2_gauss
+
+enum class LinsysKind { Random, DiagDominant, SymDominant };
+
+inline const char* linsys_name(LinsysKind k) {
+    switch (k) {
+        case LinsysKind::DiagDominant: return "diag-dominant";
+        case LinsysKind::SymDominant: return "sym-diag-dominant";
+        default: return "random";
+    }
+}
+
+// Элемент idx потока Philox в [-1; 1) — то же, что philox_uniform(&v, 1, LINSYS_SEED, -1, 1, idx),
+// но один блок вместо пачки (для элементов не подряд)
+inline double linsys_u(long long idx) {
+    uint32_t w[4];
+    philox4x32((uint64_t)(idx / 2), LINSYS_SEED, w);
+    int k = (int)(idx % 2);
+    uint64_t u = ((uint64_t)w[2 * k] << 32 | w[2 * k + 1]) >> 11;
+    return -1.0 + (double)u * (2.0 * 0x1.0p-53);
+}
+
+// Элементы (gi, gc0 .. gc0 + n - 1) расширенной матрицы [A | b] (столбец N — b):
+// элемент (i, j) = Philox[i * (N + 1) + j] в [-1; 1); с преобладанием a_ii += N
+// (|a_ij| < 1, поэтому строгое); SymDominant: a_ij = a_ji = элемент (min, max)
+inline void linsys_gen(int gi, int N, int gc0, int n, LinsysKind kind, double* out) {
+    philox_uniform(out, n, LINSYS_SEED, -1.0, 1.0, (long long)gi * (N + 1) + gc0);
+    if (kind == LinsysKind::SymDominant)
+        for (int j = gc0; j < std::min(gi, gc0 + n); ++j) out[j - gc0] = linsys_u((long long)j * (N + 1) + gi);
+    if (kind != LinsysKind::Random && gi >= gc0 && gi < gc0 + n) out[gi - gc0] += N;
+}
+
+// Строки процесса rank из p: [N * rank / p; N * (rank + 1) / p)
+inline void linsys_rows(int N, int p, int rank, int& r0, int& r1) {
+    r0 = (int)((long long)N * rank / p);
+    r1 = (int)((long long)N * (rank + 1) / p);
+}
+
+// Строки [r0; r1) системы: A по строкам (ведущая размерность N), b и диагональ
+struct LinsysLocal {
+    int N = 0, r0 = 0, r1 = 0;
+    std::vector<double> A, b, diag;
+
+    int rows() const { return r1 - r0; }
+    const double* row(int li) const { return A.data() + (size_t)li * N; }
+};
+
+inline LinsysLocal linsys_local(int N, int r0, int r1, LinsysKind kind) {
+    LinsysLocal s;
+    s.N = N;
+    s.r0 = r0;
+    s.r1 = r1;
+    s.A.resize((size_t)s.rows() * N);
+    s.b.resize((size_t)s.rows());
+    s.diag.resize((size_t)s.rows());
+    #pragma omp parallel for schedule(static)
+    for (int li = 0; li < s.rows(); ++li) {
+        int gi = r0 + li;
+        double* a = s.A.data() + (size_t)li * N;
+        linsys_gen(gi, N, 0, N, kind, a);
+        linsys_gen(gi, N, N, 1, kind, &s.b[(size_t)li]);
+        s.diag[(size_t)li] = a[gi];
+    }
+    return s;
+}
+
+// ==================== ЯДРО: y = A x ====================
+
+// y[li] = A[li] . x для локальных строк; x — полный вектор длины N
+inline void linsys_matvec_par(const LinsysLocal& s, const double* x, double* y) {
+    int m = s.rows(), N = s.N;
+    #pragma omp parallel for schedule(static)
+    for (int i0 = 0; i0 < m; i0 += 4) {
+        if (i0 + 4 <= m) {
+            const double *a0 = s.row(i0), *a1 = s.row(i0 + 1), *a2 = s.row(i0 + 2), *a3 = s.row(i0 + 3);
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            #pragma omp simd reduction(+:s0, s1, s2, s3)
+            for (int j = 0; j < N; ++j) {
+                double xj = x[j];
+                s0 += a0[j] * xj;
+                s1 += a1[j] * xj;
+                s2 += a2[j] * xj;
+                s3 += a3[j] * xj;
+            }
+            y[i0] = s0; y[i0 + 1] = s1; y[i0 + 2] = s2; y[i0 + 3] = s3;
+        } else {
+            for (int i = i0; i < m; ++i) {
+                const double* a = s.row(i);
+                double acc = 0.0;
+                #pragma omp simd reduction(+:acc)
+                for (int j = 0; j < N; ++j) acc += a[j] * x[j];
+                y[i] = acc;
+            }
+        }
+    }
+}
+
+// ==================== МЕТОДЫ ====================
+
+struct IterConfig {
+    double tol = 1e-13;     // ||b - A x|| / ||b||; при 1e-10 ||Ax-b|| / (||A|| ||x|| N eps) ~ 100,
+                            // на 2 итерации больше — ~0.1, как у Гаусса (порог проверки там 16)
+    int max_iter = 1000;
+};
+
+struct IterStep {
+    int iter = 0;
+    double resid = 0.0;      // относительная невязка после итерации
+    double t_total = 0.0;    // с
+    double t_matvec = 0.0;
+    double t_comm = 0.0;     // sum + gather
+};
+
+struct IterResult {
+    int iters = 0;
+    double resid = 0.0;
+    bool converged = false;
+    double time = 0.0;       // с, весь решатель
+    std::vector<IterStep> history;
+};
+
+// Один узел: строки [0; N), обменов нет
+struct IterCommLocal {
+    int n = 0;   // строк (= N)
+    void sum(double*, int) {}
+    void gather(const double* xl, double* x) { if (xl != x) std::copy(xl, xl + n, x); }
+};
+
+inline double iter_now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Якоби: x <- x + D^-1 (b - A x). x — полный вектор (начальное приближение и ответ)
+template <typename Comm>
+inline IterResult jacobi_solve(const LinsysLocal& s, std::vector<double>& x, const IterConfig& cfg, Comm& comm) {
+    int m = s.rows();
+    IterResult res;
+    std::vector<double> xl(x.begin() + s.r0, x.begin() + s.r1), r((size_t)m);
+    double T0 = iter_now();
+    double bn = 0.0;
+    for (double v : s.b) bn += v * v;
+    comm.sum(&bn, 1);
+    bn = std::sqrt(bn);
+
+    for (int it = 1; it <= cfg.max_iter; ++it) {
+        IterStep st;
+        st.iter = it;
+        double t0 = iter_now();
+        comm.gather(xl.data(), x.data());
+        double t1 = iter_now();
+        linsys_matvec_par(s, x.data(), r.data());
+        double t2 = iter_now();
+        double rr = 0.0;
+        #pragma omp parallel for simd schedule(static) reduction(+:rr)
+        for (int i = 0; i < m; ++i) {
+            double ri = s.b[(size_t)i] - r[(size_t)i];
+            r[(size_t)i] = ri;
+            rr += ri * ri;
+        }
+        double t3 = iter_now();
+        comm.sum(&rr, 1);
+        double t4 = iter_now();
+        st.resid = std::sqrt(rr) / bn;
+        bool done = st.resid <= cfg.tol;
+        if (!done) {
+            #pragma omp parallel for simd schedule(static)
+            for (int i = 0; i < m; ++i) xl[(size_t)i] += r[(size_t)i] / s.diag[(size_t)i];
+        }
+        st.t_matvec = t2 - t1;
+        st.t_comm = (t1 - t0) + (t4 - t3);
+        st.t_total = iter_now() - t0;
+        res.history.push_back(st);
+        res.iters = it;
+        res.resid = st.resid;
+        if (done) { res.converged = true; break; }
+    }
+    comm.gather(xl.data(), x.data());
+    res.time = iter_now() - T0;
+    return res;
+}
+
+// Сопряжённые градиенты (A симметричная положительно определённая)
+template <typename Comm>
+inline IterResult cg_solve(const LinsysLocal& s, std::vector<double>& x, const IterConfig& cfg, Comm& comm) {
+    int m = s.rows();
+    IterResult res;
+    std::vector<double> xl(x.begin() + s.r0, x.begin() + s.r1), r((size_t)m), pl((size_t)m), q((size_t)m);
+    std::vector<double> pfull((size_t)s.N);
+    double T0 = iter_now();
+
+    // r = b - A x0, p = r
+    comm.gather(xl.data(), x.data());
+    linsys_matvec_par(s, x.data(), q.data());
+    double sums[2] = {0.0, 0.0};                           // ||b||^2, ||r||^2
+    for (int i = 0; i < m; ++i) {
+        r[(size_t)i] = s.b[(size_t)i] - q[(size_t)i];
+        pl[(size_t)i] = r[(size_t)i];
+        sums[0] += s.b[(size_t)i] * s.b[(size_t)i];
+        sums[1] += r[(size_t)i] * r[(size_t)i];
+    }
+    comm.sum(sums, 2);
+    double bn = std::sqrt(sums[0]), rs = sums[1];
+    res.resid = std::sqrt(rs) / bn;
+    res.converged = res.resid <= cfg.tol;
+
+    for (int it = 1; it <= cfg.max_iter && !res.converged; ++it) {
+        IterStep st;
+        st.iter = it;
+        double t0 = iter_now();
+        comm.gather(pl.data(), pfull.data());
+        double t1 = iter_now();
+        linsys_matvec_par(s, pfull.data(), q.data());
+        double t2 = iter_now();
+        double pq = 0.0;
+        #pragma omp parallel for simd schedule(static) reduction(+:pq)
+        for (int i = 0; i < m; ++i) pq += pl[(size_t)i] * q[(size_t)i];
+        double t3 = iter_now();
+        comm.sum(&pq, 1);
+        double t4 = iter_now();
+        double alpha = rs / pq, rsNew = 0.0;
+        #pragma omp parallel for simd schedule(static) reduction(+:rsNew)
+        for (int i = 0; i < m; ++i) {
+            xl[(size_t)i] += alpha * pl[(size_t)i];
+            r[(size_t)i] -= alpha * q[(size_t)i];
+            rsNew += r[(size_t)i] * r[(size_t)i];
+        }
+        double t5 = iter_now();
+        comm.sum(&rsNew, 1);
+        double t6 = iter_now();
+        double beta = rsNew / rs;
+        rs = rsNew;
+        #pragma omp parallel for simd schedule(static)
+        for (int i = 0; i < m; ++i) pl[(size_t)i] = r[(size_t)i] + beta * pl[(size_t)i];
+
+        st.resid = std::sqrt(rs) / bn;
+        st.t_matvec = t2 - t1;
+        st.t_comm = (t1 - t0) + (t4 - t3) + (t6 - t5);
+        st.t_total = iter_now() - t0;
+        res.history.push_back(st);
+        res.iters = it;
+        res.resid = st.resid;
+        res.converged = st.resid <= cfg.tol;
+    }
+    comm.gather(xl.data(), x.data());
+    res.time = iter_now() - T0;
+    return res;
+}
+
+// Один узел: вся система, x длины N
+inline IterResult jacobi_par(const LinsysLocal& s, std::vector<double>& x, const IterConfig& cfg = IterConfig()) {
+    IterCommLocal c;
+    c.n = s.rows();
+    return jacobi_solve(s, x, cfg, c);
+}
+inline IterResult cg_par(const LinsysLocal& s, std::vector<double>& x, const IterConfig& cfg = IterConfig()) {
+    IterCommLocal c;
+    c.n = s.rows();
+    return cg_solve(s, x, cfg, c);
+}
@@ -0,0 +1,58 @@
+// iter_solve_mpi.hpp
+// Якоби и CG из iter_solve.hpp на процессах MPI: у процесса строки [r0; r1) (linsys_rows),
+// скалярные произведения и нормы — MPI_Allreduce, полный вектор для произведения
+// на матрицу — MPI_Allgatherv кусков (N чисел на итерацию на процесс вместо строк матрицы).
+// Потоки OpenMP внутри процесса считают свои строки (гибридный запуск, mpi_hybrid.hpp);
+// MPI вызывается только вне parallel-регионов (FUNNELED).
+#pragma once
+
+#include <mpi.h>
+
+#include <vector>
+
+#include "iter_solve.hpp"
+
+struct IterCommMpi {
+    MPI_Comm comm;
+    int rank = 0, p = 1;
+    std::vector<int> counts, displs;   // строки процессов
+
+    IterCommMpi(MPI_Comm c, int N) : comm(c) {
+        MPI_Comm_rank(c, &rank);
+        MPI_Comm_size(c, &p);
+        counts.resize(p);
+        displs.resize(p);
+        for (int q = 0; q < p; ++q) {
+            int r0, r1;
+            linsys_rows(N, p, q, r0, r1);
+            displs[q] = r0;
+            counts[q] = r1 - r0;
+        }
+    }
+    void sum(double* v, int n) { MPI_Allreduce(MPI_IN_PLACE, v, n, MPI_DOUBLE, MPI_SUM, comm); }
+    void gather(const double* xl, double* x) {
+        MPI_Allgatherv(xl, counts[rank], MPI_DOUBLE, x, counts.data(), displs.data(), MPI_DOUBLE, comm);
+    }
+};
+
+// Строки этого процесса
+inline LinsysLocal linsys_local_mpi(int N, LinsysKind kind, MPI_Comm comm) {
+    int rank = 0, p = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    int r0, r1;
+    linsys_rows(N, p, rank, r0, r1);
+    return linsys_local(N, r0, r1, kind);
+}
+
+// x — полный вектор длины N (одинаковый у всех процессов до и после)
+inline IterResult jacobi_mpi(const LinsysLocal& s, std::vector<double>& x, MPI_Comm comm,
+                             const IterConfig& cfg = IterConfig()) {
+    IterCommMpi c(comm, s.N);
+    return jacobi_solve(s, x, cfg, c);
+}
+inline IterResult cg_mpi(const LinsysLocal& s, std::vector<double>& x, MPI_Comm comm,
+                         const IterConfig& cfg = IterConfig()) {
+    IterCommMpi c(comm, s.N);
+    return cg_solve(s, x, cfg, c);
+}
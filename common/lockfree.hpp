@@ -0,0 +1,266 @@
+// lockfree.hpp
+// Неблокирующие очередь и стек для потоков CPU (CPU-аналоги Stack / Queue из p5).
+//  - MpmcQueue<T> — ограниченная кольцевая очередь много производителей / много
+//    потребителей (схема Вьюкова): у каждой ячейки свой номер seq. Ячейка i свободна
+//    для записи позиции pos, когда seq == pos, и готова к чтению, когда seq == pos + 1;
+//    после чтения seq = pos + capacity (следующий круг). Позицию производитель и
+//    потребитель занимают CAS по своему счётчику, значение пишется / читается уже
+//    после захвата, а seq публикует его (release / acquire) — нет ни чтения
+//    "недописанной" ячейки, ни отката счётчика, как в GPU-версии;
+//  - TreiberStack<T> — стек Трайбера на пуле узлов: вершина — 64-битное слово
+//    (индекс узла, тег). Тег растёт при каждом снятии, поэтому CAS не пройдёт,
+//    если узел успели снять и вернуть (ABA). Узлы не освобождаются (пул на
+//    capacity), так что чтение next у чужого узла безопасно и без hazard pointers;
+//  - пакетные *_batch: очередь занимает k соседних ячеек одним CAS, стек снимает
+//    и кладёт цепочку из k узлов одним CAS — на k элементов одна точка конкуренции;
+//  - MutexQueue / MutexStack — то же API под std::mutex (база для сравнения).
+// Все try_* не ждут: false / 0 — очередь пуста (полна), повторять должен вызывающий.
+#pragma once
+
+#include <atomic>
+#include <cstddef>   // size_t
+#include <cstdint>   // uint32_t, uint64_t
+#include <memory>    // unique_ptr
+#include <mutex>
+#include <vector>
+
+const size_t LF_CACHE_LINE = 64;
+
+// ==================== ОЧЕРЕДЬ MPMC ====================
+
+template <typename T>
+class MpmcQueue {
+public:
+    // ёмкость округляется вверх до степени двойки (индекс ячейки — pos & mask)
+    explicit MpmcQueue(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        cells_.reset(new Cell[cap]);
+        for (size_t i = 0; i < cap; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+        enq_.store(0, std::memory_order_relaxed);
+        deq_.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    bool try_push(const T& v) { return try_push_batch(&v, 1) == 1; }
+    bool try_pop(T& v) { return try_pop_batch(&v, 1) == 1; }
+
+    // До n элементов одним захватом; возвращает, сколько положено (0 — очередь полна)
+    size_t try_push_batch(const T* v, size_t n) {
+        size_t pos = enq_.load(std::memory_order_relaxed);
+        for (;;) {
+            // сколько ячеек подряд от pos свободно на этом круге
+            size_t k = 0;
+            while (k < n && cells_[(pos + k) & mask_].seq.load(std::memory_order_acquire) == pos + k) ++k;
+            if (k == 0) {
+                Cell& c = cells_[pos & mask_];
+                long long d = (long long)(c.seq.load(std::memory_order_acquire) - pos);
+                if (d < 0) return 0;                     // ячейку ещё не прочитали — полна
+                pos = enq_.load(std::memory_order_relaxed);  // другой производитель обогнал
+                continue;
+            }
+            // пока enq_ == pos, никто не может занять ячейки pos..pos+k-1: они наши после CAS
+            if (enq_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < k; ++i) {
+                    Cell& c = cells_[(pos + i) & mask_];
+                    c.value = v[i];
+                    c.seq.store(pos + i + 1, std::memory_order_release);
+                }
+                return k;
+            }
+        }
+    }
+
+    // До n элементов одним захватом; возвращает, сколько извлечено (0 — очередь пуста)
+    size_t try_pop_batch(T* out, size_t n) {
+        size_t pos = deq_.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t k = 0;
+            while (k < n && cells_[(pos + k) & mask_].seq.load(std::memory_order_acquire) == pos + k + 1) ++k;
+            if (k == 0) {
+                Cell& c = cells_[pos & mask_];
+                long long d = (long long)(c.seq.load(std::memory_order_acquire) - (pos + 1));
+                if (d < 0) return 0;                     // ещё не записано — пуста
+                pos = deq_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (deq_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < k; ++i) {
+                    Cell& c = cells_[(pos + i) & mask_];
+                    out[i] = c.value;
+                    c.seq.store(pos + i + mask_ + 1, std::memory_order_release);
+                }
+                return k;
+            }
+        }
+    }
+
+private:
+    struct alignas(LF_CACHE_LINE) Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(LF_CACHE_LINE) std::atomic<size_t> enq_;   // счётчики на разных строках кэша:
+    alignas(LF_CACHE_LINE) std::atomic<size_t> deq_;   // производители и потребители не мешают друг другу
+};
+
+// ==================== СТЕК ТРАЙБЕРА ====================
+
+template <typename T>
+class TreiberStack {
+public:
+    explicit TreiberStack(size_t capacity) : cap_((uint32_t)capacity) {
+        nodes_.reset(new Node[cap_]);
+        // все узлы — в списке свободных: 0 -> 1 -> ... -> cap-1
+        for (uint32_t i = 0; i < cap_; ++i)
+            nodes_[i].next.store(i + 1 < cap_ ? i + 1 : NIL, std::memory_order_relaxed);
+        head_.store(pack(NIL, 0), std::memory_order_relaxed);
+        free_.store(pack(cap_ ? 0 : NIL, 0), std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return cap_; }
+
+    bool try_push(const T& v) { return try_push_batch(&v, 1) == 1; }
+    bool try_pop(T& v) { return try_pop_batch(&v, 1) == 1; }
+
+    // Берём до n свободных узлов одним CAS, заполняем и кладём цепочкой одним CAS
+    size_t try_push_batch(const T* v, size_t n) {
+        uint32_t first, last;
+        size_t k = take_chain(free_, n, first, last);
+        uint32_t i = first;
+        for (size_t j = 0; j < k; ++j) {
+            nodes_[i].value = v[k - 1 - j];   // вершина цепочки — последний элемент пакета (LIFO)
+            i = nodes_[i].next.load(std::memory_order_relaxed);
+        }
+        if (k) put_chain(head_, first, last);
+        return k;
+    }
+
+    size_t try_pop_batch(T* out, size_t n) {
+        uint32_t first, last;
+        size_t k = take_chain(head_, n, first, last);
+        uint32_t i = first;
+        for (size_t j = 0; j < k; ++j) {
+            out[j] = nodes_[i].value;
+            i = nodes_[i].next.load(std::memory_order_relaxed);
+        }
+        if (k) put_chain(free_, first, last);
+        return k;
+    }
+
+private:
+    static const uint32_t NIL = 0xFFFFFFFFu;
+    struct Node {
+        T value;
+        std::atomic<uint32_t> next;
+    };
+    static uint64_t pack(uint32_t idx, uint32_t tag) { return ((uint64_t)tag << 32) | idx; }
+    static uint32_t idx_of(uint64_t w) { return (uint32_t)w; }
+    static uint32_t tag_of(uint64_t w) { return (uint32_t)(w >> 32); }
+
+    // Снять с вершины list до n узлов: [first .. last], возвращает сколько.
+    // Цепочка ниже вершины меняется только через вершину, поэтому если вершина
+    // (с тегом) не изменилась к моменту CAS, прочитанные next верны
+    size_t take_chain(std::atomic<uint64_t>& list, size_t n, uint32_t& first, uint32_t& last) {
+        uint64_t h = list.load(std::memory_order_acquire);
+        for (;;) {
+            first = idx_of(h);
+            if (first == NIL || n == 0) return 0;
+            size_t k = 1;
+            last = first;
+            uint32_t nx = nodes_[last].next.load(std::memory_order_relaxed);
+            while (k < n && nx != NIL) {
+                last = nx;
+                nx = nodes_[last].next.load(std::memory_order_relaxed);
+                ++k;
+            }
+            if (list.compare_exchange_weak(h, pack(nx, tag_of(h) + 1),
+                                           std::memory_order_acquire, std::memory_order_acquire))
+                return k;
+        }
+    }
+
+    // Положить цепочку [first .. last] на вершину list
+    void put_chain(std::atomic<uint64_t>& list, uint32_t first, uint32_t last) {
+        uint64_t h = list.load(std::memory_order_relaxed);
+        for (;;) {
+            nodes_[last].next.store(idx_of(h), std::memory_order_relaxed);
+            if (list.compare_exchange_weak(h, pack(first, tag_of(h) + 1),
+                                           std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+    uint32_t cap_;
+    std::unique_ptr<Node[]> nodes_;
+    alignas(LF_CACHE_LINE) std::atomic<uint64_t> head_;   // стек значений
+    alignas(LF_CACHE_LINE) std::atomic<uint64_t> free_;   // свободные узлы пула
+};
+
+// ==================== БАЗА: ПОД МЬЮТЕКСОМ ====================
+
+template <typename T>
+class MutexQueue {
+public:
+    explicit MutexQueue(size_t capacity) : buf_(capacity) {}
+    size_t capacity() const { return buf_.size(); }
+
+    bool try_push(const T& v) { return try_push_batch(&v, 1) == 1; }
+    bool try_pop(T& v) { return try_pop_batch(&v, 1) == 1; }
+
+    size_t try_push_batch(const T* v, size_t n) {
+        std::lock_guard<std::mutex> lk(m_);
+        size_t k = 0;
+        for (; k < n && size_ < buf_.size(); ++k, ++size_) buf_[(head_ + size_) % buf_.size()] = v[k];
+        return k;
+    }
+    size_t try_pop_batch(T* out, size_t n) {
+        std::lock_guard<std::mutex> lk(m_);
+        size_t k = 0;
+        for (; k < n && size_ > 0; ++k, --size_) {
+            out[k] = buf_[head_];
+            head_ = (head_ + 1) % buf_.size();
+        }
+        return k;
+    }
+
+private:
+    std::mutex m_;
+    std::vector<T> buf_;
+    size_t head_ = 0, size_ = 0;
+};
+
+template <typename T>
+class MutexStack {
+public:
+    explicit MutexStack(size_t capacity) : cap_(capacity) { buf_.reserve(capacity); }
+    size_t capacity() const { return cap_; }
+
+    bool try_push(const T& v) { return try_push_batch(&v, 1) == 1; }
+    bool try_pop(T& v) { return try_pop_batch(&v, 1) == 1; }
+
+    size_t try_push_batch(const T* v, size_t n) {
+        std::lock_guard<std::mutex> lk(m_);
+        size_t k = 0;
+        for (; k < n && buf_.size() < cap_; ++k) buf_.push_back(v[k]);
+        return k;
+    }
+    size_t try_pop_batch(T* out, size_t n) {
+        std::lock_guard<std::mutex> lk(m_);
+        size_t k = 0;
+        for (; k < n && !buf_.empty(); ++k) {
+            out[k] = buf_.back();
+            buf_.pop_back();
+        }
+        return k;
+    }
+
+private:
+    std::mutex m_;
+    size_t cap_;
+    std::vector<T> buf_;
+};
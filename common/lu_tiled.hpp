@@ -0,0 +1,219 @@
+// lu_tiled.hpp
+// Плиточное LU-разложение с частичным выбором ведущего элемента на одном узле
+// (OpenMP tasks с depend вместо MPI, как в p9/task2_gauss).
+//  - матрица хранится плитками LU_NB x LU_NB подряд (tile layout): строка плитки
+//    непрерывна, плитка целиком в L2, ведущая размерность ядер = nb. N дополняется
+//    до кратного nb единичной матрицей (решение не меняется, ядра без краёв по плиткам);
+//  - шаг k (блок столбцов k) — три вида задач:
+//      panel(k)      — разложение столбца плиток k (строки >= k*nb): поиск ведущего
+//                      по всему столбцу, перестановка строк внутри панели, исключение;
+//      swap_trsm(k, j) — перестановки шага k в столбце плиток j и U_kj = L_kk^-1 A_kj;
+//      gemm(k, i, j) — A_ij -= L_ik U_kj (основная работа, O(N^3));
+//    зависимости — depend по объекту-метке каждой плитки (для панели и перестановок —
+//    весь столбец плиток через depend(iterator)). Барьеров между шагами нет: панель k+1
+//    стартует, как только обновлён столбец k+1, пока остальные gemm шага k ещё идут
+//    (lookahead); задачи критического пути — с priority (OMP_MAX_TASK_PRIORITY > 0);
+//  - перестановки применяются только к столбцам правее панели (как в LINPACK dgefa):
+//    прямой ход повторяет их по блокам в том же порядке (lu_solve_tiled);
+//  - ядра gemm и trsm — общее микроядро tile_kernel<LU_MR, LU_NR, TileFms> (tile_kernel.hpp;
+//    то же, что у gemm_tile / minplus_tile) с блоком 6 x 32 double (24 zmm) в регистрах:
+//    быстрее 4 x 16 / 4 x 32 / 8 x 16 (AVX-512: ~50-60 против 30-45 GFLOP/s на поток).
+#pragma once
+
+#include <algorithm>  // min, swap_ranges, fill
+#include <cmath>      // fabs
+#include <cstddef>    // size_t
+#include <vector>
+
+#include "tile_kernel.hpp"  // микроядро C (op)= A x B
+
+const int LU_NB = 128;   // сторона плитки по умолчанию (128 x 128 double = 128 КБ; 192 — ядро быстрее, но панель дороже)
+const int LU_MR = 6;
+const int LU_NR = 32;
+
+struct TiledMatrix {
+    int N = 0, nb = LU_NB, nt = 0;     // nt x nt плиток, дополненный размер nt * nb
+    std::vector<double> data;
+
+    TiledMatrix() = default;
+    TiledMatrix(int N_, int nb_) : N(N_), nb(nb_), nt((N_ + nb_ - 1) / nb_), data((size_t)nt * nt * nb * nb, 0.0) {
+        for (int r = N; r < nt * nb; ++r) at(r, r) = 1.0;            // дополнение — единичная матрица
+    }
+    int size() const { return nt * nb; }
+    double* tile(int I, int J) { return data.data() + ((size_t)I * nt + J) * nb * nb; }
+    const double* tile(int I, int J) const { return data.data() + ((size_t)I * nt + J) * nb * nb; }
+    double& at(int r, int c) { return tile(r / nb, c / nb)[(size_t)(r % nb) * nb + c % nb]; }
+};
+
+// ==================== ЯДРА ПЛИТОК ====================
+
+// C -= A * B, все плитки nb x nb (ведущая размерность nb)
+inline void lu_gemm_tile(double* C, const double* A, const double* B, int nb) {
+    tile_kernel<LU_MR, LU_NR, TileFms>(C, nb, A, nb, B, nb, nb, nb, nb);
+}
+
+// B = L^-1 B, L — единичная нижнетреугольная часть плитки Lkk. По блокам из LU_MR строк:
+// вклад уже решённых строк 0..i-1 — тем же микроядром (B_i -= L_i,0:i B_0:i, основная работа),
+// затем треугольник LU_MR x LU_MR внутри блока — построчно (SIMD по столбцам)
+inline void lu_trsm_tile(const double* L, double* B, int nb) {
+    for (int i = 0; i < nb; i += LU_MR) {
+        int mb = std::min(LU_MR, nb - i);
+        double* bi = B + (size_t)i * nb;
+        if (i > 0) tile_kernel<LU_MR, LU_NR, TileFms>(bi, nb, L + (size_t)i * nb, nb, B, nb, mb, nb, i);
+        for (int t = 1; t < mb; ++t) {
+            double* bt = bi + (size_t)t * nb;
+            for (int s = 0; s < t; ++s) {
+                double l = L[(size_t)(i + t) * nb + i + s];
+                const double* bs = bi + (size_t)s * nb;
+                #pragma omp simd
+                for (int j = 0; j < nb; ++j) bt[j] -= l * bs[j];
+            }
+        }
+    }
+}
+
+// Панель: столбец плиток k, строки k*nb .. size-1. ipiv[r] — с какой строкой
+// переставлена строка r. Возвращает false, если ведущий элемент = 0
+inline bool lu_panel(TiledMatrix& M, int k, int* ipiv) {
+    int nb = M.nb, nt = M.nt;
+    bool ok = true;
+    std::vector<double> prow((size_t)nb);
+    for (int c = 0; c < nb; ++c) {
+        int gr = k * nb + c;
+        // ведущий: максимум |a| по строкам >= gr
+        double best = -1.0;
+        int bi = gr;
+        for (int I = k; I < nt; ++I) {
+            const double* T = M.tile(I, k);
+            for (int r = (I == k ? c : 0); r < nb; ++r) {
+                double v = std::fabs(T[(size_t)r * nb + c]);
+                if (v > best) { best = v; bi = I * nb + r; }
+            }
+        }
+        ipiv[gr] = bi;
+        if (bi != gr) {
+            double* a = M.tile(k, k) + (size_t)c * nb;
+            double* b = M.tile(bi / nb, k) + (size_t)(bi % nb) * nb;
+            std::swap_ranges(a, a + nb, b);
+        }
+        const double* pr = M.tile(k, k) + (size_t)c * nb;
+        if (pr[c] == 0.0) { ok = false; continue; }      // вырожденная матрица
+        std::copy(pr, pr + nb, prow.begin());
+        double inv = 1.0 / prow[(size_t)c];
+
+        // исключение ниже ведущего в пределах панели: l = a_rc / a_cc, a_r,c+1.. -= l * prow
+        for (int I = k; I < nt; ++I) {
+            double* T = M.tile(I, k);
+            for (int r = (I == k ? c + 1 : 0); r < nb; ++r) {
+                double* a = T + (size_t)r * nb;
+                double l = a[c] * inv;
+                a[c] = l;
+                #pragma omp simd
+                for (int j = c + 1; j < nb; ++j) a[j] -= l * prow[(size_t)j];
+            }
+        }
+    }
+    return ok;
+}
+
+// Перестановки строк шага k (ipiv[k*nb .. k*nb+nb-1], по порядку) в столбце плиток j
+inline void lu_swap_tile_col(TiledMatrix& M, int k, int j, const int* ipiv) {
+    int nb = M.nb;
+    for (int c = 0; c < nb; ++c) {
+        int r = k * nb + c, p = ipiv[r];
+        if (p == r) continue;
+        double* a = M.tile(k, j) + (size_t)c * nb;
+        double* b = M.tile(p / nb, j) + (size_t)(p % nb) * nb;
+        std::swap_ranges(a, a + nb, b);
+    }
+}
+
+// ==================== РАЗЛОЖЕНИЕ ====================
+
+// P A = L U на месте (L — единичная, ниже диагонали; U — на и выше).
+// ipiv — размера M.size(). Возвращает false, если матрица вырождена
+inline bool lu_tiled_par(TiledMatrix& M, std::vector<int>& ipiv) {
+    int nt = M.nt, nb = M.nb;
+    ipiv.resize((size_t)M.size());
+    std::vector<char> deps((size_t)nt * nt);           // метки плиток для depend
+    std::vector<char> singular((size_t)nt, 0);
+    char* dp = deps.data();
+    (void)dp;                                           // используется только в depend(iterator) — GCC считает неиспользуемой
+    int* pv = ipiv.data();
+    const int HI = 1;                                   // приоритет критического пути
+
+    #pragma omp parallel
+    #pragma omp single
+    for (int k = 0; k < nt; ++k) {
+        #pragma omp task firstprivate(k) depend(iterator(I = k:nt), inout: dp[I * nt + k]) priority(HI)
+        singular[(size_t)k] = !lu_panel(M, k, pv);
+
+        for (int j = k + 1; j < nt; ++j) {
+            int prio = j == k + 1 ? HI : 0;             // столбец следующей панели — раньше
+            #pragma omp task firstprivate(k, j) depend(iterator(I = k:nt), in: dp[I * nt + k]) \
+                depend(iterator(I = k:nt), inout: dp[I * nt + j]) priority(prio)
+            {
+                lu_swap_tile_col(M, k, j, pv);
+                lu_trsm_tile(M.tile(k, k), M.tile(k, j), nb);
+            }
+            for (int i = k + 1; i < nt; ++i) {
+                #pragma omp task firstprivate(k, i, j) depend(in: dp[i * nt + k], dp[k * nt + j]) \
+                    depend(inout: dp[i * nt + j]) priority(prio)
+                lu_gemm_tile(M.tile(i, j), M.tile(i, k), M.tile(k, j), nb);
+            }
+        }
+    }
+    for (char s : singular)
+        if (s) return false;
+    return true;
+}
+
+// ==================== ПРЯМОЙ И ОБРАТНЫЙ ХОД ====================
+
+// A x = b по разложению: b (длины M.size(), дополнение — нули) заменяется на x
+inline void lu_solve_tiled(const TiledMatrix& M, const std::vector<int>& ipiv, std::vector<double>& b) {
+    int nt = M.nt, nb = M.nb;
+    // прямой ход: перестановки блока k, L_kk y_k = b_k, b_I -= L_Ik y_k
+    for (int k = 0; k < nt; ++k) {
+        for (int c = 0; c < nb; ++c) std::swap(b[(size_t)k * nb + c], b[(size_t)ipiv[(size_t)k * nb + c]]);
+        const double* L = M.tile(k, k);
+        double* y = b.data() + (size_t)k * nb;
+        for (int c = 1; c < nb; ++c) {
+            double s = y[c];
+            for (int t = 0; t < c; ++t) s -= L[(size_t)c * nb + t] * y[t];
+            y[c] = s;
+        }
+        #pragma omp parallel for schedule(static)
+        for (int I = k + 1; I < nt; ++I) {
+            const double* T = M.tile(I, k);
+            double* bi = b.data() + (size_t)I * nb;
+            for (int r = 0; r < nb; ++r) {
+                double s = 0.0;
+                #pragma omp simd reduction(+:s)
+                for (int t = 0; t < nb; ++t) s += T[(size_t)r * nb + t] * y[t];
+                bi[r] -= s;
+            }
+        }
+    }
+    // обратный ход: U_kk x_k = b_k, b_I -= U_Ik x_k (I < k)
+    for (int k = nt - 1; k >= 0; --k) {
+        const double* U = M.tile(k, k);
+        double* x = b.data() + (size_t)k * nb;
+        for (int c = nb - 1; c >= 0; --c) {
+            double s = x[c];
+            for (int t = c + 1; t < nb; ++t) s -= U[(size_t)c * nb + t] * x[t];
+            x[c] = s / U[(size_t)c * nb + c];
+        }
+        #pragma omp parallel for schedule(static)
+        for (int I = 0; I < k; ++I) {
+            const double* T = M.tile(I, k);
+            double* bi = b.data() + (size_t)I * nb;
+            for (int r = 0; r < nb; ++r) {
+                double s = 0.0;
+                #pragma omp simd reduction(+:s)
+                for (int t = 0; t < nb; ++t) s += T[(size_t)r * nb + t] * x[t];
+                bi[r] -= s;
+            }
+        }
+    }
+}
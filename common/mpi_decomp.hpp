@@ -0,0 +1,27 @@
+// mpi_decomp.hpp
+// Разбиение массива из N элементов между p процессами (для MPI_Scatterv / Gatherv):
+// куски почти равной длины, первые N % p процессов получают на 1 элемент больше.
+// Без зависимостей, кроме <vector>: нужно и task1 в p9, и сортировке (mpi_sort.hpp).
+#pragma once
+
+#include <vector>
+
+// Функция, которая делает counts/displs (разбиение массива между процессами)
+// counts[r] = сколько элементов получит процесс r
+// displs[r] = с какого индекса массива начнётся блок для процесса r
+inline void build_counts_displs(int N, int p, std::vector<int>& counts, std::vector<int>& displs) {
+    counts.assign(p, 0);
+    displs.assign(p, 0);
+
+    int base = N / p;       // сколько точно получит каждый
+    int rem  = N % p;       // остаток (лишние элементы)
+
+    // Первые rem процессов получают на 1 элемент больше
+    for (int r = 0; r < p; ++r) {
+        counts[r] = base + (r < rem ? 1 : 0);
+    }
+    // displs — префиксная сумма counts
+    for (int r = 1; r < p; ++r) {
+        displs[r] = displs[r - 1] + counts[r - 1];
+    }
+}
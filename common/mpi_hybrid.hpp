@@ -0,0 +1,86 @@
+// mpi_hybrid.hpp
+// Гибридный запуск MPI + OpenMP: один процесс на сокет / узел, внутри — потоки OpenMP.
+//  - hybrid_init(&argc, &argv) вместо MPI_Init: MPI_Init_thread с уровнем
+//    FUNNELED (MPI вызывает только главный поток, вне parallel-регионов) или
+//    SERIALIZED (HYBRID_THREAD=serialized); если библиотека дала меньше — предупреждение;
+//  - если OMP_NUM_THREADS не задан, потоков на процесс = ядра узла / процессы
+//    на узле (узел — MPI_Comm_split_type SHARED), но не больше ядер, к которым
+//    процесс привязан: чистый MPI (-np = ядрам) получает по 1 потоку, без переподписки;
+//  - HybridInfo — ranks, threads, ranks_per_node, cores = ranks * threads и
+//    метка конфигурации "pure" / "hybrid" для отчётов.
+// Пример запуска на узле с 2 сокетами по 16 ядер:
+//   mpirun -np 32 --bind-to core ./prog                       # чистый MPI
+//   mpirun -np 2 --map-by socket --bind-to socket ./prog      # гибрид: 2 x 16 потоков
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>  // max, min
+#include <cstdlib>    // getenv
+#include <cstring>    // strcmp
+#include <iostream>
+#include <thread>     // hardware_concurrency
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+struct HybridInfo {
+    int provided = MPI_THREAD_SINGLE;  // уровень потоков, который дала библиотека
+    int ranks = 1;
+    int ranks_per_node = 1;
+    int threads = 1;                   // потоков OpenMP на процесс
+    int cores() const { return ranks * threads; }
+    const char* config() const { return threads > 1 ? "hybrid" : "pure"; }
+};
+
+inline const char* hybrid_level_name(int level) {
+    switch (level) {
+        case MPI_THREAD_SINGLE: return "single";
+        case MPI_THREAD_FUNNELED: return "funneled";
+        case MPI_THREAD_SERIALIZED: return "serialized";
+        default: return "multiple";
+    }
+}
+
+inline HybridInfo& hybrid_info() {
+    static HybridInfo info;
+    return info;
+}
+
+inline HybridInfo hybrid_init(int* argc, char*** argv) {
+    const char* env = std::getenv("HYBRID_THREAD");
+    int required = (env && std::strcmp(env, "serialized") == 0) ? MPI_THREAD_SERIALIZED : MPI_THREAD_FUNNELED;
+
+    HybridInfo& h = hybrid_info();
+    MPI_Init_thread(argc, argv, required, &h.provided);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &h.ranks);
+
+    // процессы на этом узле
+    MPI_Comm node;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+    MPI_Comm_size(node, &h.ranks_per_node);
+    MPI_Comm_free(&node);
+
+#ifdef _OPENMP
+    if (!std::getenv("OMP_NUM_THREADS")) {
+        int hw = std::max(1, (int)std::thread::hardware_concurrency());
+        int share = std::max(1, hw / h.ranks_per_node);
+        omp_set_num_threads(std::min(share, omp_get_num_procs()));   // num_procs учитывает привязку
+    }
+    h.threads = omp_get_max_threads();
+#endif
+
+    if (h.provided < required && rank == 0)
+        std::cerr << "mpi_hybrid: requested MPI_THREAD_" << hybrid_level_name(required)
+                  << ", library provides " << hybrid_level_name(h.provided) << "\n";
+    return h;
+}
+
+// Строка для вывода: "ranks=4 threads=8 cores=32 (hybrid, funneled)"
+inline void hybrid_print(std::ostream& os, const HybridInfo& h = hybrid_info()) {
+    os << "ranks=" << h.ranks << " threads=" << h.threads << " cores=" << h.cores()
+       << " (" << h.config() << ", " << hybrid_level_name(h.provided) << ")";
+}
@@ -0,0 +1,113 @@
+// mpi_io.hpp
+// Чтение / запись своего куска общего бинарного файла через MPI-IO:
+// каждый процесс обращается только к элементам [first; first + count),
+// вызовы коллективные (*_at_all) — реализация MPI может объединять запросы
+// процессов (collective buffering) вместо рассылки данных с root.
+//  - mpiio_read_slice / mpiio_write_slice — кусок целиком в буфер / из буфера;
+//  - mpiio_stream — кусок читается порциями по chunk элементов с двойной
+//    буферизацией (MPI_File_iread_at_all для порции k+1, пока считается порция k),
+//    память ограничена двумя порциями.
+// Все процессы коммуникатора должны вызывать функции вместе (даже с count = 0).
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>  // min, max
+#include <stdexcept>  // runtime_error
+#include <string>
+#include <vector>
+
+// Тип MPI для элемента
+template <typename T> inline MPI_Datatype mpi_type_of();
+template <> inline MPI_Datatype mpi_type_of<float>() { return MPI_FLOAT; }
+template <> inline MPI_Datatype mpi_type_of<double>() { return MPI_DOUBLE; }
+template <> inline MPI_Datatype mpi_type_of<int>() { return MPI_INT; }
+
+// Порция одного коллективного вызова: count в MPI — int
+const long long MPIIO_MAX_CHUNK = 1LL << 27;
+
+inline MPI_File mpiio_open(const std::string& path, int amode, MPI_Comm comm) {
+    MPI_File fh;
+    if (MPI_File_open(comm, path.c_str(), amode, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+        throw std::runtime_error("mpi_io: cannot open " + path);
+    return fh;
+}
+
+// Число элементов типа T в файле (у всех процессов одинаковое)
+template <typename T>
+inline long long mpiio_file_elements(const std::string& path, MPI_Comm comm) {
+    MPI_File fh = mpiio_open(path, MPI_MODE_RDONLY, comm);
+    MPI_Offset size = 0;
+    MPI_File_get_size(fh, &size);
+    MPI_File_close(&fh);
+    return (long long)size / (long long)sizeof(T);
+}
+
+// Сколько коллективных раундов нужно самому "большому" процессу
+inline long long mpiio_rounds(long long count, long long chunk, MPI_Comm comm) {
+    long long mine = (count + chunk - 1) / chunk, all = 0;
+    MPI_Allreduce(&mine, &all, 1, MPI_LONG_LONG, MPI_MAX, comm);
+    return all;
+}
+
+// Кусок [first; first + count) файла в buf
+template <typename T>
+inline void mpiio_read_slice(const std::string& path, long long first, long long count, T* buf,
+                             MPI_Comm comm = MPI_COMM_WORLD) {
+    MPI_File fh = mpiio_open(path, MPI_MODE_RDONLY, comm);
+    long long rounds = mpiio_rounds(count, MPIIO_MAX_CHUNK, comm);
+    for (long long r = 0; r < rounds; ++r) {
+        long long off = std::min(count, r * MPIIO_MAX_CHUNK);
+        int c = (int)std::min(MPIIO_MAX_CHUNK, count - off);   // у закончивших — 0
+        MPI_File_read_at_all(fh, (MPI_Offset)(first + off) * (MPI_Offset)sizeof(T), buf + off, c,
+                             mpi_type_of<T>(), MPI_STATUS_IGNORE);
+    }
+    MPI_File_close(&fh);
+}
+
+// buf -> кусок [first; first + count) файла (файл создаётся)
+template <typename T>
+inline void mpiio_write_slice(const std::string& path, long long first, long long count, const T* buf,
+                              MPI_Comm comm = MPI_COMM_WORLD) {
+    MPI_File fh = mpiio_open(path, MPI_MODE_WRONLY | MPI_MODE_CREATE, comm);
+    long long rounds = mpiio_rounds(count, MPIIO_MAX_CHUNK, comm);
+    for (long long r = 0; r < rounds; ++r) {
+        long long off = std::min(count, r * MPIIO_MAX_CHUNK);
+        int c = (int)std::min(MPIIO_MAX_CHUNK, count - off);
+        MPI_File_write_at_all(fh, (MPI_Offset)(first + off) * (MPI_Offset)sizeof(T), buf + off, c,
+                              mpi_type_of<T>(), MPI_STATUS_IGNORE);
+    }
+    MPI_File_close(&fh);
+}
+
+// Потоковое чтение куска порциями: fn(const T* data, long long n, long long global_first)
+// вызывается для каждой порции; чтение следующей порции идёт во время fn.
+// Возвращает суммарное время ожидания чтения (с).
+template <typename T, typename Fn>
+inline double mpiio_stream(const std::string& path, long long first, long long count, long long chunk,
+                           Fn&& fn, MPI_Comm comm = MPI_COMM_WORLD) {
+    chunk = std::max(1LL, std::min(chunk, MPIIO_MAX_CHUNK));
+    MPI_File fh = mpiio_open(path, MPI_MODE_RDONLY, comm);
+    long long rounds = mpiio_rounds(count, chunk, comm);
+    std::vector<T> buf[2] = {std::vector<T>((size_t)std::min(chunk, std::max(count, 1LL))),
+                             std::vector<T>((size_t)std::min(chunk, std::max(count, 1LL)))};
+    auto len = [&](long long r) { return std::max(0LL, std::min(chunk, count - r * chunk)); };
+    auto start = [&](long long r, MPI_Request* req) {
+        long long off = std::min(count, r * chunk);
+        MPI_File_iread_at_all(fh, (MPI_Offset)(first + off) * (MPI_Offset)sizeof(T), buf[r & 1].data(),
+                              (int)len(r), mpi_type_of<T>(), req);
+    };
+
+    double wait = 0.0;
+    MPI_Request req = MPI_REQUEST_NULL;
+    if (rounds > 0) start(0, &req);
+    for (long long r = 0; r < rounds; ++r) {
+        double w0 = MPI_Wtime();
+        MPI_Wait(&req, MPI_STATUS_IGNORE);                      // порция r прочитана
+        wait += MPI_Wtime() - w0;
+        if (r + 1 < rounds) start(r + 1, &req);                 // читаем r+1 во второй буфер
+        if (len(r) > 0) fn((const T*)buf[r & 1].data(), len(r), first + r * chunk);
+    }
+    MPI_File_close(&fh);
+    return wait;
+}
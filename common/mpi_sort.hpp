@@ -0,0 +1,198 @@
+// mpi_sort.hpp
+// Распределённая сортировка выборкой (sample sort, PSRS) поверх того же разбиения,
+// что у MPI_Scatterv в p9: build_counts_displs (mpi_decomp.hpp) — куски почти равной длины.
+//  1) каждый процесс сортирует свой кусок (radix_sort_par для 32-битных целых,
+//     иначе merge_sort_par — потоки OpenMP);
+//  2) из отсортированного куска — s = oversample * p регулярных выборок; все выборки
+//     собираются у всех (MPI_Allgatherv), каждый процесс одинаково выбирает p - 1 делителей;
+//  3) кусок режется делителями (двоичный поиск), обмен — MPI_Alltoall (сколько) +
+//     MPI_Alltoallv (данные);
+//  4) пришедшие p отсортированных серий сливаются k-путевым слиянием (куча), потоки
+//     делят выход по значениям-опорам и сливают свои части независимо.
+// Повторы ключей: выборки и делители — пары (ключ, глобальная позиция в отсортированном
+// порядке процесса), поэтому даже массив из одного значения делится поровну.
+// Результат: у процесса r — отсортированный кусок, все ключи процесса r не больше
+// ключей процесса r + 1. Длины кусков примерно равны (не больше ~(1 + 1/oversample) n/p).
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>   // sort, lower_bound, push_heap, pop_heap
+#include <type_traits>
+#include <utility>     // pair
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "mpi_decomp.hpp"  // build_counts_displs
+#include "mpi_io.hpp"      // mpi_type_of<T>
+#include "par_sort.hpp"    // merge_sort_par
+#include "radix_sort.hpp"  // radix_sort_par
+
+// Времена фаз (с) и объёмы одного вызова на этом процессе
+struct SampleSortStats {
+    double t_local = 0;        // локальная сортировка
+    double t_splitters = 0;    // выборки + Allgatherv + делители + разрезание
+    double t_exchange = 0;     // Alltoall + Alltoallv
+    double t_merge = 0;        // k-путевое слияние
+    double t_total = 0;
+    long long n_in = 0, n_out = 0;
+    long long sent_bytes = 0;  // отправлено другим процессам (без себя)
+};
+
+// k-путевое слияние отсортированных серий runs[r] = [ptr, ptr + len) в out.
+// Выход делится между потоками по опорным значениям (выборки из серий): для каждой
+// серии граница — lower_bound опоры, смещение потока в out — сумма границ по сериям.
+template <typename T>
+inline void kway_merge_par(const std::vector<std::pair<const T*, long long>>& runs, T* out) {
+    int k = (int)runs.size();
+    long long total = 0;
+    for (const auto& r : runs) total += r.second;
+    int nt = 1;
+#ifdef _OPENMP
+    nt = total >= (1 << 16) ? omp_get_max_threads() : 1;
+#endif
+    // опоры: по nt выборок из каждой серии, отсортированные, через равные шаги
+    std::vector<T> samples;
+    for (const auto& r : runs)
+        for (int s = 1; s <= nt && r.second > 0; s++) samples.push_back(r.first[r.second * s / (nt + 1)]);
+    std::sort(samples.begin(), samples.end());
+    // bound[t * k + r] — начало части потока t в серии r; t = nt — концы серий
+    std::vector<long long> bound((size_t)(nt + 1) * k, 0);
+    for (int r = 0; r < k; r++) bound[(size_t)nt * k + r] = runs[r].second;
+    for (int t = 1; t < nt; t++) {
+        if (samples.empty()) break;
+        const T& pivot = samples[samples.size() * t / nt];
+        for (int r = 0; r < k; r++)
+            bound[(size_t)t * k + r] = std::lower_bound(runs[r].first, runs[r].first + runs[r].second, pivot) - runs[r].first;
+    }
+
+    #pragma omp parallel for num_threads(nt) schedule(static, 1)
+    for (int t = 0; t < nt; t++) {
+        long long o = 0;
+        for (int r = 0; r < k; r++) o += bound[(size_t)t * k + r];
+        std::vector<long long> pos(k), end(k);
+        std::vector<std::pair<T, int>> heap;                   // (ключ, серия), на вершине — минимум
+        auto greater = [](const std::pair<T, int>& a, const std::pair<T, int>& b) {
+            return b.first < a.first || (!(a.first < b.first) && b.second < a.second);
+        };
+        for (int r = 0; r < k; r++) {
+            pos[r] = bound[(size_t)t * k + r];
+            end[r] = bound[(size_t)(t + 1) * k + r];
+            if (pos[r] < end[r]) heap.push_back({runs[r].first[pos[r]], r});
+        }
+        std::make_heap(heap.begin(), heap.end(), greater);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), greater);
+            int r = heap.back().second;
+            out[o++] = heap.back().first;
+            if (++pos[r] < end[r]) {
+                heap.back().first = runs[r].first[pos[r]];
+                std::push_heap(heap.begin(), heap.end(), greater);
+            } else {
+                heap.pop_back();
+            }
+        }
+    }
+}
+
+// Локальная сортировка: radix для 32-битных целых, иначе сортировка слиянием
+template <typename T>
+inline void sample_sort_local(T* a, long long n) {
+    if constexpr (std::is_integral_v<T> && sizeof(T) == 4) radix_sort_par(a, n);
+    else merge_sort_par(a, n);
+}
+
+// Сортировка data по всем процессам comm; результат — в data (длина меняется)
+template <typename T>
+inline void sample_sort_mpi(std::vector<T>& data, MPI_Comm comm, int oversample = 4,
+                            SampleSortStats* stats = nullptr) {
+    int rank = 0, p = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    SampleSortStats st;
+    st.n_in = (long long)data.size();
+    double t0 = MPI_Wtime();
+
+    // ---------- 1) локальная сортировка ----------
+    sample_sort_local(data.data(), st.n_in);
+    double t1 = MPI_Wtime();
+
+    // ---------- 2) выборки и делители ----------
+    // позиция элемента в порядке "по процессам" — разрешает равные ключи
+    long long n = st.n_in, offset = 0;
+    MPI_Exscan(&n, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    if (rank == 0) offset = 0;
+    struct Sample { T key; long long pos; };
+    auto less = [](const Sample& a, const Sample& b) { return a.key < b.key || (!(b.key < a.key) && a.pos < b.pos); };
+
+    int s = (int)std::min<long long>(n, (long long)oversample * p);
+    std::vector<Sample> mine((size_t)s);
+    for (int i = 0; i < s; i++) {
+        long long at = n * (i + 1) / (s + 1);
+        mine[(size_t)i] = {data[(size_t)at], offset + at};
+    }
+    std::vector<int> sCounts(p), sDispls(p, 0);
+    int sBytes = s * (int)sizeof(Sample);
+    MPI_Allgather(&sBytes, 1, MPI_INT, sCounts.data(), 1, MPI_INT, comm);
+    for (int r = 1; r < p; r++) sDispls[r] = sDispls[r - 1] + sCounts[r - 1];
+    std::vector<Sample> all((size_t)(sDispls[p - 1] + sCounts[p - 1]) / sizeof(Sample));
+    MPI_Allgatherv(mine.data(), sBytes, MPI_BYTE, all.data(), sCounts.data(), sDispls.data(), MPI_BYTE, comm);
+    std::sort(all.begin(), all.end(), less);                 // одинаково на всех процессах
+
+    // делитель j — выборка с номером (j + 1) * |all| / p; процессу j идут элементы <= делителя j
+    std::vector<int> sendCounts(p, 0), sendDispls(p, 0);
+    long long prev = 0;
+    for (int j = 0; j < p; j++) {
+        long long cut = n;
+        if (j < p - 1 && !all.empty()) {
+            const Sample& sp = all[all.size() * (j + 1) / p];
+            // первый i, у которого (data[i], offset + i) > делителя; порядок пар совпадает с порядком i
+            long long lo = prev, hi = n;
+            while (lo < hi) {
+                long long mid = (lo + hi) / 2;
+                if (less(sp, Sample{data[(size_t)mid], offset + mid})) hi = mid;
+                else lo = mid + 1;
+            }
+            cut = lo;
+        }
+        sendCounts[j] = (int)(cut - prev);
+        sendDispls[j] = (int)prev;
+        prev = cut;
+    }
+    double t2 = MPI_Wtime();
+
+    // ---------- 3) обмен ----------
+    std::vector<int> recvCounts(p), recvDispls(p, 0);
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+    for (int r = 1; r < p; r++) recvDispls[r] = recvDispls[r - 1] + recvCounts[r - 1];
+    long long nOut = (long long)recvDispls[p - 1] + recvCounts[p - 1];
+    std::vector<T> recv((size_t)nOut);
+    MPI_Alltoallv(data.data(), sendCounts.data(), sendDispls.data(), mpi_type_of<T>(),
+                  recv.data(), recvCounts.data(), recvDispls.data(), mpi_type_of<T>(), comm);
+    for (int j = 0; j < p; j++)
+        if (j != rank) st.sent_bytes += (long long)sendCounts[j] * (long long)sizeof(T);
+    double t3 = MPI_Wtime();
+
+    // ---------- 4) k-путевое слияние p серий ----------
+    std::vector<std::pair<const T*, long long>> runs;
+    for (int r = 0; r < p; r++) runs.push_back({recv.data() + recvDispls[r], (long long)recvCounts[r]});
+    if (p == 1) {
+        data.swap(recv);                      // одна серия — уже отсортирована
+    } else {
+        std::vector<T>().swap(data);          // вход больше не нужен: в памяти recv + результат
+        data.resize((size_t)nOut);
+        kway_merge_par(runs, data.data());
+    }
+    double t4 = MPI_Wtime();
+
+    st.n_out = nOut;
+    st.t_local = t1 - t0;
+    st.t_splitters = t2 - t1;
+    st.t_exchange = t3 - t2;
+    st.t_merge = t4 - t3;
+    st.t_total = t4 - t0;
+    if (stats) *stats = st;
+}
@@ -0,0 +1,134 @@
+// mpi_stats.hpp
+// Слитая (fused) редукция статистики между процессами: вместо отдельных
+// MPI_Reduce для суммы, min, max (и суммы квадратов) — ОДНА коллективная
+// операция над структурой, описанной производным типом (MPI_Type_create_struct),
+// с пользовательской операцией MPI_Op.
+//  - SumStats (accurate_sum.hpp): сумма и сумма квадратов как пары Ноймайера,
+//    min, max, n — sumstats_mpi_type() / sumstats_mpi_op();
+//  - Moments (stream_stats.hpp): n, mean, M2, min, max со слиянием Чана —
+//    moments_mpi_type() / moments_mpi_op();
+//  - QuantileSketch (par_hist.hpp): перцентили всего массива — счётчики корзин
+//    складываются — quantile_sketch_mpi_type() / quantile_sketch_mpi_op().
+//
+//   SumStats local = sum_stats_par(a, n), global;
+//   MPI_Allreduce(&local, &global, 1, sumstats_mpi_type(), sumstats_mpi_op(), comm);
+//
+// Операции некоммутативные (как neumaier_mpi_op): части сливаются в порядке
+// rank'ов, результат воспроизводим. Создаются при первом вызове (после MPI_Init).
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>  // offsetof
+
+#include "accurate_sum.hpp"
+#include "par_hist.hpp"
+#include "stream_stats.hpp"
+
+// Производный тип по полям структуры; resized — чтобы шаг массива был sizeof(S)
+inline MPI_Datatype mpi_struct_type(int count, const int* lens, const MPI_Aint* offs,
+                                    const MPI_Datatype* types, MPI_Aint extent) {
+    MPI_Datatype t, r;
+    MPI_Type_create_struct(count, lens, offs, types, &t);
+    MPI_Type_create_resized(t, 0, extent, &r);
+    MPI_Type_free(&t);
+    MPI_Type_commit(&r);
+    return r;
+}
+
+// ==================== SumStats ====================
+
+inline MPI_Datatype sumstats_mpi_type() {
+    static MPI_Datatype type = [] {
+        int lens[] = {2, 2, 1, 1, 1};
+        MPI_Aint offs[] = {offsetof(SumStats, sum), offsetof(SumStats, sumsq), offsetof(SumStats, min),
+                           offsetof(SumStats, max), offsetof(SumStats, n)};
+        MPI_Datatype types[] = {MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_LONG_LONG};
+        return mpi_struct_type(5, lens, offs, types, sizeof(SumStats));
+    }();
+    return type;
+}
+
+// inout[i] = in[i] (+) inout[i]; in — от процессов с меньшими номерами
+inline void sumstats_mpi_merge(void* in, void* inout, int* len, MPI_Datatype*) {
+    const SumStats* a = (const SumStats*)in;
+    SumStats* b = (SumStats*)inout;
+    for (int i = 0; i < *len; ++i) {
+        SumStats r = a[i];
+        r.merge(b[i]);
+        b[i] = r;
+    }
+}
+
+inline MPI_Op sumstats_mpi_op() {
+    static MPI_Op op = [] {
+        MPI_Op o;
+        MPI_Op_create(&sumstats_mpi_merge, 0, &o);   // 0 — некоммутативная
+        return o;
+    }();
+    return op;
+}
+
+// ==================== Moments ====================
+
+inline MPI_Datatype moments_mpi_type() {
+    static MPI_Datatype type = [] {
+        int lens[] = {1, 1, 1, 1, 1};
+        MPI_Aint offs[] = {offsetof(Moments, n), offsetof(Moments, mean), offsetof(Moments, m2),
+                           offsetof(Moments, min), offsetof(Moments, max)};
+        MPI_Datatype types[] = {MPI_LONG_LONG, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE};
+        return mpi_struct_type(5, lens, offs, types, sizeof(Moments));
+    }();
+    return type;
+}
+
+inline void moments_mpi_merge(void* in, void* inout, int* len, MPI_Datatype*) {
+    const Moments* a = (const Moments*)in;
+    Moments* b = (Moments*)inout;
+    for (int i = 0; i < *len; ++i) {
+        Moments r = a[i];
+        moments_merge(r, b[i]);
+        b[i] = r;
+    }
+}
+
+inline MPI_Op moments_mpi_op() {
+    static MPI_Op op = [] {
+        MPI_Op o;
+        MPI_Op_create(&moments_mpi_merge, 0, &o);
+        return o;
+    }();
+    return op;
+}
+
+// ==================== QuantileSketch ====================
+
+inline MPI_Datatype quantile_sketch_mpi_type() {
+    static MPI_Datatype type = [] {
+        const int B = QuantileSketch::BINS;
+        int lens[] = {1, 1, 1, 1, 1, B, B};
+        MPI_Aint offs[] = {offsetof(QuantileSketch, n), offsetof(QuantileSketch, zero),
+                           offsetof(QuantileSketch, sum), offsetof(QuantileSketch, min),
+                           offsetof(QuantileSketch, max), offsetof(QuantileSketch, pos),
+                           offsetof(QuantileSketch, neg)};
+        MPI_Datatype types[] = {MPI_LONG_LONG, MPI_LONG_LONG, MPI_DOUBLE, MPI_DOUBLE,
+                                MPI_DOUBLE, MPI_LONG_LONG, MPI_LONG_LONG};
+        return mpi_struct_type(7, lens, offs, types, sizeof(QuantileSketch));
+    }();
+    return type;
+}
+
+inline void quantile_sketch_mpi_merge(void* in, void* inout, int* len, MPI_Datatype*) {
+    const QuantileSketch* a = (const QuantileSketch*)in;
+    QuantileSketch* b = (QuantileSketch*)inout;
+    for (int i = 0; i < *len; ++i) b[i].merge(a[i]);
+}
+
+inline MPI_Op quantile_sketch_mpi_op() {
+    static MPI_Op op = [] {
+        MPI_Op o;
+        MPI_Op_create(&quantile_sketch_mpi_merge, 0, &o);
+        return o;
+    }();
+    return op;
+}
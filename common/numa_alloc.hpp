@@ -0,0 +1,306 @@
+// numa_alloc.hpp
+// Выделение больших массивов с учётом NUMA:
+//  - выравнивание 64 байта (строка кэша), память через mmap; начало массива сдвинуто
+//    от начала отображения на k * 64 байта (k = 31..0 по кругу, «раскраска»): иначе все
+//    массивы начинаются с границы 2 МБ / 4 КБ, адреса in[i] и out[i] совпадают в младших
+//    12 битах (4K aliasing: загрузка ждёт запись в «тот же» адрес) — цикл «вход -> выход»
+//    на двух numa_vector был ~10x медленнее, чем на std::vector (p7/scan_cpu). Сдвиг
+//    убывает: у массива, выделенного позже, out[i] на 64 байта ниже in[i] по модулю 4 КБ,
+//    и записи не совпадают с загрузками, идущими впереди (при возрастающем сдвиге SIMD-скан
+//    был ~3x медленнее);
+//  - большие страницы 2 МБ: прозрачные (madvise MADV_HUGEPAGE, по умолчанию)
+//    или явные (MAP_HUGETLB; если не настроены — откат на прозрачные);
+//  - параллельное первое касание: поток t обнуляет элементы [n*t/p; n*(t+1)/p) —
+//    те же куски, что обрабатывают compute_stats_par, radix_sort и
+//    schedule(static), поэтому страницы оказываются на узле потока,
+//    который их потом читает (а не все на узле 0 при однопоточном заполнении);
+//  - отчёт, где страницы реально оказались (move_pages) и сколько памяти
+//    попало в большие страницы (/proc/self/smaps).
+// Режим больших страниц: NUMA_HUGE=none|thp|explicit (по умолчанию thp).
+// Без Linux — обычный aligned_alloc и последовательное заполнение.
+#pragma once
+
+#include <algorithm> // min, max
+#include <atomic>    // счётчик раскраски
+#include <cstddef>   // size_t
+#include <cstdint>   // uintptr_t
+#include <cstdlib>   // getenv, aligned_alloc, free
+#include <cstring>   // strcmp
+#include <iostream>  // отчёт
+#include <limits>    // numeric_limits
+#include <new>       // bad_alloc
+#include <string>
+#include <type_traits> // is_trivially_*
+#include <utility>   // forward
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>       // /proc/self/smaps
+#include <sstream>
+#include <sys/mman.h>    // mmap, madvise
+#include <sys/syscall.h> // SYS_move_pages, SYS_getcpu
+#include <unistd.h>
+#endif
+
+const size_t NUMA_ALIGN = 64;                  // выравнивание начала массива
+const size_t NUMA_PAGE = 4096;                 // обычная страница
+const size_t NUMA_HUGE_PAGE = 2u << 20;        // большая страница 2 МБ
+const size_t NUMA_COLORS = 32;                 // сдвиги начала: 0, 64, ..., 31 * 64 байта (< страницы)
+
+enum class NumaHuge { None, Transparent, Explicit };
+
+inline NumaHuge numa_huge_mode() {
+    static const NumaHuge mode = [] {
+        const char* env = std::getenv("NUMA_HUGE");
+        if (env && std::strcmp(env, "none") == 0) return NumaHuge::None;
+        if (env && std::strcmp(env, "explicit") == 0) return NumaHuge::Explicit;
+        return NumaHuge::Transparent;
+    }();
+    return mode;
+}
+
+inline const char* numa_huge_name(NumaHuge m) {
+    switch (m) {
+        case NumaHuge::None: return "none";
+        case NumaHuge::Explicit: return "explicit";
+        default: return "thp";
+    }
+}
+
+// Длина отображения: массивы меньше 2 МБ большие страницы не получают
+inline size_t numa_map_len(size_t bytes) {
+    size_t page = (numa_huge_mode() != NumaHuge::None && bytes >= NUMA_HUGE_PAGE) ? NUMA_HUGE_PAGE : NUMA_PAGE;
+    return (bytes + page - 1) / page * page;
+}
+
+// Сдвиг начала очередного массива от начала отображения: k * NUMA_ALIGN, k = 31, 30, ..., 0, 31, ...
+inline size_t numa_next_color() {
+    static std::atomic<unsigned> counter{0};
+    unsigned c = counter.fetch_add(1, std::memory_order_relaxed);
+    return (NUMA_COLORS - 1 - c % NUMA_COLORS) * NUMA_ALIGN;
+}
+
+#ifdef __linux__
+// Отображение длины len (кратна странице): явные / прозрачные большие страницы или обычные
+inline char* numa_map(size_t len) {
+    const int prot = PROT_READ | PROT_WRITE, flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (len % NUMA_HUGE_PAGE == 0 && numa_huge_mode() == NumaHuge::Explicit) {
+        void* p = mmap(nullptr, len, prot, flags | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) return (char*)p;    // иначе — прозрачные страницы
+    }
+    if (len % NUMA_HUGE_PAGE != 0) {
+        void* p = mmap(nullptr, len, prot, flags, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        return (char*)p;
+    }
+    // прозрачные большие страницы: начало выравниваем на 2 МБ, лишнее отрезаем
+    char* raw = (char*)mmap(nullptr, len + NUMA_HUGE_PAGE, prot, flags, -1, 0);
+    if (raw == (char*)MAP_FAILED) throw std::bad_alloc();
+    uintptr_t a = ((uintptr_t)raw + NUMA_HUGE_PAGE - 1) & ~(uintptr_t)(NUMA_HUGE_PAGE - 1);
+    char* p = (char*)a;
+    if (p > raw) munmap(raw, (size_t)(p - raw));
+    size_t tail = (size_t)(raw + len + NUMA_HUGE_PAGE - (p + len));
+    if (tail) munmap(p + len, tail);
+#ifdef MADV_HUGEPAGE
+    madvise(p, len, MADV_HUGEPAGE);
+#endif
+    return p;
+}
+#endif
+
+// Сырая память (без касания). Освобождать numa_free_bytes(p, bytes).
+// Начало отображения = p с обнулёнными младшими 12 битами (сдвиг раскраски меньше страницы)
+inline void* numa_alloc_bytes(size_t bytes) {
+    if (bytes == 0) bytes = 1;
+#ifdef __linux__
+    size_t off = numa_next_color();
+    return numa_map(numa_map_len(bytes + off)) + off;
+#else
+    void* p = std::aligned_alloc(NUMA_ALIGN, (bytes + NUMA_ALIGN - 1) / NUMA_ALIGN * NUMA_ALIGN);
+    if (!p) throw std::bad_alloc();
+    return p;
+#endif
+}
+
+inline void numa_free_bytes(void* p, size_t bytes) {
+    if (!p) return;
+#ifdef __linux__
+    char* base = (char*)((uintptr_t)p & ~(uintptr_t)(NUMA_PAGE - 1));
+    size_t off = (size_t)((char*)p - base);
+    munmap(base, numa_map_len((bytes == 0 ? 1 : bytes) + off));
+#else
+    (void)bytes;
+    std::free(p);
+#endif
+}
+
+// Параллельное первое касание: поток t записывает T() в свой кусок [n*t/p; n*(t+1)/p).
+// Только для тривиальных T: память сырая, объекты не создаются и не разрушаются
+template <typename T>
+inline void numa_first_touch(T* p, size_t n) {
+    static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                  "numa_alloc: только тривиальные типы (первое касание пишет в сырую память)");
+    #pragma omp parallel
+    {
+        size_t t = 0, used = 1;
+#ifdef _OPENMP
+        t = (size_t)omp_get_thread_num();
+        used = (size_t)omp_get_num_threads();
+#endif
+        size_t lo = n * t / used, hi = n * (t + 1) / used;
+        for (size_t i = lo; i < hi; ++i) p[i] = T();
+    }
+}
+
+// Массив из n элементов: выделение + параллельное первое касание (элементы = T())
+template <typename T>
+inline T* numa_alloc_array(size_t n) {
+    T* p = (T*)numa_alloc_bytes(n * sizeof(T));
+    numa_first_touch(p, n);
+    return p;
+}
+
+template <typename T>
+inline void numa_free(T* p, size_t n) {
+    numa_free_bytes(p, n * sizeof(T));
+}
+
+// Аллокатор для std::vector: память уже "касается" в allocate,
+// поэтому construct() без аргументов ничего не пишет (default-init)
+template <typename T>
+struct NumaAllocator {
+    using value_type = T;
+
+    NumaAllocator() = default;
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return numa_alloc_array<T>(n);
+    }
+    void deallocate(T* p, size_t n) { numa_free(p, n); }
+
+    template <typename U>
+    void construct(U* p) { ::new ((void*)p) U; }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) { ::new ((void*)p) U(std::forward<Args>(args)...); }
+
+    template <typename U>
+    bool operator==(const NumaAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const NumaAllocator<U>&) const { return false; }
+};
+
+// Контейнер: std::vector с NUMA-аллокатором
+template <typename T>
+using numa_vector = std::vector<T, NumaAllocator<T>>;
+
+// ==================== ОТЧЁТ О РАЗМЕЩЕНИИ ====================
+
+// Узел NUMA, на котором сейчас выполняется поток (-1 — неизвестно)
+inline int numa_current_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return (int)node;
+#endif
+    return -1;
+}
+
+// Узлы страниц по адресам (move_pages без перемещения); отрицательное — ошибка
+inline void numa_query_nodes(std::vector<void*>& pages, std::vector<int>& nodes) {
+    nodes.assign(pages.size(), -1);
+#if defined(__linux__) && defined(SYS_move_pages)
+    if (!pages.empty() &&
+        syscall(SYS_move_pages, 0, (unsigned long)pages.size(), pages.data(), nullptr, nodes.data(), 0) != 0)
+        nodes.assign(pages.size(), -1);
+#endif
+}
+
+// Сколько кБ отображения, содержащего p, лежит в больших страницах (THP); -1 — неизвестно
+inline long numa_huge_kb(const void* p) {
+#ifdef __linux__
+    std::ifstream f("/proc/self/smaps");
+    std::string line;
+    bool inside = false;
+    uintptr_t a = (uintptr_t)p;
+    while (std::getline(f, line)) {
+        unsigned long lo = 0, hi = 0;
+        char dash = 0;
+        std::istringstream head(line);
+        if (head >> std::hex >> lo >> dash >> hi && dash == '-') {   // заголовок отображения
+            inside = a >= lo && a < hi;
+            continue;
+        }
+        if (inside && line.compare(0, 14, "AnonHugePages:") == 0)
+            return std::stol(line.substr(14));
+    }
+#else
+    (void)p;
+#endif
+    return -1;
+}
+
+// Где лежат страницы массива p[0..n): гистограмма по узлам (выборка до samples
+// страниц) и доля страниц, локальных для потока, которому кусок достаётся
+// при разбиении [n*t/p; n*(t+1)/p). Вызывать вне parallel-региона.
+template <typename T>
+inline void numa_report(const T* p, size_t n, std::ostream& os = std::cout, size_t samples = 4096) {
+    size_t bytes = n * sizeof(T);
+    size_t pages = (bytes + NUMA_PAGE - 1) / NUMA_PAGE;
+    if (pages == 0) return;
+    size_t step = pages > samples ? pages / samples : 1;
+
+    std::vector<void*> addr;
+    for (size_t pg = 0; pg < pages; pg += step)
+        addr.push_back((void*)(((uintptr_t)p + pg * NUMA_PAGE) & ~(uintptr_t)(NUMA_PAGE - 1)));
+    std::vector<int> node;
+    numa_query_nodes(addr, node);
+
+    // узел каждого потока команды
+    int used = 1;
+#ifdef _OPENMP
+    used = omp_get_max_threads();
+#endif
+    std::vector<int> tnode(used, -1);
+    #pragma omp parallel num_threads(used)
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        tnode[t] = numa_current_node();
+    }
+
+    std::vector<long long> hist;
+    long long local = 0, known = 0, failed = 0;
+    for (size_t k = 0; k < addr.size(); ++k) {
+        if (node[k] < 0) { ++failed; continue; }
+        if ((size_t)node[k] >= hist.size()) hist.resize(node[k] + 1, 0);
+        hist[node[k]]++;
+        // какой поток "владеет" этой страницей
+        size_t elem = ((uintptr_t)addr[k] < (uintptr_t)p ? 0 : ((uintptr_t)addr[k] - (uintptr_t)p) / sizeof(T));
+        int owner = (int)std::min<size_t>((size_t)used - 1, elem * (size_t)used / std::max<size_t>(n, 1));
+        while (owner + 1 < used && elem >= n * (size_t)(owner + 1) / used) ++owner;
+        if (tnode[owner] >= 0) {
+            ++known;
+            if (tnode[owner] == node[k]) ++local;
+        }
+    }
+
+    os << "numa: " << bytes / (1 << 20) << " MB, huge=" << numa_huge_name(numa_huge_mode());
+    long kb = numa_huge_kb(p);
+    if (kb >= 0) os << " (in huge pages " << kb / 1024 << " MB)";
+    os << ", sampled pages " << addr.size() << ":";
+    if (failed == (long long)addr.size()) {
+        os << " placement unknown (move_pages unavailable)\n";
+        return;
+    }
+    for (size_t nd = 0; nd < hist.size(); ++nd) os << " node" << nd << "=" << hist[nd];
+    if (known > 0) os << ", local to owner thread " << 100.0 * (double)local / (double)known << "%";
+    os << "\n";
+}
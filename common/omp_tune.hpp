@@ -0,0 +1,371 @@
+// omp_tune.hpp
+// Автотюнер параллельных циклов OpenMP: для каждого ядра и размера (корзина по log2 n)
+// подбирается число потоков, schedule (static / dynamic / guided), размер куска и порог
+// min_n, ниже которого ядро выполняется последовательно (на маленьких массивах запуск
+// потоков дороже самой работы — см. a2, задание 2). Лучшие конфигурации сохраняются в файл
+// настроек; рабочие запуски читают его при старте и берут конфигурацию ближайшей корзины.
+//  - omp_tuned_for(cfg, n, body) — цикл по [0; n) с конфигурацией cfg; body(b, e, t)
+//    получает диапазон и номер потока (для частичных результатов редукции);
+//  - OmpTuner::tune_kernel(name, sizes, fn) — поиск по размерам: сначала число потоков
+//    (static), затем schedule x chunk при лучшем числе потоков, затем соседние числа потоков
+//    с найденным schedule. Полный перебор не нужен: параметры почти независимы;
+//  - omp_fit_amdahl / omp_fit_gustafson — модели по замерам strong / weak scaling
+//    (МНК), чтобы оценить ускорение на большем числе ядер, чем есть на машине.
+// Файл: строка "<хост> | <N>t\t<ядро>\t<корзина>\t<threads> <schedule> <chunk> <min_n> <ms>".
+// Ключ с именем хоста и числом потоков: настройка под 8 ядер неверна для 4.
+#pragma once
+
+#include <algorithm>   // min, max, sort
+#include <cmath>       // sqrt
+#include <cstdlib>     // abs
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>    // gethostname
+#endif
+
+#include "bench.hpp"   // bench_measure, bench_thread_counts, bench_max_threads
+
+enum class OmpSched { Static, Dynamic, Guided };
+
+inline const char* omp_sched_name(OmpSched s) {
+    switch (s) {
+        case OmpSched::Static:  return "static";
+        case OmpSched::Dynamic: return "dynamic";
+        default:                return "guided";
+    }
+}
+
+inline bool omp_sched_parse(const std::string& s, OmpSched& out) {
+    if (s == "static") out = OmpSched::Static;
+    else if (s == "dynamic") out = OmpSched::Dynamic;
+    else if (s == "guided") out = OmpSched::Guided;
+    else return false;
+    return true;
+}
+
+// Конфигурация цикла; по умолчанию — как без тюнера (все потоки, schedule(static))
+struct OmpTuneConfig {
+    int threads = bench_max_threads();
+    OmpSched sched = OmpSched::Static;
+    long long chunk = 0;        // элементов в куске; 0 при static — один кусок на поток
+    long long min_n = 0;        // n < min_n — последовательно
+
+    std::string str() const {
+        std::ostringstream o;
+        o << "threads=" << threads << " schedule=" << omp_sched_name(sched) << "," << chunk
+          << " min_n=" << min_n;
+        return o.str();
+    }
+};
+
+// Корзина размера: floor(log2 n)
+inline int omp_tune_bucket(long long n) {
+    return n <= 1 ? 0 : 63 - __builtin_clzll((unsigned long long)n);
+}
+
+// Цикл по [0; n) с конфигурацией c. Куски по c.chunk элементов раздаёт OpenMP
+// (schedule(dynamic, 1) / schedule(guided, 1) по номерам кусков), static без chunk —
+// непрерывный диапазон на поток. body(b, e, t) вызывается для каждого куска.
+template <typename Body>
+inline void omp_tuned_for(const OmpTuneConfig& c, long long n, Body&& body) {
+    if (n <= 0) return;
+#ifdef _OPENMP
+    if (n < c.min_n || c.threads <= 1) {
+        body(0LL, n, 0);
+        return;
+    }
+    if (c.sched == OmpSched::Static && c.chunk <= 0) {
+        #pragma omp parallel num_threads(c.threads)
+        {
+            int t = omp_get_thread_num(), used = omp_get_num_threads();
+            long long b = n * t / used, e = n * (t + 1) / used;
+            if (b < e) body(b, e, t);
+        }
+        return;
+    }
+    long long chunk = std::max(1LL, c.chunk);
+    long long pieces = (n + chunk - 1) / chunk;
+    auto piece = [&](long long p) { body(p * chunk, std::min(n, (p + 1) * chunk), omp_get_thread_num()); };
+    if (c.sched == OmpSched::Static) {
+        #pragma omp parallel for num_threads(c.threads) schedule(static, 1)
+        for (long long p = 0; p < pieces; p++) piece(p);
+    } else if (c.sched == OmpSched::Dynamic) {
+        #pragma omp parallel for num_threads(c.threads) schedule(dynamic, 1)
+        for (long long p = 0; p < pieces; p++) piece(p);
+    } else {
+        #pragma omp parallel for num_threads(c.threads) schedule(guided, 1)
+        for (long long p = 0; p < pieces; p++) piece(p);
+    }
+#else
+    (void)c;
+    body(0LL, n, 0);
+#endif
+}
+
+// ==================== МОДЕЛИ МАСШТАБИРУЕМОСТИ ====================
+
+// Амдал (strong scaling): T(p) = T1 * (s + (1 - s) / p) — прямая по x = 1/p
+struct AmdahlFit {
+    double t1_ms = 0;           // оценка времени на одном потоке
+    double serial = 0;          // последовательная доля s
+    double r2 = 0;              // качество подгонки
+    double speedup(double p) const { return 1.0 / (serial + (1.0 - serial) / p); }
+    double limit() const { return serial > 0 ? 1.0 / serial : 0.0; }  // предел ускорения, 0 — нет предела
+};
+
+inline AmdahlFit omp_fit_amdahl(const std::vector<int>& p, const std::vector<double>& ms) {
+    AmdahlFit f;
+    size_t k = std::min(p.size(), ms.size());
+    if (k == 0) return f;
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < k; i++) {
+        double x = 1.0 / p[i];
+        sx += x; sy += ms[i]; sxx += x * x; sxy += x * ms[i];
+    }
+    double den = (double)k * sxx - sx * sx;
+    double b = den > 0 ? ((double)k * sxy - sx * sy) / den : 0.0;   // параллельная часть
+    double a = (sy - b * sx) / (double)k;                             // последовательная часть
+    // части времени не бывают отрицательными: пересчитываем МНК без свободного члена / наклона
+    if (a < 0) { a = 0; b = sxx > 0 ? sxy / sxx : 0.0; }
+    if (b < 0) { b = 0; a = sy / (double)k; }
+    f.t1_ms = a + b;
+    f.serial = f.t1_ms > 0 ? a / f.t1_ms : 0.0;
+    double mean = sy / (double)k, ssTot = 0, ssRes = 0;
+    for (size_t i = 0; i < k; i++) {
+        double pred = a + b / p[i];
+        ssRes += (ms[i] - pred) * (ms[i] - pred);
+        ssTot += (ms[i] - mean) * (ms[i] - mean);
+    }
+    f.r2 = ssTot > 0 ? 1.0 - ssRes / ssTot : 1.0;
+    return f;
+}
+
+// Густафсон (weak scaling, работа растёт вместе с p):
+// масштабированное ускорение S(p) = p - a * (p - 1), a — последовательная доля
+struct GustafsonFit {
+    double serial = 0;
+    double r2 = 0;
+    double speedup(double p) const { return p - serial * (p - 1.0); }
+};
+
+// scaled[i] = p[i] * T(n, 1) / T(n * p[i], p[i]) — из замеров weak scaling
+inline GustafsonFit omp_fit_gustafson(const std::vector<int>& p, const std::vector<double>& scaled) {
+    GustafsonFit f;
+    size_t k = std::min(p.size(), scaled.size());
+    double num = 0, den = 0;
+    for (size_t i = 0; i < k; i++) {               // p - S = a (p - 1): МНК без свободного члена
+        num += (p[i] - scaled[i]) * (p[i] - 1.0);
+        den += (p[i] - 1.0) * (p[i] - 1.0);
+    }
+    f.serial = den > 0 ? std::min(1.0, std::max(0.0, num / den)) : 0.0;
+    double mean = 0, ssTot = 0, ssRes = 0;
+    for (size_t i = 0; i < k; i++) mean += scaled[i];
+    mean = k ? mean / (double)k : 0.0;
+    for (size_t i = 0; i < k; i++) {
+        double pred = f.speedup(p[i]);
+        ssRes += (scaled[i] - pred) * (scaled[i] - pred);
+        ssTot += (scaled[i] - mean) * (scaled[i] - mean);
+    }
+    f.r2 = ssTot > 0 ? 1.0 - ssRes / ssTot : 1.0;
+    return f;
+}
+
+// ==================== ТЮНЕР ====================
+
+// Ключ машины: имя хоста и доступное число потоков
+inline std::string omp_tune_host_key() {
+    char host[256] = "host";
+#if defined(__unix__) || defined(__APPLE__)
+    if (gethostname(host, sizeof(host)) != 0) host[0] = '\0';
+    host[sizeof(host) - 1] = '\0';
+#endif
+    return std::string(host) + " | " + std::to_string(bench_max_threads()) + "t";
+}
+
+// Итог поиска для одного размера
+struct OmpTuneResult {
+    long long n = 0;
+    OmpTuneConfig best;
+    double best_ms = 0;
+    double seq_ms = 0;                  // один поток
+    std::vector<int> threads;           // шаг 1: strong scaling при schedule(static)
+    std::vector<double> threads_ms;
+    int tried = 0;                      // сколько конфигураций замерено
+};
+
+class OmpTuner {
+public:
+    using KernelFn = std::function<void(const OmpTuneConfig&, long long)>;
+
+    explicit OmpTuner(std::string path = "omp_tuning.txt", std::string host = omp_tune_host_key())
+        : path_(std::move(path)), host_(std::move(host)) {
+        load();
+    }
+
+    const std::string& host() const { return host_; }
+    const std::string& path() const { return path_; }
+
+    // Есть ли настройки ядра для этой машины
+    bool has(const std::string& kernel) const {
+        for (const Entry& e : entries_)
+            if (e.kernel == kernel) return true;
+        return false;
+    }
+
+    // Конфигурация для размера n: корзина n или ближайшая настроенная; без записей — по умолчанию
+    OmpTuneConfig get(const std::string& kernel, long long n) const {
+        int b = omp_tune_bucket(n), bestDist = 1 << 30;
+        OmpTuneConfig c;
+        for (const Entry& e : entries_) {
+            if (e.kernel != kernel) continue;
+            int d = std::abs(e.bucket - b);
+            if (d < bestDist) { bestDist = d; c = e.cfg; }
+        }
+        c.threads = std::min(c.threads, bench_max_threads());
+        return c;
+    }
+
+    // Поиск для каждого размера из sizes (по возрастанию); fn(cfg, n) — один вызов ядра.
+    // После поиска min_n ядра = первый размер, начиная с которого параллельно быстрее
+    // последовательного на всех больших размерах (между ним и предыдущим — среднее геометрическое).
+    std::vector<OmpTuneResult> tune_kernel(const std::string& kernel, std::vector<long long> sizes,
+                                           const KernelFn& fn, const BenchConfig& bc = quick_config()) {
+        std::sort(sizes.begin(), sizes.end());
+        std::vector<OmpTuneResult> res;
+        for (long long n : sizes) res.push_back(tune_size(kernel, n, fn, bc));
+
+        long long minN = 0;
+        for (size_t i = res.size(); i-- > 0;) {
+            const OmpTuneResult& r = res[i];
+            if (r.best.threads > 1 && r.best_ms < r.seq_ms) continue;
+            minN = i + 1 < res.size()
+                ? (long long)std::sqrt((double)r.n * (double)res[i + 1].n) : r.n + 1;
+            break;
+        }
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                      [&](const Entry& e) { return e.kernel == kernel; }),
+                       entries_.end());
+        for (OmpTuneResult& r : res) {
+            r.best.min_n = minN;
+            entries_.push_back({kernel, omp_tune_bucket(r.n), r.best, r.best_ms});
+        }
+        return res;
+    }
+
+    // Записываем настройки этой машины; строки других хостов сохраняются
+    bool save() const {
+        std::vector<std::string> lines;
+        {
+            std::ifstream f(path_);
+            std::string line;
+            while (std::getline(f, line))
+                if (line.compare(0, host_.size() + 1, host_ + "\t") != 0) lines.push_back(line);
+        }
+        for (const Entry& e : entries_) {
+            std::ostringstream o;
+            o << host_ << "\t" << e.kernel << "\t" << e.bucket << "\t" << e.cfg.threads << " "
+              << omp_sched_name(e.cfg.sched) << " " << e.cfg.chunk << " " << e.cfg.min_n << " " << e.ms;
+            lines.push_back(o.str());
+        }
+        std::ofstream out(path_);
+        if (!out) return false;
+        for (const auto& l : lines) out << l << "\n";
+        return true;
+    }
+
+    // Короткие замеры: конфигураций десятки на каждый размер
+    static BenchConfig quick_config() {
+        BenchConfig bc;
+        bc.min_reps = 3;
+        bc.min_time_s = 0.02;
+        return bc;
+    }
+
+private:
+    struct Entry {
+        std::string kernel;
+        int bucket = 0;
+        OmpTuneConfig cfg;
+        double ms = 0;
+    };
+
+    void load() {
+        std::ifstream f(path_);
+        std::string line;
+        while (std::getline(f, line)) {
+            if (line.compare(0, host_.size() + 1, host_ + "\t") != 0) continue;
+            std::istringstream in(line.substr(host_.size() + 1));
+            Entry e;
+            std::string sched;
+            if (!std::getline(in, e.kernel, '\t')) continue;
+            if (in >> e.bucket >> e.cfg.threads >> sched >> e.cfg.chunk >> e.cfg.min_n >> e.ms &&
+                omp_sched_parse(sched, e.cfg.sched))
+                entries_.push_back(e);
+        }
+    }
+
+    static double measure(const std::string& kernel, const KernelFn& fn, const OmpTuneConfig& c,
+                          long long n, const BenchConfig& bc) {
+        return bench_measure(kernel, "tune", n, [&] { fn(c, n); }, bc).median_ms;
+    }
+
+    OmpTuneResult tune_size(const std::string& kernel, long long n, const KernelFn& fn, const BenchConfig& bc) {
+        OmpTuneResult r;
+        r.n = n;
+        auto consider = [&](const OmpTuneConfig& c) {
+            double ms = measure(kernel, fn, c, n, bc);
+            r.tried++;
+            if (r.best_ms <= 0 || ms < r.best_ms) { r.best_ms = ms; r.best = c; }
+            return ms;
+        };
+
+        // 1) число потоков при schedule(static)
+        OmpTuneConfig c;
+        for (int t : bench_thread_counts()) {
+            c.threads = t;
+            double ms = consider(c);
+            if (t == 1) r.seq_ms = ms;
+            r.threads.push_back(t);
+            r.threads_ms.push_back(ms);
+        }
+        if (r.best.threads <= 1) return r;       // параллельно не выгодно: schedule не важен
+
+        // 2) schedule x chunk при лучшем числе потоков (куски не меньше 1K и не больше n)
+        int bestT = r.best.threads;
+        for (OmpSched s : {OmpSched::Static, OmpSched::Dynamic, OmpSched::Guided})
+            for (long long chunk : {1LL << 10, 1LL << 14, 1LL << 18}) {
+                if (chunk * 2 > n) continue;
+                c.threads = bestT;
+                c.sched = s;
+                c.chunk = chunk;
+                consider(c);
+            }
+
+        // 3) соседние числа потоков (не только степени двойки) с найденным schedule
+        OmpTuneConfig around = r.best;
+        for (int t : {bestT - 1, bestT + 1, bestT * 3 / 2}) {
+            if (t <= 1 || t > bench_max_threads() || t == bestT || (t == bestT * 3 / 2 && t == bestT + 1)) continue;
+            around.threads = t;
+            consider(around);
+        }
+
+        // 4) один поток ещё раз: первый замер размера бывает холоднее остальных
+        OmpTuneConfig seq;
+        seq.threads = 1;
+        r.seq_ms = std::min(r.seq_ms, consider(seq));
+        return r;
+    }
+
+    std::string path_;
+    std::string host_;
+    std::vector<Entry> entries_;
+};
@@ -0,0 +1,410 @@
+// par_hist.hpp
+// Распределение значений за один проход, без сортировки.
+//  - Histogram — целые ключи из небольшого диапазона [lo; hi] (в a1 это 1..100): счётчик
+//    на каждый ключ. min, max, mean, медиана, любые перцентили и мода читаются из счётчиков
+//    точно — медиана / p99 больше не требуют сортировки копии массива.
+//    Параллельно: у каждого потока свои счётчики (строка выровнена на 64 байта и дополнена
+//    строкой кэша — соседние потоки не делят строки), внутри потока — 4 чередующихся
+//    подгистограммы (повтор одного ключа не ждёт предыдущего инкремента той же ячейки),
+//    затем счётчики потоков сливаются деревом за log2(потоков) шагов с барьером.
+//    Быстрый путь SIMD для узких диапазонов (до 16 ключей, AVX-512): ключи и счётчики —
+//    в векторных регистрах, на каждый ключ сравнение + маскированное сложение, без записи
+//    в память на элемент (range10 в a1/hist_stats: ~1.2-1.3x к скалярному ядру). На AVX2
+//    (8 ключей, 16 регистров) так выходило медленнее скалярного — там его нет. Если ключи
+//    lo .. hi не помещаются в int (диапазон у INT_MAX / INT_MIN или шире) — скалярное ядро.
+//    Выбор ядра — stats_isa() из par_stats.hpp (PAR_STATS_ISA=scalar отключает быстрый путь).
+//  - QuantileSketch — для широких диапазонов и вещественных данных: логарифмические корзины
+//    (DDSketch): корзина i покрывает (g^(i-1); g^i], g = (1 + a) / (1 - a), a = 1% —
+//    любой перцентиль с относительной ошибкой не больше a. Размер фиксирован (|x| от 1e-9
+//    до 1e12, меньшие считаются нулём, большие — в крайнюю корзину), поэтому две оценки
+//    сливаются сложением счётчиков: между потоками — деревом, между процессами MPI —
+//    одной редукцией (quantile_sketch_mpi_type / _op в mpi_stats.hpp).
+//  - dist_build_par(a, n, lo, hi) — выбор сам: гистограмма, если ключей [lo; hi] не больше
+//    HIST_MAX_BINS, иначе скетч по элементам диапазона (hist_build* на таком диапазоне
+//    бросают length_error, а не выделяют 2^32 счётчиков на поток).
+// Перцентиль q — элемент с номером floor(q * (n - 1)) отсортированного массива;
+// медиана при чётном n — среднее двух средних элементов.
+#pragma once
+
+#include <algorithm>   // min, max, fill
+#include <cmath>       // log, pow, ceil, fabs
+#include <cstdint>
+#include <limits>
+#include <stdexcept>   // length_error
+#include <type_traits>
+#include <vector>
+
+#include "numa_alloc.hpp"  // numa_alloc_array: счётчики потоков, выровненные на 64 байта
+#include "par_stats.hpp"   // stats_isa, PAR_STATS_X86, <immintrin.h>, <omp.h>
+
+const long long HIST_MAX_BINS = 1 << 20;   // шире — QuantileSketch (dist_build_par), hist_build* — исключение
+
+// ==================== ГИСТОГРАММА ====================
+
+struct Histogram {
+    long long lo = 0;                 // ключ counts[0]
+    std::vector<long long> counts;    // counts[k] — сколько раз встретилось lo + k
+    long long n = 0;                  // элементов в диапазоне
+    long long outside = 0;            // элементов вне [lo; lo + bins) (в статистику не входят)
+
+    long long bins() const { return (long long)counts.size(); }
+
+    long long min() const {
+        for (long long k = 0; k < bins(); k++)
+            if (counts[k]) return lo + k;
+        return 0;
+    }
+    long long max() const {
+        for (long long k = bins(); k-- > 0;)
+            if (counts[k]) return lo + k;
+        return 0;
+    }
+    double mean() const {
+        if (n == 0) return 0.0;
+        long double s = 0;
+        for (long long k = 0; k < bins(); k++) s += (long double)counts[k] * (long double)k;
+        return (double)(s / (long double)n) + (double)lo;
+    }
+    // Значение элемента с номером r (0 .. n-1) в отсортированном порядке
+    long long at_rank(long long r) const {
+        long long c = 0;
+        for (long long k = 0; k < bins(); k++) {
+            c += counts[k];
+            if (c > r) return lo + k;
+        }
+        return max();
+    }
+    long long percentile(double q) const {
+        if (n == 0) return 0;
+        q = std::min(1.0, std::max(0.0, q));
+        return at_rank((long long)(q * (double)(n - 1)));
+    }
+    double median() const {
+        if (n == 0) return 0.0;
+        return 0.5 * (double)(at_rank((n - 1) / 2) + at_rank(n / 2));
+    }
+    // Самый частый ключ (при равенстве — меньший)
+    long long mode() const {
+        if (counts.empty()) return lo;
+        long long best = 0;
+        for (long long k = 1; k < bins(); k++)
+            if (counts[k] > counts[best]) best = k;
+        return lo + best;
+    }
+
+    // Слияние гистограмм одного диапазона
+    void merge(const Histogram& o) {
+        for (long long k = 0; k < bins() && k < o.bins(); k++) counts[k] += o.counts[k];
+        n += o.n;
+        outside += o.outside;
+    }
+};
+
+// ---------- ядра одного потока: в cnt[0 .. bins) добавляются счётчики куска ----------
+
+// Скалярное: 4 подгистограммы sub[4 * stride] (чередуются по элементам), затем сумма в cnt
+template <typename T>
+inline long long hist_kernel_scalar(const T* a, long long n, long long lo, long long bins,
+                                    long long* cnt, long long* sub, long long stride) {
+    std::fill(sub, sub + 4 * stride, 0LL);
+    const unsigned long long ub = (unsigned long long)bins;
+    long long i = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned long long k0 = (unsigned long long)((long long)a[i] - lo);
+        unsigned long long k1 = (unsigned long long)((long long)a[i + 1] - lo);
+        unsigned long long k2 = (unsigned long long)((long long)a[i + 2] - lo);
+        unsigned long long k3 = (unsigned long long)((long long)a[i + 3] - lo);
+        if (k0 < ub) sub[k0]++;
+        if (k1 < ub) sub[stride + k1]++;
+        if (k2 < ub) sub[2 * stride + k2]++;
+        if (k3 < ub) sub[3 * stride + k3]++;
+    }
+    for (; i < n; i++) {
+        unsigned long long k = (unsigned long long)((long long)a[i] - lo);
+        if (k < ub) sub[k]++;
+    }
+    long long in = 0;
+    for (long long k = 0; k < bins; k++) {
+        long long c = sub[k] + sub[stride + k] + sub[2 * stride + k] + sub[3 * stride + k];
+        cnt[k] += c;
+        in += c;
+    }
+    return in;                         // сколько попало в диапазон
+}
+
+#if PAR_STATS_X86
+
+// Счётчики дорожек int32: блок по 2^28 элементов — даже сумма всех дорожек помещается в int32
+const long long HIST_SIMD_BLOCK = 1LL << 28;
+
+// AVX-512: ключи lo .. lo+bins-1 в регистрах, K векторов счётчиков (по 16 дорожек),
+// K = 4 / 8 / 16 — наименьшее >= bins (лишних сравнений на элемент нет). Ключи k >= bins
+// повторяют lo: их счётчики не суммируются. Вызывающий гарантирует lo + bins - 1 <= INT_MAX
+template <int K>
+__attribute__((target("avx512f")))
+inline long long hist_kernel_avx512(const int* a, long long n, long long lo, long long bins, long long* cnt) {
+    long long in = 0, i = 0;
+    const __m512i one = _mm512_set1_epi32(1);
+    __m512i key[K];
+    for (int k = 0; k < K; k++) key[k] = _mm512_set1_epi32((int)(k < bins ? lo + k : lo));
+    while (i + 16 <= n) {
+        __m512i acc[K];
+        for (int k = 0; k < K; k++) acc[k] = _mm512_setzero_si512();
+        long long end = std::min(n, i + HIST_SIMD_BLOCK);
+        for (; i + 16 <= end; i += 16) {
+            __m512i v = _mm512_loadu_si512((const void*)(a + i));
+            for (int k = 0; k < K; k++)
+                acc[k] = _mm512_mask_add_epi32(acc[k], _mm512_cmpeq_epi32_mask(v, key[k]), acc[k], one);
+        }
+        for (int k = 0; k < bins; k++) {
+            alignas(64) uint32_t lanes[16];
+            _mm512_store_si512((void*)lanes, acc[k]);
+            long long c = 0;
+            for (int l = 0; l < 16; l++) c += lanes[l];
+            cnt[k] += c;
+            in += c;
+        }
+    }
+    for (; i < n; i++) {
+        long long k = (long long)a[i] - lo;               // в long long: без переполнения у INT_MIN / INT_MAX
+        if (k >= 0 && k < bins) { cnt[k]++; in++; }
+    }
+    return in;
+}
+
+#endif // PAR_STATS_X86
+
+// Ядро для куска: SIMD, если тип int, ключей не больше ширины быстрого пути
+// и все ключи lo .. lo+bins-1 представимы в int (иначе сравнение с lo+k неверно)
+template <typename T>
+inline long long hist_block(const T* a, long long n, long long lo, long long bins,
+                            long long* cnt, long long* sub, long long stride) {
+#if PAR_STATS_X86
+    if constexpr (std::is_same_v<T, int>) {
+        const long long imin = std::numeric_limits<int>::min(), imax = std::numeric_limits<int>::max();
+        if (stats_isa() == StatsIsa::Avx512 && bins >= 1 && bins <= 16 && lo >= imin && lo + bins - 1 <= imax) {
+            if (bins <= 4) return hist_kernel_avx512<4>(a, n, lo, bins, cnt);
+            if (bins <= 8) return hist_kernel_avx512<8>(a, n, lo, bins, cnt);
+            return hist_kernel_avx512<16>(a, n, lo, bins, cnt);
+        }
+    }
+#endif
+    return hist_kernel_scalar(a, n, lo, bins, cnt, sub, stride);
+}
+
+// Строка счётчиков потока: кратна строке кэша (8 x long long) плюс ещё одна строка
+inline long long hist_stride(long long bins) { return (bins + 7) / 8 * 8 + 8; }
+
+// Диапазон шире HIST_MAX_BINS — счётчиков по потокам не выделяем (для [INT_MIN; INT_MAX] это 32 ГБ на поток)
+inline void hist_check_range(long long lo, long long hi) {
+    if (hi >= lo && hi - lo + 1 > HIST_MAX_BINS)
+        throw std::length_error("par_hist: range wider than HIST_MAX_BINS, use dist_build_par / sketch_build_par");
+}
+
+// Один поток
+template <typename T>
+inline Histogram hist_build(const T* a, long long n, long long lo, long long hi) {
+    hist_check_range(lo, hi);
+    Histogram h;
+    h.lo = lo;
+    h.counts.assign((size_t)std::max(0LL, hi - lo + 1), 0);
+    long long stride = hist_stride(h.bins());
+    std::vector<long long> sub((size_t)(4 * stride));
+    h.n = hist_block(a, n, lo, h.bins(), h.counts.data(), sub.data(), stride);
+    h.outside = n - h.n;
+    return h;
+}
+
+// Параллельно: счётчики по потокам (выровнены, с отступом), слияние деревом
+template <typename T>
+inline Histogram hist_build_par(const T* a, long long n, long long lo, long long hi) {
+    hist_check_range(lo, hi);
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt <= 1 || n < 65536) return hist_build(a, n, lo, hi);
+    Histogram h;
+    h.lo = lo;
+    long long bins = std::max(0LL, hi - lo + 1), stride = hist_stride(bins);
+    // priv[t] — счётчики потока t, sub[t] — его 4 подгистограммы (только скалярное ядро)
+    long long* priv = numa_alloc_array<long long>((size_t)(nt * stride));
+    std::vector<long long> inCnt((size_t)nt * 8, 0);      // по строке кэша на поток
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = omp_get_thread_num(), used = omp_get_num_threads();
+        long long* mine = priv + (long long)t * stride;
+        std::fill(mine, mine + stride, 0LL);
+        std::vector<long long> sub((size_t)(4 * stride));
+        long long b = n * t / used, e = n * (t + 1) / used;
+        inCnt[(size_t)t * 8] = hist_block(a + b, e - b, lo, bins, mine, sub.data(), stride);
+        // дерево: на шаге s поток t (кратный 2s) забирает счётчики потока t + s
+        for (int s = 1; s < used; s *= 2) {
+            #pragma omp barrier
+            if (t % (2 * s) == 0 && t + s < used) {
+                const long long* other = priv + (long long)(t + s) * stride;
+                #pragma omp simd
+                for (long long k = 0; k < bins; k++) mine[k] += other[k];
+                inCnt[(size_t)t * 8] += inCnt[(size_t)(t + s) * 8];
+            }
+        }
+    }
+    h.counts.assign(priv, priv + bins);
+    h.n = inCnt[0];
+    h.outside = n - h.n;
+    numa_free(priv, (size_t)(nt * stride));
+    return h;
+#else
+    return hist_build(a, n, lo, hi);
+#endif
+}
+
+// ==================== КВАНТИЛЬНЫЙ СКЕТЧ ====================
+
+struct QuantileSketch {
+    static constexpr double ALPHA = 0.01;          // относительная ошибка перцентиля
+    static constexpr double MIN_ABS = 1e-9;        // |x| меньше — ноль
+    static constexpr int MIN_INDEX = -1040;        // ceil(log_g(1e-9)) = -1036, с запасом
+    static constexpr int BINS = 2432;              // до ceil(log_g(1e12)) = 1382
+
+    long long n = 0;
+    long long zero = 0;                            // |x| < MIN_ABS
+    double sum = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    long long pos[BINS] = {};                      // x > 0
+    long long neg[BINS] = {};                      // x < 0, по |x|
+
+    static double gamma() { return (1.0 + ALPHA) / (1.0 - ALPHA); }
+    static double inv_log_gamma() {
+        static const double v = 1.0 / std::log(gamma());
+        return v;
+    }
+    // Номер корзины для |x| >= MIN_ABS (с обрезкой по краям)
+    static int index(double ax, double invLg) {
+        int i = (int)std::ceil(std::log(ax) * invLg) - MIN_INDEX;
+        return std::min(BINS - 1, std::max(0, i));
+    }
+    // Представитель корзины: середина (g^(i-1); g^i] по относительной ошибке
+    static double value(int bin) {
+        double g = gamma();
+        return 2.0 * std::pow(g, bin + MIN_INDEX) / (1.0 + g);
+    }
+
+    void add(double x, double invLg = inv_log_gamma()) {
+        n++;
+        sum += x;
+        min = std::min(min, x);
+        max = std::max(max, x);
+        double ax = std::fabs(x);
+        if (ax < MIN_ABS) zero++;
+        else if (x > 0) pos[index(ax, invLg)]++;
+        else neg[index(ax, invLg)]++;
+    }
+
+    void merge(const QuantileSketch& o) {
+        n += o.n;
+        zero += o.zero;
+        sum += o.sum;
+        min = std::min(min, o.min);
+        max = std::max(max, o.max);
+        for (int k = 0; k < BINS; k++) {
+            pos[k] += o.pos[k];
+            neg[k] += o.neg[k];
+        }
+    }
+
+    double mean() const { return n ? sum / (double)n : 0.0; }
+
+    // Перцентиль q: обход от самых отрицательных (neg по убыванию |x|) через ноль к pos
+    double quantile(double q) const {
+        if (n == 0) return std::numeric_limits<double>::quiet_NaN();
+        q = std::min(1.0, std::max(0.0, q));
+        long long r = (long long)(q * (double)(n - 1)), c = 0;
+        double v = max;
+        for (int k = BINS - 1; k >= 0 && c <= r; k--)
+            if ((c += neg[k]) > r) v = -value(k);
+        if (c <= r && (c += zero) > r) v = 0.0;
+        for (int k = 0; k < BINS && c <= r; k++)
+            if ((c += pos[k]) > r) v = value(k);
+        return std::min(max, std::max(min, v));
+    }
+    double median() const { return quantile(0.5); }
+};
+
+const double SKETCH_ALL = std::numeric_limits<double>::infinity();
+
+// Элементы куска в скетч; с [lo; hi] — только попавшие в диапазон (как у гистограммы)
+template <typename T>
+inline void sketch_add_block(QuantileSketch& s, const T* a, long long n,
+                             double lo = -SKETCH_ALL, double hi = SKETCH_ALL) {
+    double invLg = QuantileSketch::inv_log_gamma();
+    if (lo == -SKETCH_ALL && hi == SKETCH_ALL) {
+        for (long long i = 0; i < n; i++) s.add((double)a[i], invLg);
+        return;
+    }
+    for (long long i = 0; i < n; i++) {
+        double x = (double)a[i];
+        if (x >= lo && x <= hi) s.add(x, invLg);
+    }
+}
+
+// Один поток
+template <typename T>
+inline QuantileSketch sketch_build(const T* a, long long n, double lo = -SKETCH_ALL, double hi = SKETCH_ALL) {
+    QuantileSketch s;
+    sketch_add_block(s, a, n, lo, hi);
+    return s;
+}
+
+// Параллельно: скетч на поток (~40 КБ), слияние деревом, как у гистограммы
+template <typename T>
+inline QuantileSketch sketch_build_par(const T* a, long long n, double lo = -SKETCH_ALL, double hi = SKETCH_ALL) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt > 1 && n >= 65536) {
+        std::vector<QuantileSketch> part((size_t)nt);
+        #pragma omp parallel num_threads(nt)
+        {
+            int t = omp_get_thread_num(), used = omp_get_num_threads();
+            long long b = n * t / used, e = n * (t + 1) / used;
+            sketch_add_block(part[(size_t)t], a + b, e - b, lo, hi);
+            for (int s = 1; s < used; s *= 2) {
+                #pragma omp barrier
+                if (t % (2 * s) == 0 && t + s < used) part[(size_t)t].merge(part[(size_t)(t + s)]);
+            }
+        }
+        return part[0];
+    }
+#endif
+    return sketch_build(a, n, lo, hi);
+}
+
+// ==================== ГИСТОГРАММА ИЛИ СКЕТЧ ====================
+
+// Распределение элементов из [lo; hi]: точная гистограмма, если ключей не больше
+// HIST_MAX_BINS, иначе квантильный скетч (перцентили с относительной ошибкой ALPHA)
+struct Distribution {
+    bool exact = false;              // true — hist, false — sketch
+    Histogram hist;
+    QuantileSketch sketch;
+    long long outside = 0;           // элементов вне [lo; hi]
+
+    long long count() const { return exact ? hist.n : sketch.n; }
+    double min() const { return exact ? (double)hist.min() : sketch.min; }
+    double max() const { return exact ? (double)hist.max() : sketch.max; }
+    double mean() const { return exact ? hist.mean() : sketch.mean(); }
+    double quantile(double q) const { return exact ? (double)hist.percentile(q) : sketch.quantile(q); }
+    double median() const { return exact ? hist.median() : sketch.median(); }
+};
+
+template <typename T>
+inline Distribution dist_build_par(const T* a, long long n, long long lo, long long hi) {
+    Distribution d;
+    d.exact = hi < lo || hi - lo + 1 <= HIST_MAX_BINS;
+    if (d.exact) {
+        d.hist = hist_build_par(a, n, lo, hi);
+    } else {
+        d.sketch = sketch_build_par(a, n, (double)lo, (double)hi);
+    }
+    d.outside = n - d.count();
+    return d;
+}
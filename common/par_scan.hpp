@@ -0,0 +1,390 @@
+// par_scan.hpp
+// Префиксные суммы (scan) на CPU и алгоритмы поверх них — CPU-аналог
+// scan_block_exclusive + add_block_offsets из a4/task2 и p7/task2.
+// Схема reduce-then-scan (один барьер):
+//   1) каждый поток суммирует свой непрерывный кусок (как schedule(static));
+//   2) смещение куска = сумма кусков левее (потоков мало — считает каждый сам);
+//   3) каждый поток сканирует свой кусок, начиная со смещения.
+// Вход читается два раза, выход пишется один раз; in == out допустимо (in-place):
+// на шаге 1 только чтение, на шаге 3 поток читает и пишет лишь свой кусок.
+// Скан внутри куска для int / float — SIMD: префикс в регистре за log2(ширины)
+// сдвигов со сложением (как up-sweep Блеллоха, но внутри одного вектора) и перенос
+// последней дорожки в следующий вектор. Ядро AVX-512 / AVX2 / скалярное выбирается
+// так же, как в par_stats.hpp (stats_isa(), переменная PAR_STATS_ISA).
+// У float порядок сложений отличается от последовательного — результат совпадает
+// с ним с точностью до округления.
+//
+// Поверх скана:
+//  - segmented — head[i] != 0 начинает новый сегмент (сумма сбрасывается);
+//  - compact — оставить элементы с pred(x) (stream compaction / filter), порядок сохраняется;
+//  - stable_partition — сначала все pred(x), потом остальные, порядок внутри групп сохраняется.
+// У compact / stable_partition скан идёт по счётчикам кусков, массив флагов не строится:
+// pred вызывается дважды на элемент (подсчёт и запись), поэтому должен быть чистой функцией.
+#pragma once
+
+#include <cstdint>     // uint8_t
+#include <type_traits> // is_same_v
+#include <vector>      // частичные суммы потоков
+
+#include "par_stats.hpp"  // stats_isa(), StatsIsa, PAR_STATS_X86 (+ omp.h, immintrin.h)
+
+// Меньше — без потоков (накладные расходы на запуск команды больше самого скана)
+const long long SCAN_PAR_MIN = 1 << 15;
+
+// ==================== СКАЛЯРНЫЕ ЯДРА ====================
+
+// Скан куска [0; n) начиная с carry; возвращает carry + сумму куска
+template <typename T>
+inline T scan_kernel_scalar(const T* in, T* out, long long n, T carry, bool inclusive) {
+    if (inclusive) {
+        for (long long i = 0; i < n; ++i) { carry += in[i]; out[i] = carry; }
+    } else {
+        for (long long i = 0; i < n; ++i) { T x = in[i]; out[i] = carry; carry += x; }
+    }
+    return carry;
+}
+
+// Сумма куска: 8 независимых накопителей (векторизуется и без -ffast-math)
+template <typename T>
+inline T scan_reduce(const T* in, long long n) {
+    T acc[8] = {};
+    long long i = 0;
+    for (; i + 8 <= n; i += 8)
+        for (int k = 0; k < 8; ++k) acc[k] += in[i + k];
+    T s = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    for (; i < n; ++i) s += in[i];
+    return s;
+}
+
+// ==================== SIMD-ЯДРА ====================
+#if PAR_STATS_X86
+
+// AVX-512, 16 дорожек: x += x<<1, x<<2, x<<4, x<<8 (сдвиг на дорожки через alignr с нулём)
+__attribute__((target("avx512f")))
+inline int scan_kernel_avx512(const int* in, int* out, long long n, int carry, bool inclusive) {
+    const __m512i z = _mm512_setzero_si512();
+    const __m512i last = _mm512_set1_epi32(15);
+    __m512i c = _mm512_set1_epi32(carry);
+    long long i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i x = _mm512_loadu_si512((const void*)(in + i));
+        x = _mm512_add_epi32(x, _mm512_maskz_alignr_epi32(0xFFFF, x, z, 15));
+        x = _mm512_add_epi32(x, _mm512_maskz_alignr_epi32(0xFFFF, x, z, 14));
+        x = _mm512_add_epi32(x, _mm512_maskz_alignr_epi32(0xFFFF, x, z, 12));
+        x = _mm512_add_epi32(x, _mm512_maskz_alignr_epi32(0xFFFF, x, z, 8));
+        __m512i r = inclusive ? x : _mm512_maskz_alignr_epi32(0xFFFF, x, z, 15);   // exclusive — сдвиг на 1
+        _mm512_storeu_si512((void*)(out + i), _mm512_add_epi32(r, c));
+        c = _mm512_add_epi32(c, _mm512_maskz_permutexvar_epi32(0xFFFF, last, x));  // + сумма вектора
+    }
+    return scan_kernel_scalar(in + i, out + i, n - i, _mm512_cvtsi512_si32(c), inclusive);
+}
+
+__attribute__((target("avx512f")))
+inline float scan_kernel_avx512(const float* in, float* out, long long n, float carry, bool inclusive) {
+    const __m512i z = _mm512_setzero_si512();
+    const __m512i last = _mm512_set1_epi32(15);
+    __m512 c = _mm512_set1_ps(carry);
+    long long i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x = _mm512_loadu_ps(in + i);
+        __m512i xi;
+        xi = _mm512_castps_si512(x);
+        x = _mm512_add_ps(x, _mm512_castsi512_ps(_mm512_maskz_alignr_epi32(0xFFFF, xi, z, 15)));
+        xi = _mm512_castps_si512(x);
+        x = _mm512_add_ps(x, _mm512_castsi512_ps(_mm512_maskz_alignr_epi32(0xFFFF, xi, z, 14)));
+        xi = _mm512_castps_si512(x);
+        x = _mm512_add_ps(x, _mm512_castsi512_ps(_mm512_maskz_alignr_epi32(0xFFFF, xi, z, 12)));
+        xi = _mm512_castps_si512(x);
+        x = _mm512_add_ps(x, _mm512_castsi512_ps(_mm512_maskz_alignr_epi32(0xFFFF, xi, z, 8)));
+        __m512 r = inclusive ? x : _mm512_castsi512_ps(_mm512_maskz_alignr_epi32(0xFFFF, _mm512_castps_si512(x), z, 15));
+        _mm512_storeu_ps(out + i, _mm512_add_ps(r, c));
+        c = _mm512_add_ps(c, _mm512_maskz_permutexvar_ps(0xFFFF, last, x));
+    }
+    return scan_kernel_scalar(in + i, out + i, n - i, _mm512_cvtss_f32(c), inclusive);
+}
+
+// AVX2, 8 дорожек: сдвиги внутри 128-битных половин, потом сумма нижней половины
+// добавляется к верхней; сдвиг на дорожку через половины — permutevar8x32 + blend с нулём
+__attribute__((target("avx2")))
+inline __m256i scan_avx2_prefix(__m256i x) {
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    __m256i t = _mm256_shuffle_epi32(x, 0xFF);           // дорожка 3 каждой половины
+    t = _mm256_permute2x128_si256(t, t, 0x08);           // нижняя -> верхняя, нижняя = 0
+    return _mm256_add_epi32(x, t);
+}
+
+__attribute__((target("avx2")))
+inline __m256i scan_avx2_shift1(__m256i x) {
+    const __m256i idx = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x, idx), _mm256_setzero_si256(), 1);
+}
+
+__attribute__((target("avx2")))
+inline int scan_kernel_avx2(const int* in, int* out, long long n, int carry, bool inclusive) {
+    const __m256i last = _mm256_set1_epi32(7);
+    __m256i c = _mm256_set1_epi32(carry);
+    long long i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = scan_avx2_prefix(_mm256_loadu_si256((const __m256i*)(in + i)));
+        __m256i r = inclusive ? x : scan_avx2_shift1(x);
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_add_epi32(r, c));
+        c = _mm256_add_epi32(c, _mm256_permutevar8x32_epi32(x, last));
+    }
+    return scan_kernel_scalar(in + i, out + i, n - i, _mm256_cvtsi256_si32(c), inclusive);
+}
+
+__attribute__((target("avx2")))
+inline float scan_kernel_avx2(const float* in, float* out, long long n, float carry, bool inclusive) {
+    const __m256i last = _mm256_set1_epi32(7);
+    const __m256 z = _mm256_setzero_ps();
+    __m256 c = _mm256_set1_ps(carry);
+    long long i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+        __m256 t = _mm256_permute_ps(x, 0xFF);
+        t = _mm256_permute2f128_ps(t, t, 0x08);
+        x = _mm256_add_ps(x, t);
+        __m256 r = inclusive ? x : _mm256_blend_ps(_mm256_permutevar8x32_ps(x, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6)), z, 1);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(r, c));
+        c = _mm256_add_ps(c, _mm256_permutevar8x32_ps(x, last));
+    }
+    return scan_kernel_scalar(in + i, out + i, n - i, _mm256_cvtss_f32(c), inclusive);
+}
+
+#endif // PAR_STATS_X86
+
+// Один поток, один кусок: SIMD для int / float, иначе скалярно
+template <typename T>
+inline T scan_block(const T* in, T* out, long long n, T carry, bool inclusive) {
+#if PAR_STATS_X86
+    if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+        StatsIsa isa = stats_isa();
+        if (isa == StatsIsa::Avx512) return scan_kernel_avx512(in, out, n, carry, inclusive);
+        if (isa == StatsIsa::Avx2) return scan_kernel_avx2(in, out, n, carry, inclusive);
+    }
+#endif
+    return scan_kernel_scalar(in, out, n, carry, inclusive);
+}
+
+// ==================== REDUCE-THEN-SCAN ====================
+
+// Границы куска потока t из used (как schedule(static) в compute_stats_par)
+inline void scan_chunk(long long n, int t, int used, long long& lo, long long& hi) {
+    lo = n * t / used;
+    hi = n * (t + 1) / used;
+}
+
+// Возвращает init + сумму всего массива
+template <typename T>
+inline T scan_par_impl(const T* in, T* out, long long n, T init, bool inclusive) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt > 1 && n >= SCAN_PAR_MIN) {
+        std::vector<T> part(nt);
+        T total = init;
+        #pragma omp parallel num_threads(nt)
+        {
+            int t = omp_get_thread_num();
+            int used = omp_get_num_threads();
+            long long lo, hi;
+            scan_chunk(n, t, used, lo, hi);
+            part[t] = scan_reduce(in + lo, hi - lo);
+            #pragma omp barrier
+            T off = init;
+            for (int s = 0; s < t; ++s) off += part[s];
+            T end = scan_block(in + lo, out + lo, hi - lo, off, inclusive);
+            if (t == used - 1) total = end;
+        }
+        return total;
+    }
+#endif
+    return scan_block(in, out, n, init, inclusive);
+}
+
+// ==================== ПУБЛИЧНЫЙ ИНТЕРФЕЙС: SCAN ====================
+// Все функции возвращают сумму всего массива (+ init): удобно для размера
+// результата compaction / смещений следующего уровня.
+
+// out[i] = init + in[0] + ... + in[i - 1]; один поток (SIMD)
+template <typename T>
+inline T scan_exclusive(const T* in, T* out, long long n, T init = T()) {
+    return scan_block(in, out, n, init, false);
+}
+
+// out[i] = in[0] + ... + in[i]; один поток (SIMD)
+template <typename T>
+inline T scan_inclusive(const T* in, T* out, long long n) {
+    return scan_block(in, out, n, T(), true);
+}
+
+// То же на всех потоках OpenMP
+template <typename T>
+inline T scan_exclusive_par(const T* in, T* out, long long n, T init = T()) {
+    return scan_par_impl(in, out, n, init, false);
+}
+
+template <typename T>
+inline T scan_inclusive_par(const T* in, T* out, long long n) {
+    return scan_par_impl(in, out, n, T(), true);
+}
+
+// In-place: результат на месте входа
+template <typename T>
+inline T scan_exclusive_inplace_par(T* a, long long n, T init = T()) {
+    return scan_par_impl(a, a, n, init, false);
+}
+
+template <typename T>
+inline T scan_inclusive_inplace_par(T* a, long long n) {
+    return scan_par_impl(a, a, n, T(), true);
+}
+
+// ==================== СЕГМЕНТИРОВАННЫЙ SCAN ====================
+
+// Итог куска для сегментов: есть ли в нём начало сегмента и сумма после последнего начала
+template <typename T>
+struct SegCarry {
+    bool head = false;
+    T sum = T();
+};
+
+template <typename T>
+inline SegCarry<T> seg_reduce(const T* in, const uint8_t* head, long long n) {
+    SegCarry<T> c;
+    for (long long i = 0; i < n; ++i) {
+        if (head[i]) { c.head = true; c.sum = T(); }
+        c.sum += in[i];
+    }
+    return c;
+}
+
+// Скан куска с переносом carry; head сбрасывает сумму (без ветвления на элемент)
+template <typename T>
+inline void seg_scan_block(const T* in, const uint8_t* head, T* out, long long n, T carry, bool inclusive) {
+    for (long long i = 0; i < n; ++i) {
+        T x = in[i];
+        carry = head[i] ? T() : carry;
+        if (inclusive) { carry += x; out[i] = carry; }
+        else { out[i] = carry; carry += x; }
+    }
+}
+
+template <typename T>
+inline void seg_scan_par_impl(const T* in, const uint8_t* head, T* out, long long n, bool inclusive) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt > 1 && n >= SCAN_PAR_MIN) {
+        std::vector<SegCarry<T>> part(nt);
+        #pragma omp parallel num_threads(nt)
+        {
+            int t = omp_get_thread_num();
+            int used = omp_get_num_threads();
+            long long lo, hi;
+            scan_chunk(n, t, used, lo, hi);
+            part[t] = seg_reduce(in + lo, head + lo, hi - lo);
+            #pragma omp barrier
+            // перенос: суммы кусков левее, до ближайшего куска с началом сегмента
+            T carry = T();
+            for (int s = t - 1; s >= 0; --s) {
+                carry += part[s].sum;
+                if (part[s].head) break;
+            }
+            seg_scan_block(in + lo, head + lo, out + lo, hi - lo, carry, inclusive);
+        }
+        return;
+    }
+#endif
+    seg_scan_block(in, head, out, n, T(), inclusive);
+}
+
+// head[i] != 0 — с i начинается новый сегмент (head[0] можно не ставить)
+template <typename T>
+inline void scan_inclusive_segmented_par(const T* in, const uint8_t* head, T* out, long long n) {
+    seg_scan_par_impl(in, head, out, n, true);
+}
+
+template <typename T>
+inline void scan_exclusive_segmented_par(const T* in, const uint8_t* head, T* out, long long n) {
+    seg_scan_par_impl(in, head, out, n, false);
+}
+
+// ==================== COMPACTION / PARTITION ====================
+
+// out — не меньше n элементов (in != out). Возвращает число записанных
+template <typename T, typename Pred>
+inline long long compact_par(const T* in, long long n, Pred pred, T* out) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt > 1 && n >= SCAN_PAR_MIN) {
+        std::vector<long long> cnt(nt, 0);
+        long long total = 0;
+        #pragma omp parallel num_threads(nt)
+        {
+            int t = omp_get_thread_num();
+            int used = omp_get_num_threads();
+            long long lo, hi;
+            scan_chunk(n, t, used, lo, hi);
+            long long c = 0;
+            for (long long i = lo; i < hi; ++i) c += pred(in[i]) ? 1 : 0;
+            cnt[t] = c;
+            #pragma omp barrier
+            long long k = 0;
+            for (int s = 0; s < t; ++s) k += cnt[s];
+            for (long long i = lo; i < hi; ++i)
+                if (pred(in[i])) out[k++] = in[i];
+            if (t == used - 1) total = k;
+        }
+        return total;
+    }
+#endif
+    long long k = 0;
+    for (long long i = 0; i < n; ++i)
+        if (pred(in[i])) out[k++] = in[i];
+    return k;
+}
+
+// Устойчивое разбиение в out (n элементов, in != out): сначала pred(x) == true.
+// Возвращает число элементов первой группы
+template <typename T, typename Pred>
+inline long long stable_partition_par(const T* in, long long n, Pred pred, T* out) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt > 1 && n >= SCAN_PAR_MIN) {
+        std::vector<long long> cnt(nt, 0);
+        long long totalTrue = 0;
+        #pragma omp parallel num_threads(nt)
+        {
+            int t = omp_get_thread_num();
+            int used = omp_get_num_threads();
+            long long lo, hi;
+            scan_chunk(n, t, used, lo, hi);
+            long long c = 0;
+            for (long long i = lo; i < hi; ++i) c += pred(in[i]) ? 1 : 0;
+            cnt[t] = c;
+            #pragma omp barrier
+            // true — после true-элементов кусков левее; false — после всех true
+            // и false-элементов кусков левее (их lo - trueBefore)
+            long long trueBefore = 0, all = 0;
+            for (int s = 0; s < used; ++s) {
+                if (s < t) trueBefore += cnt[s];
+                all += cnt[s];
+            }
+            long long kt = trueBefore, kf = all + (lo - trueBefore);
+            for (long long i = lo; i < hi; ++i) {
+                if (pred(in[i])) out[kt++] = in[i];
+                else out[kf++] = in[i];
+            }
+            if (t == 0) totalTrue = all;
+        }
+        return totalTrue;
+    }
+#endif
+    long long k = compact_par(in, n, pred, out);
+    long long kf = k;
+    for (long long i = 0; i < n; ++i)
+        if (!pred(in[i])) out[kf++] = in[i];
+    return k;
+}
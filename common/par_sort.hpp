@@ -0,0 +1,107 @@
+// par_sort.hpp
+// Параллельная сортировка слиянием на CPU (OpenMP tasks).
+//  - листья (короткие куски) сортируются std::sort;
+//  - рекурсия по половинам порождает задачи;
+//  - слияние двух половин тоже параллельное: выход делится на равные
+//    куски по диагоналям merge-path (как mergePathPartition в a2/task4.cu),
+//    каждый кусок сливается независимо.
+// Буферы чередуются (ping-pong), поэтому лишнего копирования назад нет.
+#pragma once
+
+#include <algorithm> // sort, merge, copy
+#include <memory>    // unique_ptr под временный буфер
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Размер листа: меньше — сортируем std::sort целиком
+const long long MSORT_LEAF = 1 << 14;
+// Минимальный кусок слияния на одну задачу
+const long long MSORT_MERGE_GRAIN = 1 << 15;
+
+// Разбиение по диагонали merge-path:
+// сколько элементов из A попадёт в первые diag элементов результата.
+// При равенстве элементы A идут раньше (слияние устойчиво).
+template <typename T>
+inline long long merge_path_partition(const T* A, long long aCount,
+                                      const T* B, long long bCount, long long diag) {
+    long long lo = std::max(0LL, diag - bCount); // минимум элементов из A
+    long long hi = std::min(diag, aCount);       // максимум элементов из A
+    while (lo < hi) {
+        long long mid = (lo + hi) >> 1;
+        if (B[diag - mid - 1] < A[mid]) hi = mid; // A[mid] ещё рано брать
+        else lo = mid + 1;                       // A[mid] <= B[...] — берём
+    }
+    return lo;
+}
+
+// Слияние A и B в out. Если общий размер большой, выход режется на
+// равные по длине куски (диагонали), каждый кусок — отдельная задача.
+template <typename T>
+inline void merge_par(const T* A, long long aCount, const T* B, long long bCount, T* out) {
+    long long total = aCount + bCount;
+    long long parts = total / MSORT_MERGE_GRAIN;
+#ifdef _OPENMP
+    parts = std::min<long long>(parts, 4LL * omp_get_num_threads());
+#else
+    parts = 1;
+#endif
+    if (parts <= 1) {
+        std::merge(A, A + aCount, B, B + bCount, out);
+        return;
+    }
+    #pragma omp taskloop grainsize(1)
+    for (long long p = 0; p < parts; ++p) {
+        long long d0 = total * p / parts;          // начало куска на выходе
+        long long d1 = total * (p + 1) / parts;    // конец куска на выходе
+        long long a0 = merge_path_partition(A, aCount, B, bCount, d0);
+        long long a1 = merge_path_partition(A, aCount, B, bCount, d1);
+        std::merge(A + a0, A + a1, B + (d0 - a0), B + (d1 - a1), out + d0);
+    }
+}
+
+// Сортирует a[0..n). Результат оказывается в b (toB=true) или в a (toB=false);
+// второй массив используется как рабочий буфер.
+template <typename T>
+inline void msort_rec(T* a, T* b, long long n, bool toB, bool par) {
+    if (n <= MSORT_LEAF) {
+        std::sort(a, a + n);
+        if (toB) std::copy(a, a + n, b);
+        return;
+    }
+    long long mid = n / 2;
+    // Половины сортируем в "другой" буфер, чтобы слить их в нужный
+    if (par) {
+        #pragma omp task
+        msort_rec(a, b, mid, !toB, par);
+        #pragma omp task
+        msort_rec(a + mid, b + mid, n - mid, !toB, par);
+        #pragma omp taskwait
+    } else {
+        msort_rec(a, b, mid, !toB, par);
+        msort_rec(a + mid, b + mid, n - mid, !toB, par);
+    }
+    const T* src = toB ? a : b;
+    T* dst = toB ? b : a;
+    if (par) merge_par(src, mid, src + mid, n - mid, dst);
+    else std::merge(src, src + mid, src + mid, src + n, dst);
+}
+
+// Последовательная сортировка слиянием (та же схема, без задач)
+template <typename T>
+inline void merge_sort(T* a, long long n) {
+    if (n < 2) return;
+    std::unique_ptr<T[]> tmp(new T[n]);  // без обнуления — всё равно перезапишем
+    msort_rec(a, tmp.get(), n, false, false);
+}
+
+// Параллельная сортировка слиянием (OpenMP tasks + merge-path)
+template <typename T>
+inline void merge_sort_par(T* a, long long n) {
+    if (n < 2) return;
+    std::unique_ptr<T[]> tmp(new T[n]);
+    #pragma omp parallel
+    #pragma omp single nowait
+    msort_rec(a, tmp.get(), n, false, true);
+}
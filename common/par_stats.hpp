@@ -0,0 +1,494 @@
+// par_stats.hpp
+// Однопроходная статистика массива: sum, sumsq, min, max, argmin, argmax.
+// Данные читаются ОДИН раз (для 100M элементов задача упирается в память,
+// поэтому главный выигрыш — не проходить по массиву 2-3 раза).
+//
+// Ядра: AVX-512 / AVX2 / скалярное, выбираются во время выполнения
+// (__builtin_cpu_supports). Переопределить можно переменной окружения
+// PAR_STATS_ISA=scalar|avx2|avx512 (удобно для сравнения).
+// Параллельная версия делит массив на непрерывные куски, как schedule(static).
+#pragma once
+
+#include <cstdlib>     // getenv
+#include <cstring>     // strcmp
+#include <limits>      // numeric_limits
+#include <type_traits> // is_same_v, is_integral_v
+#include <vector>      // частичные результаты потоков
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PAR_STATS_X86 1
+#include <immintrin.h> // AVX2 / AVX-512 intrinsics
+#else
+#define PAR_STATS_X86 0
+#endif
+
+// Тип накопителя суммы: целые -> long long (точно), вещественные -> double
+template <typename T>
+using stats_acc_t = std::conditional_t<std::is_integral_v<T>, long long, double>;
+
+// Результат редукции
+template <typename T>
+struct Stats {
+    long long count = 0;                          // сколько элементов учтено
+    stats_acc_t<T> sum = 0;                       // сумма
+    double sumsq = 0.0;                           // сумма квадратов
+    T min = std::numeric_limits<T>::max();        // минимум
+    T max = std::numeric_limits<T>::lowest();     // максимум
+    long long argmin = -1;                        // индекс первого минимума
+    long long argmax = -1;                        // индекс первого максимума
+
+    double mean() const { return count ? (double)sum / (double)count : 0.0; }
+
+    // Дисперсия (генеральная): E[x^2] - (E[x])^2, отрицательный ноль отсекаем
+    double variance() const {
+        if (count == 0) return 0.0;
+        double m = mean();
+        double v = sumsq / (double)count - m * m;
+        return v < 0.0 ? 0.0 : v;
+    }
+};
+
+// Объединение двух частичных результатов (ассоциативно; при равенстве — меньший индекс)
+template <typename T>
+inline void stats_merge(Stats<T>& into, const Stats<T>& other) {
+    if (other.count == 0) return;
+    into.count += other.count;
+    into.sum += other.sum;
+    into.sumsq += other.sumsq;
+    if (into.argmin < 0 || other.min < into.min ||
+        (other.min == into.min && other.argmin < into.argmin)) {
+        into.min = other.min;
+        into.argmin = other.argmin;
+    }
+    if (into.argmax < 0 || other.max > into.max ||
+        (other.max == into.max && other.argmax < into.argmax)) {
+        into.max = other.max;
+        into.argmax = other.argmax;
+    }
+}
+
+// ==================== СКАЛЯРНОЕ ЯДРО ====================
+
+template <typename T>
+inline Stats<T> stats_kernel_scalar(const T* a, long long n, long long base) {
+    Stats<T> s;
+    if (n <= 0) return s;
+    stats_acc_t<T> sum = 0;
+    double sumsq = 0.0;
+    T mn = a[0], mx = a[0];
+    long long imn = 0, imx = 0;
+    for (long long i = 0; i < n; ++i) {
+        T x = a[i];
+        sum += x;
+        sumsq += (double)x * (double)x;
+        if (x < mn) { mn = x; imn = i; }           // строго меньше -> первый минимум
+        if (x > mx) { mx = x; imx = i; }
+    }
+    s.count = n;
+    s.sum = sum;
+    s.sumsq = sumsq;
+    s.min = mn;
+    s.max = mx;
+    s.argmin = base + imn;
+    s.argmax = base + imx;
+    return s;
+}
+
+#if PAR_STATS_X86
+
+// Сводим значения по SIMD-дорожкам в Stats (min/max с индексами)
+template <typename T, typename I>
+inline void stats_merge_lanes(Stats<T>& s, int W, const T* mn, const I* imn,
+                              const T* mx, const I* imx, long long base) {
+    for (int l = 0; l < W; ++l) {
+        Stats<T> lane;
+        lane.count = 1;                            // только чтобы merge не пропустил
+        lane.min = mn[l];
+        lane.argmin = base + (long long)imn[l];
+        lane.max = mx[l];
+        lane.argmax = base + (long long)imx[l];
+        long long c = s.count;
+        stats_merge(s, lane);
+        s.count = c;
+    }
+}
+
+// Дочитываем хвост скалярно и добавляем к результату
+template <typename T>
+inline void stats_add_tail(Stats<T>& s, const T* a, long long i, long long n, long long base) {
+    if (i < n) stats_merge(s, stats_kernel_scalar(a + i, n - i, base + i));
+}
+
+// ---------- AVX2 ----------
+
+__attribute__((target("avx2,fma")))
+inline Stats<double> stats_kernel_avx2(const double* a, long long n, long long base) {
+    const int W = 4;
+    if (n < W) return stats_kernel_scalar(a, n, base);
+    __m256d vsum = _mm256_setzero_pd(), vsq = _mm256_setzero_pd();
+    __m256d vmin = _mm256_loadu_pd(a), vmax = vmin;
+    __m256i idx = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256i imin = idx, imax = idx;
+    const __m256i step = _mm256_set1_epi64x(W);
+    long long i = 0;
+    for (; i + W <= n; i += W) {
+        __m256d x = _mm256_loadu_pd(a + i);
+        vsum = _mm256_add_pd(vsum, x);
+        vsq = _mm256_fmadd_pd(x, x, vsq);
+        __m256d lt = _mm256_cmp_pd(x, vmin, _CMP_LT_OQ);
+        __m256d gt = _mm256_cmp_pd(x, vmax, _CMP_GT_OQ);
+        vmin = _mm256_blendv_pd(vmin, x, lt);
+        vmax = _mm256_blendv_pd(vmax, x, gt);
+        imin = _mm256_blendv_epi8(imin, idx, _mm256_castpd_si256(lt));
+        imax = _mm256_blendv_epi8(imax, idx, _mm256_castpd_si256(gt));
+        idx = _mm256_add_epi64(idx, step);
+    }
+    alignas(32) double s1[W], s2[W], mn[W], mx[W];
+    alignas(32) long long imn[W], imx[W];
+    _mm256_store_pd(s1, vsum);
+    _mm256_store_pd(s2, vsq);
+    _mm256_store_pd(mn, vmin);
+    _mm256_store_pd(mx, vmax);
+    _mm256_store_si256((__m256i*)imn, imin);
+    _mm256_store_si256((__m256i*)imx, imax);
+    Stats<double> s;
+    s.count = i;
+    s.sum = (s1[0] + s1[1]) + (s1[2] + s1[3]);
+    s.sumsq = (s2[0] + s2[1]) + (s2[2] + s2[3]);
+    stats_merge_lanes(s, W, mn, imn, mx, imx, base);
+    stats_add_tail(s, a, i, n, base);
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+inline Stats<float> stats_kernel_avx2(const float* a, long long n, long long base) {
+    const int W = 8;
+    if (n < W) return stats_kernel_scalar(a, n, base);
+    __m256d vsum = _mm256_setzero_pd(), vsq = _mm256_setzero_pd(); // копим в double
+    __m256 vmin = _mm256_loadu_ps(a), vmax = vmin;
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i imin = idx, imax = idx;
+    const __m256i step = _mm256_set1_epi32(W);
+    long long i = 0;
+    for (; i + W <= n; i += W) {
+        __m256 x = _mm256_loadu_ps(a + i);
+        __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+        __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+        vsum = _mm256_add_pd(vsum, _mm256_add_pd(lo, hi));
+        vsq = _mm256_fmadd_pd(lo, lo, vsq);
+        vsq = _mm256_fmadd_pd(hi, hi, vsq);
+        __m256 lt = _mm256_cmp_ps(x, vmin, _CMP_LT_OQ);
+        __m256 gt = _mm256_cmp_ps(x, vmax, _CMP_GT_OQ);
+        vmin = _mm256_blendv_ps(vmin, x, lt);
+        vmax = _mm256_blendv_ps(vmax, x, gt);
+        imin = _mm256_blendv_epi8(imin, idx, _mm256_castps_si256(lt));
+        imax = _mm256_blendv_epi8(imax, idx, _mm256_castps_si256(gt));
+        idx = _mm256_add_epi32(idx, step);
+    }
+    alignas(32) double s1[4], s2[4];
+    alignas(32) float mn[W], mx[W];
+    alignas(32) int imn[W], imx[W];
+    _mm256_store_pd(s1, vsum);
+    _mm256_store_pd(s2, vsq);
+    _mm256_store_ps(mn, vmin);
+    _mm256_store_ps(mx, vmax);
+    _mm256_store_si256((__m256i*)imn, imin);
+    _mm256_store_si256((__m256i*)imx, imax);
+    Stats<float> s;
+    s.count = i;
+    s.sum = (s1[0] + s1[1]) + (s1[2] + s1[3]);
+    s.sumsq = (s2[0] + s2[1]) + (s2[2] + s2[3]);
+    stats_merge_lanes(s, W, mn, imn, mx, imx, base);
+    stats_add_tail(s, a, i, n, base);
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+inline Stats<int> stats_kernel_avx2(const int* a, long long n, long long base) {
+    const int W = 8;
+    if (n < W) return stats_kernel_scalar(a, n, base);
+    __m256i vsum = _mm256_setzero_si256();                  // 4 x int64
+    __m256d vsq = _mm256_setzero_pd();                      // 4 x double
+    __m256i vmin = _mm256_loadu_si256((const __m256i*)a), vmax = vmin;
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i imin = idx, imax = idx;
+    const __m256i step = _mm256_set1_epi32(W);
+    long long i = 0;
+    for (; i + W <= n; i += W) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m128i xlo = _mm256_castsi256_si128(x);
+        __m128i xhi = _mm256_extracti128_si256(x, 1);
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepi32_epi64(xlo));
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepi32_epi64(xhi));
+        __m256d dlo = _mm256_cvtepi32_pd(xlo);
+        __m256d dhi = _mm256_cvtepi32_pd(xhi);
+        vsq = _mm256_fmadd_pd(dlo, dlo, vsq);
+        vsq = _mm256_fmadd_pd(dhi, dhi, vsq);
+        __m256i lt = _mm256_cmpgt_epi32(vmin, x);
+        __m256i gt = _mm256_cmpgt_epi32(x, vmax);
+        vmin = _mm256_min_epi32(vmin, x);
+        vmax = _mm256_max_epi32(vmax, x);
+        imin = _mm256_blendv_epi8(imin, idx, lt);
+        imax = _mm256_blendv_epi8(imax, idx, gt);
+        idx = _mm256_add_epi32(idx, step);
+    }
+    alignas(32) long long s1[4];
+    alignas(32) double s2[4];
+    alignas(32) int mn[W], mx[W], imn[W], imx[W];
+    _mm256_store_si256((__m256i*)s1, vsum);
+    _mm256_store_pd(s2, vsq);
+    _mm256_store_si256((__m256i*)mn, vmin);
+    _mm256_store_si256((__m256i*)mx, vmax);
+    _mm256_store_si256((__m256i*)imn, imin);
+    _mm256_store_si256((__m256i*)imx, imax);
+    Stats<int> s;
+    s.count = i;
+    s.sum = s1[0] + s1[1] + s1[2] + s1[3];
+    s.sumsq = (s2[0] + s2[1]) + (s2[2] + s2[3]);
+    stats_merge_lanes(s, W, mn, imn, mx, imx, base);
+    stats_add_tail(s, a, i, n, base);
+    return s;
+}
+
+// ---------- AVX-512 ----------
+
+// GCC 12 ложно предупреждает о _mm512_undefined_* внутри своих intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// Горизонтальная сумма 8 дорожек фиксированным деревом (детерминированно)
+template <typename A>
+inline A stats_hsum8(const A* v) {
+    return ((v[0] + v[1]) + (v[2] + v[3])) + ((v[4] + v[5]) + (v[6] + v[7]));
+}
+
+__attribute__((target("avx512f")))
+inline Stats<double> stats_kernel_avx512(const double* a, long long n, long long base) {
+    const int W = 8;
+    if (n < W) return stats_kernel_scalar(a, n, base);
+    __m512d vsum = _mm512_setzero_pd(), vsq = _mm512_setzero_pd();
+    __m512d vmin = _mm512_loadu_pd(a), vmax = vmin;
+    __m512i idx = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i imin = idx, imax = idx;
+    const __m512i step = _mm512_set1_epi64(W);
+    long long i = 0;
+    for (; i + W <= n; i += W) {
+        __m512d x = _mm512_loadu_pd(a + i);
+        vsum = _mm512_add_pd(vsum, x);
+        vsq = _mm512_fmadd_pd(x, x, vsq);
+        __mmask8 lt = _mm512_cmp_pd_mask(x, vmin, _CMP_LT_OQ);
+        __mmask8 gt = _mm512_cmp_pd_mask(x, vmax, _CMP_GT_OQ);
+        vmin = _mm512_mask_blend_pd(lt, vmin, x);
+        vmax = _mm512_mask_blend_pd(gt, vmax, x);
+        imin = _mm512_mask_blend_epi64(lt, imin, idx);
+        imax = _mm512_mask_blend_epi64(gt, imax, idx);
+        idx = _mm512_add_epi64(idx, step);
+    }
+    alignas(64) double s1[W], s2[W], mn[W], mx[W];
+    alignas(64) long long imn[W], imx[W];
+    _mm512_store_pd(s1, vsum);
+    _mm512_store_pd(s2, vsq);
+    _mm512_store_pd(mn, vmin);
+    _mm512_store_pd(mx, vmax);
+    _mm512_store_si512(imn, imin);
+    _mm512_store_si512(imx, imax);
+    Stats<double> s;
+    s.count = i;
+    s.sum = stats_hsum8(s1);
+    s.sumsq = stats_hsum8(s2);
+    stats_merge_lanes(s, W, mn, imn, mx, imx, base);
+    stats_add_tail(s, a, i, n, base);
+    return s;
+}
+
+__attribute__((target("avx512f")))
+inline Stats<float> stats_kernel_avx512(const float* a, long long n, long long base) {
+    const int W = 16;
+    if (n < W) return stats_kernel_scalar(a, n, base);
+    __m512d vsum = _mm512_setzero_pd(), vsq = _mm512_setzero_pd(); // копим в double
+    __m512 vmin = _mm512_loadu_ps(a), vmax = vmin;
+    __m512i idx = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i imin = idx, imax = idx;
+    const __m512i step = _mm512_set1_epi32(W);
+    long long i = 0;
+    for (; i + W <= n; i += W) {
+        __m512 x = _mm512_loadu_ps(a + i);
+        __m512d lo = _mm512_cvtps_pd(_mm256_loadu_ps(a + i));      // половины читаем
+        __m512d hi = _mm512_cvtps_pd(_mm256_loadu_ps(a + i + 8));  // из той же строки кэша
+        vsum = _mm512_add_pd(vsum, _mm512_add_pd(lo, hi));
+        vsq = _mm512_fmadd_pd(lo, lo, vsq);
+        vsq = _mm512_fmadd_pd(hi, hi, vsq);
+        __mmask16 lt = _mm512_cmp_ps_mask(x, vmin, _CMP_LT_OQ);
+        __mmask16 gt = _mm512_cmp_ps_mask(x, vmax, _CMP_GT_OQ);
+        vmin = _mm512_mask_blend_ps(lt, vmin, x);
+        vmax = _mm512_mask_blend_ps(gt, vmax, x);
+        imin = _mm512_mask_blend_epi32(lt, imin, idx);
+        imax = _mm512_mask_blend_epi32(gt, imax, idx);
+        idx = _mm512_add_epi32(idx, step);
+    }
+    alignas(64) double s1[8], s2[8];
+    alignas(64) float mn[W], mx[W];
+    alignas(64) int imn[W], imx[W];
+    _mm512_store_pd(s1, vsum);
+    _mm512_store_pd(s2, vsq);
+    _mm512_store_ps(mn, vmin);
+    _mm512_store_ps(mx, vmax);
+    _mm512_store_si512(imn, imin);
+    _mm512_store_si512(imx, imax);
+    Stats<float> s;
+    s.count = i;
+    s.sum = stats_hsum8(s1);
+    s.sumsq = stats_hsum8(s2);
+    stats_merge_lanes(s, W, mn, imn, mx, imx, base);
+    stats_add_tail(s, a, i, n, base);
+    return s;
+}
+
+__attribute__((target("avx512f")))
+inline Stats<int> stats_kernel_avx512(const int* a, long long n, long long base) {
+    const int W = 16;
+    if (n < W) return stats_kernel_scalar(a, n, base);
+    __m512i vsum = _mm512_setzero_si512();                  // 8 x int64
+    __m512d vsq = _mm512_setzero_pd();                      // 8 x double
+    __m512i vmin = _mm512_loadu_si512(a), vmax = vmin;
+    __m512i idx = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i imin = idx, imax = idx;
+    const __m512i step = _mm512_set1_epi32(W);
+    long long i = 0;
+    for (; i + W <= n; i += W) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m256i xlo = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i xhi = _mm256_loadu_si256((const __m256i*)(a + i + 8));
+        vsum = _mm512_add_epi64(vsum, _mm512_cvtepi32_epi64(xlo));
+        vsum = _mm512_add_epi64(vsum, _mm512_cvtepi32_epi64(xhi));
+        __m512d dlo = _mm512_cvtepi32_pd(xlo);
+        __m512d dhi = _mm512_cvtepi32_pd(xhi);
+        vsq = _mm512_fmadd_pd(dlo, dlo, vsq);
+        vsq = _mm512_fmadd_pd(dhi, dhi, vsq);
+        __mmask16 lt = _mm512_cmplt_epi32_mask(x, vmin);
+        __mmask16 gt = _mm512_cmpgt_epi32_mask(x, vmax);
+        vmin = _mm512_min_epi32(vmin, x);
+        vmax = _mm512_max_epi32(vmax, x);
+        imin = _mm512_mask_blend_epi32(lt, imin, idx);
+        imax = _mm512_mask_blend_epi32(gt, imax, idx);
+        idx = _mm512_add_epi32(idx, step);
+    }
+    alignas(64) long long s1[8];
+    alignas(64) double s2[8];
+    alignas(64) int mn[W], mx[W], imn[W], imx[W];
+    _mm512_store_si512(s1, vsum);
+    _mm512_store_pd(s2, vsq);
+    _mm512_store_si512(mn, vmin);
+    _mm512_store_si512(mx, vmax);
+    _mm512_store_si512(imn, imin);
+    _mm512_store_si512(imx, imax);
+    Stats<int> s;
+    s.count = i;
+    s.sum = stats_hsum8(s1);
+    s.sumsq = stats_hsum8(s2);
+    stats_merge_lanes(s, W, mn, imn, mx, imx, base);
+    stats_add_tail(s, a, i, n, base);
+    return s;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // PAR_STATS_X86
+
+// ==================== ВЫБОР ЯДРА ====================
+
+enum class StatsIsa { Scalar, Avx2, Avx512 };
+
+inline const char* stats_isa_name(StatsIsa isa) {
+    switch (isa) {
+        case StatsIsa::Avx512: return "avx512";
+        case StatsIsa::Avx2:   return "avx2";
+        default:               return "scalar";
+    }
+}
+
+// Определяем набор инструкций один раз (с учётом PAR_STATS_ISA)
+inline StatsIsa stats_isa() {
+    static const StatsIsa isa = [] {
+        StatsIsa best = StatsIsa::Scalar;
+#if PAR_STATS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) best = StatsIsa::Avx512;
+        else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) best = StatsIsa::Avx2;
+#endif
+        const char* env = std::getenv("PAR_STATS_ISA");
+        if (env) {
+            // Понижать можно всегда, повышать — только если CPU поддерживает
+            if (std::strcmp(env, "scalar") == 0) best = StatsIsa::Scalar;
+            else if (std::strcmp(env, "avx2") == 0 && best == StatsIsa::Avx512) best = StatsIsa::Avx2;
+        }
+        return best;
+    }();
+    return isa;
+}
+
+// Один поток, один кусок [0; n) с глобальным смещением base
+template <typename T>
+inline Stats<T> stats_block(const T* a, long long n, long long base) {
+#if PAR_STATS_X86
+    constexpr bool simd = std::is_same_v<T, int> || std::is_same_v<T, float> ||
+                          std::is_same_v<T, double>;
+    if constexpr (simd) {
+        StatsIsa isa = stats_isa();
+        if (isa != StatsIsa::Scalar) {
+            // Индексы дорожек для int/float 32-битные — режем на блоки по 2^30
+            const long long BLOCK = 1LL << 30;
+            Stats<T> s;
+            for (long long off = 0; off < n; off += BLOCK) {
+                long long len = (n - off < BLOCK) ? (n - off) : BLOCK;
+                stats_merge(s, isa == StatsIsa::Avx512
+                                   ? stats_kernel_avx512(a + off, len, base + off)
+                                   : stats_kernel_avx2(a + off, len, base + off));
+            }
+            return s;
+        }
+    }
+#endif
+    return stats_kernel_scalar(a, n, base);
+}
+
+// ==================== ПУБЛИЧНЫЙ ИНТЕРФЕЙС ====================
+
+// Последовательно (один поток, но SIMD)
+template <typename T>
+inline Stats<T> compute_stats(const T* a, long long n) {
+    return stats_block(a, n, 0);
+}
+
+// Параллельно: каждый поток берёт непрерывный кусок (как schedule(static)),
+// частичные результаты объединяются в порядке номеров потоков —
+// поэтому при одинаковом числе потоков результат детерминирован.
+template <typename T>
+inline Stats<T> compute_stats_par(const T* a, long long n) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt <= 1 || n < 4096) return stats_block(a, n, 0); // мелкие массивы — без потоков
+    std::vector<Stats<T>> part(nt);
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = omp_get_thread_num();
+        int used = omp_get_num_threads();
+        long long lo = n * t / used;
+        long long hi = n * (t + 1) / used;
+        part[t] = stats_block(a + lo, hi - lo, lo);
+    }
+    Stats<T> s;
+    for (const auto& p : part) stats_merge(s, p);
+    return s;
+#else
+    return stats_block(a, n, 0);
+#endif
+}
@@ -0,0 +1,280 @@
+// perf_counters.hpp
+// Аппаратные счётчики (Linux perf_event_open) для участков кода, по потокам:
+//   cycles, instructions, LLC misses, branch misses, dTLB misses.
+//  - у каждого потока OpenMP свои файловые дескрипторы (открываются лениво,
+//    при первом замере в этом потоке; считается только user-space);
+//  - снимок (perf_snapshot) читает счётчики всех потоков команды внутри
+//    короткого parallel-региона, разность двух снимков — цена участка;
+//  - при мультиплексировании (событий больше, чем регистров PMU) значения
+//    масштабируются по time_enabled / time_running;
+//  - по умолчанию ВЫКЛЮЧЕНО: включается PERF_COUNTERS=1. Выключенный замер —
+//    это одна проверка статического bool; -DNO_PERF_COUNTERS убирает всё.
+// Если событие недоступно (виртуальная машина, perf_event_paranoid > 2),
+// в отчёте вместо значения -1, остальные события продолжают считаться.
+#pragma once
+
+#include <algorithm> // min
+#include <atomic>    // предупреждение один раз
+#include <cstdint>   // uint64_t
+#include <cstdlib>   // getenv
+#include <cstring>   // memset
+#include <iostream>  // предупреждение, отчёт
+#include <iomanip>   // setw
+#include <map>       // реестр участков
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__linux__) && !defined(NO_PERF_COUNTERS)
+#define PERF_COUNTERS_LINUX 1
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Номера событий
+enum PerfEvent { PERF_CYCLES, PERF_INSTR, PERF_LLC_MISS, PERF_BR_MISS, PERF_DTLB_MISS, PERF_NUM_EVENTS };
+
+inline const char* perf_event_name(int e) {
+    static const char* names[PERF_NUM_EVENTS] = {"cycles", "instructions", "llc_misses",
+                                                 "branch_misses", "dtlb_misses"};
+    return names[e];
+}
+
+// Значения счётчиков одного потока (или сумма по потокам); -1 — событие недоступно
+struct PerfValues {
+    double v[PERF_NUM_EVENTS];
+
+    PerfValues() { for (double& x : v) x = -1.0; }
+
+    bool valid(int e) const { return v[e] >= 0.0; }
+    double ipc() const {
+        return valid(PERF_CYCLES) && valid(PERF_INSTR) && v[PERF_CYCLES] > 0
+                   ? v[PERF_INSTR] / v[PERF_CYCLES] : -1.0;
+    }
+    void add(const PerfValues& o) {
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e)
+            if (o.valid(e)) v[e] = (valid(e) ? v[e] : 0.0) + o.v[e];
+    }
+    PerfValues scaled(double k) const {
+        PerfValues r = *this;
+        for (double& x : r.v) if (x >= 0.0) x *= k;
+        return r;
+    }
+};
+
+// Сырые показания одного потока: value, time_enabled, time_running по каждому событию
+struct PerfRaw {
+    long tid = -1;                       // какой поток ОС читал (в start и stop должен совпасть)
+    uint64_t val[PERF_NUM_EVENTS] = {};
+    uint64_t ena[PERF_NUM_EVENTS] = {};
+    uint64_t run[PERF_NUM_EVENTS] = {};
+    bool ok[PERF_NUM_EVENTS] = {};
+};
+
+// Разность двух показаний с масштабированием при мультиплексировании
+inline PerfValues perf_delta(const PerfRaw& a, const PerfRaw& b) {
+    PerfValues d;
+    if (a.tid != b.tid || a.tid < 0) return d;      // поток сменился — значение не годится
+    for (int e = 0; e < PERF_NUM_EVENTS; ++e) {
+        if (!a.ok[e] || !b.ok[e]) continue;
+        double dv = (double)(b.val[e] - a.val[e]);
+        double de = (double)(b.ena[e] - a.ena[e]);
+        double dr = (double)(b.run[e] - a.run[e]);
+        if (dr > 0.0 && dr < de) dv *= de / dr;     // событие работало не всё время
+        d.v[e] = dv;
+    }
+    return d;
+}
+
+// Включено ли измерение (PERF_COUNTERS=1); можно переключить из программы
+inline bool& perf_enabled_flag() {
+    static bool on = [] {
+        const char* env = std::getenv("PERF_COUNTERS");
+        return env && env[0] == '1';
+    }();
+    return on;
+}
+inline bool perf_enabled() {
+#ifdef PERF_COUNTERS_LINUX
+    return perf_enabled_flag();
+#else
+    return false;
+#endif
+}
+inline void perf_set_enabled(bool on) { perf_enabled_flag() = on; }
+
+#ifdef PERF_COUNTERS_LINUX
+
+// Счётчики текущего потока ОС
+class PerfThread {
+public:
+    PerfThread() {
+        tid_ = (long)syscall(SYS_gettid);
+        const uint64_t cache = PERF_TYPE_HW_CACHE;
+        // (тип, конфиг) для каждого события
+        const uint64_t cfg[PERF_NUM_EVENTS][2] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {cache, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        };
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = (uint32_t)cfg[e][0];
+            attr.config = cfg[e][1];
+            attr.exclude_kernel = 1;   // работает при perf_event_paranoid <= 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // pid = 0, cpu = -1: этот поток на любом ядре
+            fd_[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+    }
+    ~PerfThread() {
+        for (int fd : fd_) if (fd >= 0) close(fd);
+    }
+    PerfThread(const PerfThread&) = delete;
+    PerfThread& operator=(const PerfThread&) = delete;
+
+    bool any() const {
+        for (int fd : fd_) if (fd >= 0) return true;
+        return false;
+    }
+
+    void read_raw(PerfRaw& r) const {
+        r.tid = tid_;
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e) {
+            uint64_t buf[3];
+            r.ok[e] = fd_[e] >= 0 && ::read(fd_[e], buf, sizeof(buf)) == (ssize_t)sizeof(buf);
+            if (r.ok[e]) { r.val[e] = buf[0]; r.ena[e] = buf[1]; r.run[e] = buf[2]; }
+        }
+    }
+
+private:
+    long tid_ = -1;
+    int fd_[PERF_NUM_EVENTS];
+};
+
+// Счётчики вызывающего потока (открываются при первом обращении)
+inline PerfThread& perf_this_thread() {
+    thread_local PerfThread t;
+    static std::atomic<bool> warned(false);
+    if (!t.any() && !warned.exchange(true))
+        std::cerr << "perf_counters: perf_event_open failed "
+                     "(check /proc/sys/kernel/perf_event_paranoid), values will be -1\n";
+    return t;
+}
+
+#endif // PERF_COUNTERS_LINUX
+
+// Снимок счётчиков всех потоков команды: out[t] — поток OpenMP номер t.
+// Вызывается ВНЕ parallel-региона, сам открывает короткий регион на omp_get_max_threads().
+inline void perf_snapshot(std::vector<PerfRaw>& out) {
+#ifdef PERF_COUNTERS_LINUX
+#ifdef _OPENMP
+    out.assign((size_t)omp_get_max_threads(), PerfRaw());
+    #pragma omp parallel
+    {
+        size_t t = (size_t)omp_get_thread_num();
+        if (t < out.size()) perf_this_thread().read_raw(out[t]);
+    }
+#else
+    out.assign(1, PerfRaw());
+    perf_this_thread().read_raw(out[0]);
+#endif
+#else
+    out.clear();
+#endif
+}
+
+// Накопленные значения участка: по потокам и число вызовов (для "на вызов")
+struct PerfRegion {
+    std::string name;
+    long long calls = 0;
+    std::vector<PerfValues> threads;
+
+    PerfValues total() const {
+        PerfValues s;
+        for (const auto& t : threads) s.add(t);
+        return s;
+    }
+    PerfValues per_call() const {
+        return calls > 0 ? total().scaled(1.0 / (double)calls) : PerfValues();
+    }
+    bool empty() const { return calls == 0; }
+
+    // добавить разность снимков (calls — сколько вызовов между ними)
+    void accumulate(const std::vector<PerfRaw>& a, const std::vector<PerfRaw>& b, long long n_calls) {
+        size_t n = std::min(a.size(), b.size());
+        if (threads.size() < n) threads.resize(n);
+        for (size_t t = 0; t < n; ++t) threads[t].add(perf_delta(a[t], b[t]));
+        calls += n_calls;
+    }
+};
+
+// Scoped-замер: счётчики всех потоков при входе и выходе из блока.
+//   { PerfScope ps(perf_region("sort/par")); sort(...); }
+// При выключенном измерении конструктор и деструктор ничего не делают.
+class PerfScope {
+public:
+    explicit PerfScope(PerfRegion& region, long long calls = 1)
+        : region_(region), calls_(calls), on_(perf_enabled()) {
+        if (on_) perf_snapshot(start_);
+    }
+    ~PerfScope() {
+        if (!on_) return;
+        std::vector<PerfRaw> stop;
+        perf_snapshot(stop);
+        region_.accumulate(start_, stop, calls_);
+    }
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfRegion& region_;
+    long long calls_;
+    bool on_;
+    std::vector<PerfRaw> start_;
+};
+
+// Глобальный реестр именованных участков (ссылки стабильны)
+inline std::map<std::string, PerfRegion>& perf_regions() {
+    static std::map<std::string, PerfRegion> regions;
+    return regions;
+}
+inline PerfRegion& perf_region(const std::string& name) {
+    PerfRegion& r = perf_regions()[name];
+    r.name = name;
+    return r;
+}
+
+// Отчёт по участку: значения на один вызов, суммарно и по потокам
+inline void perf_print(const PerfRegion& r, std::ostream& os = std::cout, bool per_thread = true) {
+    if (r.empty()) return;
+    auto row = [&](const std::string& label, const PerfValues& v) {
+        os << "  " << std::left << std::setw(10) << label << std::right;
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e)
+            os << std::setw(15) << (long long)v.v[e];
+        os << std::setw(8) << std::fixed << std::setprecision(2) << v.ipc() << "\n";
+        os.unsetf(std::ios::floatfield);
+    };
+    os << "perf [" << r.name << "], per call (" << r.calls << " calls):\n  " << std::setw(10) << "";
+    for (int e = 0; e < PERF_NUM_EVENTS; ++e) os << std::setw(15) << perf_event_name(e);
+    os << std::setw(8) << "IPC" << "\n";
+    row("total", r.per_call());
+    if (per_thread && r.threads.size() > 1)
+        for (size_t t = 0; t < r.threads.size(); ++t)
+            row("thread " + std::to_string(t), r.threads[t].scaled(1.0 / (double)r.calls));
+}
+
+// Отчёт по всем участкам реестра
+inline void perf_report(std::ostream& os = std::cout) {
+    for (const auto& kv : perf_regions()) perf_print(kv.second, os);
+}
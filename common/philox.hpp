@@ -0,0 +1,205 @@
+// philox.hpp
+// Счётчиковый генератор Philox4x32-10 (Salmon et al., "Parallel random numbers:
+// as easy as 1, 2, 3") для заполнения массивов.
+//  - элемент с глобальным индексом i зависит только от (seed, i), поэтому
+//    результат побитово одинаков при любом числе потоков OpenMP и процессов MPI:
+//    каждый поток / rank просто генерирует свой кусок [offset; offset + n);
+//  - блок Philox даёт 4 слова по 32 бита: 2 double, 4 float или 4 int;
+//  - блоки считаются пачками по PHILOX_BATCH "дорожек" — цикл без ветвлений,
+//    который компилятор векторизует (AVX2 / AVX-512: vpmuludq);
+//  - philox_checksum — контрольная сумма массива, не зависящая от порядка
+//    обхода (сумма по модулю 2^64), её можно складывать через MPI_SUM.
+#pragma once
+
+#include <cstdint>  // uint32_t, uint64_t
+#include <cstring>  // memcpy
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Сколько блоков Philox считаем за одну пачку (16 дорожек = один zmm на слово)
+const int PHILOX_BATCH = 16;
+
+const uint32_t PHILOX_M0 = 0xD2511F53u, PHILOX_M1 = 0xCD9E8D57u;  // множители раундов
+const uint32_t PHILOX_W0 = 0x9E3779B9u, PHILOX_W1 = 0xBB67AE85u;  // приращения ключа
+
+// Один блок: счётчик = номер блока (64 бита), ключ = seed. 10 раундов.
+inline void philox4x32(uint64_t block, uint64_t seed, uint32_t out[4]) {
+    uint32_t c0 = (uint32_t)block, c1 = (uint32_t)(block >> 32), c2 = 0, c3 = 0;
+    uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+    for (int r = 0; r < 10; ++r) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+// PHILOX_BATCH блоков подряд, начиная с first; w[j][l] — слово j блока first + l.
+// Та же арифметика, что в philox4x32, но по дорожкам (векторизуется).
+inline void philox4x32_batch(uint64_t first, uint64_t seed, uint32_t w[4][PHILOX_BATCH]) {
+    uint32_t c0[PHILOX_BATCH], c1[PHILOX_BATCH], c2[PHILOX_BATCH], c3[PHILOX_BATCH];
+    #pragma omp simd
+    for (int l = 0; l < PHILOX_BATCH; ++l) {
+        uint64_t b = first + (uint64_t)l;
+        c0[l] = (uint32_t)b;
+        c1[l] = (uint32_t)(b >> 32);
+        c2[l] = 0;
+        c3[l] = 0;
+    }
+    uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+    for (int r = 0; r < 10; ++r) {
+        #pragma omp simd
+        for (int l = 0; l < PHILOX_BATCH; ++l) {
+            uint64_t p0 = (uint64_t)PHILOX_M0 * c0[l];
+            uint64_t p1 = (uint64_t)PHILOX_M1 * c2[l];
+            uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1[l] ^ k0;
+            uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3[l] ^ k1;
+            c1[l] = (uint32_t)p1;
+            c3[l] = (uint32_t)p0;
+            c0[l] = n0;
+            c2[l] = n2;
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    std::memcpy(w[0], c0, sizeof(c0));
+    std::memcpy(w[1], c1, sizeof(c1));
+    std::memcpy(w[2], c2, sizeof(c2));
+    std::memcpy(w[3], c3, sizeof(c3));
+}
+
+// ==================== ПРЕОБРАЗОВАНИЯ СЛОВ В ЧИСЛА ====================
+// K — сколько элементов даёт один блок; conv(w, lane, k) — k-й элемент блока lane.
+
+// double в [lo; hi): 53 бита из двух слов (элемент k блока -> слова 2k, 2k+1)
+struct PhiloxDouble {
+    static const int K = 2;
+    double lo, scale;
+    PhiloxDouble(double lo_, double hi_) : lo(lo_), scale((hi_ - lo_) * 0x1.0p-53) {}
+    double operator()(const uint32_t w[4][PHILOX_BATCH], int lane, int k) const {
+        uint64_t u = ((uint64_t)w[2 * k][lane] << 32 | w[2 * k + 1][lane]) >> 11;
+        return lo + (double)u * scale;
+    }
+};
+
+// float в [lo; hi): 24 бита из одного слова
+struct PhiloxFloat {
+    static const int K = 4;
+    float lo, scale;
+    PhiloxFloat(float lo_, float hi_) : lo(lo_), scale((hi_ - lo_) * 0x1.0p-24f) {}
+    float operator()(const uint32_t w[4][PHILOX_BATCH], int lane, int k) const {
+        return lo + (float)(w[k][lane] >> 8) * scale;
+    }
+};
+
+// int в [lo; hi] (включительно): умножение со сдвигом (Lemire, без отбраковки)
+struct PhiloxInt {
+    static const int K = 4;
+    int lo;
+    uint64_t range;
+    PhiloxInt(int lo_, int hi_) : lo(lo_), range((uint64_t)((int64_t)hi_ - lo_) + 1) {}
+    int operator()(const uint32_t w[4][PHILOX_BATCH], int lane, int k) const {
+        return (int)((int64_t)lo + (int64_t)(((uint64_t)w[k][lane] * range) >> 32));
+    }
+};
+
+// ==================== ЗАПОЛНЕНИЕ ====================
+
+// out[i - offset] = элемент с глобальным индексом i, i в [begin; end)
+template <typename T, typename Conv>
+inline void philox_fill_range(T* out, long long offset, long long begin, long long end,
+                              uint64_t seed, const Conv& conv) {
+    const int K = Conv::K;
+    const long long per_batch = (long long)K * PHILOX_BATCH;   // элементов в пачке
+    uint32_t w[4][PHILOX_BATCH];
+    for (long long b0 = begin / per_batch * per_batch; b0 < end; b0 += per_batch) {
+        philox4x32_batch((uint64_t)(b0 / K), seed, w);
+        if (b0 >= begin && b0 + per_batch <= end) {
+            T* dst = out + (b0 - offset);                       // пачка целиком внутри
+            for (int l = 0; l < PHILOX_BATCH; ++l)
+                for (int k = 0; k < K; ++k) dst[l * K + k] = conv(w, l, k);
+        } else {
+            for (int l = 0; l < PHILOX_BATCH; ++l)              // края куска
+                for (int k = 0; k < K; ++k) {
+                    long long i = b0 + (long long)l * K + k;
+                    if (i >= begin && i < end) out[i - offset] = conv(w, l, k);
+                }
+        }
+    }
+}
+
+// Кусок [offset; offset + n) делится между потоками OpenMP по пачкам
+// (границы кратны пачке, поэтому ни одна пачка не считается дважды)
+template <typename T, typename Conv>
+inline void philox_fill_par(T* out, long long n, uint64_t seed, long long offset, const Conv& conv) {
+    const long long per_batch = (long long)Conv::K * PHILOX_BATCH;
+    long long first = offset / per_batch, last = (offset + n + per_batch - 1) / per_batch;
+    #pragma omp parallel for schedule(static)
+    for (long long b = first; b < last; ++b) {
+        long long lo = b * per_batch, hi = lo + per_batch;
+        if (lo < offset) lo = offset;
+        if (hi > offset + n) hi = offset + n;
+        philox_fill_range(out, offset, lo, hi, seed, conv);
+    }
+}
+
+// Равномерные double в [lo; hi). offset — глобальный индекс out[0] (кусок rank'а).
+inline void philox_uniform(double* out, long long n, uint64_t seed,
+                           double lo = 0.0, double hi = 1.0, long long offset = 0) {
+    philox_fill_range(out, offset, offset, offset + n, seed, PhiloxDouble(lo, hi));
+}
+inline void philox_uniform_par(double* out, long long n, uint64_t seed,
+                               double lo = 0.0, double hi = 1.0, long long offset = 0) {
+    philox_fill_par(out, n, seed, offset, PhiloxDouble(lo, hi));
+}
+
+// Равномерные float в [lo; hi)
+inline void philox_uniform(float* out, long long n, uint64_t seed,
+                           float lo = 0.f, float hi = 1.f, long long offset = 0) {
+    philox_fill_range(out, offset, offset, offset + n, seed, PhiloxFloat(lo, hi));
+}
+inline void philox_uniform_par(float* out, long long n, uint64_t seed,
+                               float lo = 0.f, float hi = 1.f, long long offset = 0) {
+    philox_fill_par(out, n, seed, offset, PhiloxFloat(lo, hi));
+}
+
+// Равномерные int в [lo; hi]
+inline void philox_int(int* out, long long n, uint64_t seed, int lo, int hi, long long offset = 0) {
+    philox_fill_range(out, offset, offset, offset + n, seed, PhiloxInt(lo, hi));
+}
+inline void philox_int_par(int* out, long long n, uint64_t seed, int lo, int hi, long long offset = 0) {
+    philox_fill_par(out, n, seed, offset, PhiloxInt(lo, hi));
+}
+
+// ==================== КОНТРОЛЬНАЯ СУММА ====================
+
+// Перемешивание 64 бит (splitmix64 finalizer)
+inline uint64_t philox_mix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27; x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Сумма mix(биты a[i] ^ mix(i)) по модулю 2^64: не зависит от порядка обхода
+// и разбиения, поэтому куски разных потоков / rank'ов складываются (MPI_UINT64_T, MPI_SUM).
+template <typename T>
+inline uint64_t philox_checksum(const T* a, long long n, long long offset = 0) {
+    static_assert(sizeof(T) <= 8, "philox_checksum: элемент не больше 8 байт");
+    uint64_t s = 0;
+    #pragma omp parallel for schedule(static) reduction(+:s)
+    for (long long i = 0; i < n; ++i) {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &a[i], sizeof(T));
+        s += philox_mix64(bits ^ philox_mix64((uint64_t)(offset + i)));
+    }
+    return s;
+}
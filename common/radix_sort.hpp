@@ -0,0 +1,222 @@
+// radix_sort.hpp
+// Параллельная LSD radix-сортировка 32-битных целых ключей (int / unsigned).
+//  - сначала ищем min/max: сортируем (key - min), поэтому старшие нулевые
+//    разряды не обрабатываются вообще, а ширина разряда подбирается под диапазон;
+//  - если весь диапазон помещается в один небольшой разряд (<= 2^11 значений,
+//    например 1..100) — это сортировка подсчётом: гистограмма + заполнение,
+//    без перестановки элементов;
+//  - иначе на каждом проходе: гистограммы по потокам -> смещения
+//    (префикс по корзинам, параллельно по корзинам) -> scatter через
+//    буферы записи по 64 байта на корзину (write-combining);
+//  - проход, в котором все ключи попали в одну корзину, пропускается.
+// Все проходы выполняются внутри одного parallel-региона.
+#pragma once
+
+#include <algorithm>   // min, max, upper_bound, copy
+#include <cstdint>     // uint32_t
+#include <cstring>     // memcpy
+#include <memory>      // unique_ptr
+#include <type_traits> // is_signed_v
+#include <vector>      // гистограммы
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Максимальная ширина одного разряда при обычных проходах (256 корзин)
+const int RADIX_MAX_DIGIT_BITS = 8;
+// До какого диапазона (в битах) делаем сортировку подсчётом
+const int RADIX_COUNTING_BITS = 11;
+// Сколько ключей копим в буфере корзины перед записью (64 байта)
+const int RADIX_WC = 64 / 4;
+
+// Отображение ключа в беззнаковый порядок: для int переворачиваем знаковый бит
+template <typename T>
+inline uint32_t radix_map(T x) {
+    if constexpr (std::is_signed_v<T>) return (uint32_t)x ^ 0x80000000u;
+    else return (uint32_t)x;
+}
+
+template <typename T>
+inline T radix_unmap(uint32_t k) {
+    if constexpr (std::is_signed_v<T>) return (T)(k ^ 0x80000000u);
+    else return (T)k;
+}
+
+// Непрерывный кусок потока t из used (как schedule(static))
+inline void radix_chunk(long long n, int t, int used, long long& lo, long long& hi) {
+    lo = n * t / used;
+    hi = n * (t + 1) / used;
+}
+
+template <typename T>
+inline void radix_sort_impl(T* a, long long n, int nt) {
+    static_assert(std::is_integral_v<T> && sizeof(T) == 4, "radix_sort: только 32-битные целые");
+    if (n < 2) return;
+#ifndef _OPENMP
+    nt = 1;
+#endif
+
+    // ---------- 1) диапазон ключей ----------
+    uint32_t kmin = UINT32_MAX, kmax = 0;
+    #pragma omp parallel for num_threads(nt) schedule(static) reduction(min:kmin) reduction(max:kmax)
+    for (long long i = 0; i < n; ++i) {
+        uint32_t k = radix_map(a[i]);
+        kmin = std::min(kmin, k);
+        kmax = std::max(kmax, k);
+    }
+    uint32_t range = kmax - kmin;
+    if (range == 0) return;                                  // все ключи равны
+    int bits = 32 - __builtin_clz(range);                    // значащих бит в (key - kmin)
+
+    // ---------- 2) узкий диапазон: сортировка подсчётом ----------
+    if (bits <= RADIX_COUNTING_BITS) {
+        const int B = 1 << bits;
+        std::vector<long long> hist((size_t)nt * B, 0);
+        std::vector<long long> start(B + 1, 0);
+        #pragma omp parallel num_threads(nt)
+        {
+            int t = 0, used = 1;
+#ifdef _OPENMP
+            t = omp_get_thread_num();
+            used = omp_get_num_threads();
+#endif
+            long long lo, hi;
+            radix_chunk(n, t, used, lo, hi);
+            long long* h = &hist[(size_t)t * B];
+            for (long long i = lo; i < hi; ++i) h[radix_map(a[i]) - kmin]++;
+            #pragma omp barrier
+
+            // суммы по корзинам считаем параллельно по корзинам
+            #pragma omp for schedule(static)
+            for (int b = 0; b < B; ++b) {
+                long long s = 0;
+                for (int r = 0; r < used; ++r) s += hist[(size_t)r * B + b];
+                start[b + 1] = s;
+            }
+            #pragma omp single
+            for (int b = 0; b < B; ++b) start[b + 1] += start[b];   // префикс
+
+            // каждый поток заполняет свой кусок ВЫХОДА: ищем корзину и пишем её значение
+            radix_chunk(n, t, used, lo, hi);
+            long long i = lo;
+            int b = (int)(std::upper_bound(start.begin(), start.end(), lo) - start.begin()) - 1;
+            while (i < hi) {
+                long long e = std::min(hi, start[b + 1]);
+                T v = radix_unmap<T>(kmin + (uint32_t)b);
+                std::fill(a + i, a + e, v);
+                i = e;
+                ++b;
+            }
+        }
+        return;
+    }
+
+    // ---------- 3) обычные LSD-проходы ----------
+    const int passes = (bits + RADIX_MAX_DIGIT_BITS - 1) / RADIX_MAX_DIGIT_BITS;
+    const int dbits = (bits + passes - 1) / passes;          // разряды одинаковой ширины
+    const int B = 1 << dbits;
+    const uint32_t mask = (uint32_t)B - 1;
+
+    std::unique_ptr<T[]> tmp(new T[n]);
+    std::vector<long long> hist((size_t)nt * B, 0);          // счётчики, потом смещения
+    std::vector<long long> total(B, 0);
+
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = 0, used = 1;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+        used = omp_get_num_threads();
+#endif
+        long long lo, hi;
+        radix_chunk(n, t, used, lo, hi);
+        long long* h = &hist[(size_t)t * B];
+        T* src = a;                                           // у каждого потока свои указатели,
+        T* dst = tmp.get();                                   // меняются одинаково у всех
+
+        // буферы записи: B корзин по RADIX_WC ключей, выровнены по строке кэша
+        struct alignas(64) Line { T v[RADIX_WC]; };
+        std::unique_ptr<Line[]> wc(new Line[B]);
+        std::vector<int> fill(B);
+
+        for (int pass = 0; pass < passes; ++pass) {
+            const int shift = pass * dbits;
+
+            // гистограмма своего куска
+            std::fill(h, h + B, 0);
+            for (long long i = lo; i < hi; ++i)
+                h[((radix_map(src[i]) - kmin) >> shift) & mask]++;
+            #pragma omp barrier
+
+            #pragma omp for schedule(static)
+            for (int b = 0; b < B; ++b) {
+                long long s = 0;
+                for (int r = 0; r < used; ++r) s += hist[(size_t)r * B + b];
+                total[b] = s;
+            }
+            // неявный барьер после for: total готов у всех
+
+            // все ключи в одной корзине — разряд ничего не меняет, пропускаем проход
+            bool skip = false;
+            for (int b = 0; b < B && !skip; ++b) skip = (total[b] == n);
+            #pragma omp barrier                               // все проверили total до его изменения
+            if (skip) continue;
+
+            // смещения: корзина b, поток r -> начало его записей (параллельно по корзинам)
+            #pragma omp single
+            {
+                long long run = 0;
+                for (int b = 0; b < B; ++b) { long long c = total[b]; total[b] = run; run += c; }
+            }
+            #pragma omp for schedule(static)
+            for (int b = 0; b < B; ++b) {
+                long long off = total[b];
+                for (int r = 0; r < used; ++r) {
+                    long long c = hist[(size_t)r * B + b];
+                    hist[(size_t)r * B + b] = off;
+                    off += c;
+                }
+            }
+
+            // scatter через буферы записи (порядок внутри потока сохраняется -> устойчиво)
+            std::fill(fill.begin(), fill.end(), 0);
+            for (long long i = lo; i < hi; ++i) {
+                T x = src[i];
+                uint32_t d = ((radix_map(x) - kmin) >> shift) & mask;
+                int f = fill[d];
+                wc[d].v[f++] = x;
+                if (f == RADIX_WC) {
+                    std::memcpy(dst + h[d], wc[d].v, sizeof(wc[d].v));
+                    h[d] += RADIX_WC;
+                    f = 0;
+                }
+                fill[d] = f;
+            }
+            for (int d = 0; d < B; ++d)
+                if (fill[d]) std::memcpy(dst + h[d], wc[d].v, fill[d] * sizeof(T));
+            #pragma omp barrier
+
+            std::swap(src, dst);
+        }
+
+        // нечётное число выполненных проходов: результат в tmp, копируем обратно
+        if (src != a) std::copy(src + lo, src + hi, a + lo);
+    }
+}
+
+// Последовательная версия (тот же алгоритм в одном потоке)
+template <typename T>
+inline void radix_sort(T* a, long long n) {
+    radix_sort_impl(a, n, 1);
+}
+
+// Параллельная версия (все потоки OpenMP)
+template <typename T>
+inline void radix_sort_par(T* a, long long n) {
+#ifdef _OPENMP
+    radix_sort_impl(a, n, omp_get_max_threads());
+#else
+    radix_sort_impl(a, n, 1);
+#endif
+}
@@ -0,0 +1,185 @@
+// sssp.hpp
+// Кратчайшие пути на CSR-графе (csr_graph.hpp), веса int > 0, нет пути — FLOYD_INF
+// (как в плотной матрице Флойда: результаты сравниваются побитово).
+//  - sssp_dijkstra(g, s, dist[, ws]) — один поток, двоичная куча с ленивым удалением;
+//  - sssp_delta_par(g, s, delta, dist) — delta-stepping (Meyer, Sanders) на всех потоках:
+//    вершины лежат в корзинах по dist / delta; корзины обрабатываются по возрастанию,
+//    все вершины текущей корзины релаксируются параллельно (атомарный min по dist),
+//    новые вершины каждый поток кладёт в свои корзины — без общей очереди и блокировок.
+//    Корзина обрабатывается, пока в неё что-то попадает (лёгкие рёбра < delta);
+//    устаревшие записи (dist вершины уже попал в меньшую корзину) пропускаются.
+//    delta = 1 — почти Дейкстра (много раундов, мало лишней работы), большое delta —
+//    Беллман–Форд (мало раундов, много повторных релаксаций). sssp_delta_auto — ~wmax / степень;
+//  - apsp_checksum_par(g, s0, s1) — строки s0..s1-1 матрицы расстояний: источники параллельно
+//    по потокам (у каждого Дейкстра и свой буфер строки), сумма philox_checksum строк —
+//    та же контрольная сумма, что у Флойда по соответствующим строкам (куски складываются, MPI_SUM).
+#pragma once
+
+#include <algorithm>  // fill, max
+#include <atomic>
+#include <climits>    // LLONG_MAX
+#include <functional> // greater
+#include <memory>     // unique_ptr
+#include <utility>    // pair
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "csr_graph.hpp"
+#include "philox.hpp"  // philox_checksum
+
+struct SsspStats {
+    long long rounds = 0;        // обработанных фронтов (корзина может обрабатываться несколько раз)
+    long long buckets = 0;       // непустых корзин
+    long long relaxations = 0;   // просмотренных рёбер
+    long long updates = 0;       // успешных уменьшений dist
+};
+
+// Рабочая память Дейкстры: переиспользуется между источниками одного потока
+struct DijkstraWorkspace {
+    std::vector<std::pair<int, int>> heap;   // (dist, вершина), на вершине — минимум
+};
+
+inline void sssp_dijkstra(const CsrGraph& g, int s, int* dist, DijkstraWorkspace* ws = nullptr) {
+    DijkstraWorkspace local;
+    std::vector<std::pair<int, int>>& heap = (ws ? ws : &local)->heap;
+    std::greater<std::pair<int, int>> cmp;
+    std::fill(dist, dist + g.n, FLOYD_INF);
+    dist[s] = 0;
+    heap.clear();
+    heap.push_back({0, s});
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        auto [du, u] = heap.back();
+        heap.pop_back();
+        if (du != dist[u]) continue;                     // устаревшая запись
+        for (long long k = g.row[(size_t)u]; k < g.row[(size_t)u + 1]; ++k) {
+            int v = g.col[(size_t)k], nd = du + g.w[(size_t)k];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push_back({nd, v});
+                std::push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+    }
+}
+
+// delta по умолчанию: ~ максимальный вес / средняя степень (не меньше 1)
+inline int sssp_delta_auto(const CsrGraph& g) {
+    double deg = g.n > 0 ? (double)g.edges() / g.n : 1.0;
+    int wmax = 1;
+    for (int x : g.w) wmax = std::max(wmax, x);
+    return std::max(1, (int)((double)wmax / std::max(1.0, deg) * 2.0));
+}
+
+inline void sssp_delta_par(const CsrGraph& g, int s, int delta, int* dist, SsspStats* stats = nullptr) {
+    int n = g.n;
+    std::unique_ptr<std::atomic<int>[]> d(new std::atomic<int>[(size_t)n]);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) d[(size_t)i].store(FLOYD_INF, std::memory_order_relaxed);
+    d[(size_t)s].store(0, std::memory_order_relaxed);
+
+    int nt = 1;
+#ifdef _OPENMP
+    nt = omp_get_max_threads();
+#endif
+    std::vector<int> frontier{s};
+    std::vector<std::vector<std::vector<int>>> bins((size_t)nt);   // bins[t][b] — корзина b потока t
+    std::vector<size_t> offs((size_t)nt + 1, 0);
+    long long cur = 0, nextBin = LLONG_MAX;
+    SsspStats st;
+    st.buckets = 1;                                          // корзина 0 (источник)
+
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        auto& my = bins[(size_t)t];
+        long long relax = 0, upd = 0;
+        while (true) {
+            // 1) релаксация рёбер фронта
+            #pragma omp for schedule(dynamic, 64) nowait
+            for (size_t i = 0; i < frontier.size(); ++i) {
+                int u = frontier[i];
+                int du = d[(size_t)u].load(std::memory_order_relaxed);
+                if ((long long)du / delta < cur) continue;        // уже обработана в меньшей корзине
+                for (long long k = g.row[(size_t)u]; k < g.row[(size_t)u + 1]; ++k) {
+                    int v = g.col[(size_t)k], nd = du + g.w[(size_t)k];
+                    ++relax;
+                    int old = d[(size_t)v].load(std::memory_order_relaxed);
+                    while (nd < old && !d[(size_t)v].compare_exchange_weak(old, nd, std::memory_order_relaxed)) {}
+                    if (nd < old) {
+                        ++upd;
+                        size_t b = (size_t)(nd / delta);
+                        if (my.size() <= b) my.resize(b + 1);
+                        my[b].push_back(v);
+                    }
+                }
+            }
+            // 2) следующая корзина — наименьшая непустая среди всех потоков
+            long long lm = LLONG_MAX;
+            for (size_t b = (size_t)cur; b < my.size(); ++b)
+                if (!my[b].empty()) { lm = (long long)b; break; }
+            #pragma omp critical(sssp_next_bin)
+            nextBin = std::min(nextBin, lm);
+            #pragma omp barrier
+            #pragma omp single
+            {
+                if (nextBin != cur && nextBin != LLONG_MAX) st.buckets++;
+                cur = nextBin;
+                nextBin = LLONG_MAX;
+            }
+            if (cur == LLONG_MAX) break;
+
+            // 3) новый фронт — корзины cur всех потоков подряд
+            offs[(size_t)t + 1] = (size_t)cur < my.size() ? my[(size_t)cur].size() : 0;
+            #pragma omp barrier
+            #pragma omp single
+            {
+                for (int q = 0; q < nt; ++q) offs[(size_t)q + 1] += offs[(size_t)q];
+                frontier.resize(offs[(size_t)nt]);
+                st.rounds++;
+            }
+            if ((size_t)cur < my.size()) {
+                std::copy(my[(size_t)cur].begin(), my[(size_t)cur].end(), frontier.begin() + (long long)offs[(size_t)t]);
+                my[(size_t)cur].clear();
+            }
+            #pragma omp barrier
+        }
+        #pragma omp atomic
+        st.relaxations += relax;
+        #pragma omp atomic
+        st.updates += upd;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) dist[i] = d[(size_t)i].load(std::memory_order_relaxed);
+    if (stats) *stats = st;
+}
+
+// Строки s0..s1-1 матрицы расстояний (источники — по потокам, schedule(dynamic)):
+// fn(s, dist) для каждой строки, возвращает сумму philox_checksum(dist, N, s * N)
+template <typename Fn>
+inline unsigned long long apsp_rows_par(const CsrGraph& g, int s0, int s1, Fn fn) {
+    unsigned long long cs = 0;
+    #pragma omp parallel reduction(+:cs)
+    {
+        std::vector<int> dist((size_t)g.n);
+        DijkstraWorkspace ws;
+        #pragma omp for schedule(dynamic, 1)
+        for (int s = s0; s < s1; ++s) {
+            sssp_dijkstra(g, s, dist.data(), &ws);
+            cs += philox_checksum(dist.data(), (long long)g.n, (long long)s * g.n);
+            fn(s, (const int*)dist.data());
+        }
+    }
+    return cs;
+}
+
+inline unsigned long long apsp_checksum_par(const CsrGraph& g, int s0, int s1) {
+    return apsp_rows_par(g, s0, s1, [](int, const int*) {});
+}
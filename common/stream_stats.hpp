@@ -0,0 +1,275 @@
+// stream_stats.hpp
+// Потоковая (out-of-core) статистика по бинарному файлу из double / float:
+// count, mean, variance, min, max за ОДИН проход по файлу, память ограничена
+// размером куска (а не размером файла).
+//  - куски по chunk_bytes; каждый кусок считают все потоки OpenMP:
+//    у потока свой подкусок, внутри — два прохода по данным в кэше/памяти
+//    (сначала среднее, потом сумма квадратов отклонений), это устойчиво
+//    в отличие от sumsq/n - mean^2;
+//  - частичные результаты (потоков, кусков, процессов MPI) объединяются
+//    формулой Чана (параллельный Уэлфорд): moments_merge;
+//  - чтение с двойной буферизацией:
+//      StreamMode::Read — отдельный поток читает (pread) кусок k+1 в свой буфер,
+//                          пока OpenMP считает кусок k (posix_fadvise SEQUENTIAL);
+//      StreamMode::Mmap — файл отображается в память, для куска k+1 заранее
+//                          делается madvise(WILLNEED) (асинхронный readahead),
+//                          обработанный кусок отдаётся ядру (DONTNEED),
+//                          поэтому резидентная память ~ 2 куска.
+//    В режиме Read прочитанные куски тоже выбрасываются из page cache (FADV_DONTNEED).
+// Только Linux/POSIX (pread, mmap).
+#pragma once
+
+#include <algorithm>   // min, max
+#include <chrono>      // steady_clock
+#include <cmath>       // sqrt
+#include <cstdint>     // uint64_t
+#include <exception>   // exception_ptr
+#include <limits>      // infinity
+#include <stdexcept>   // runtime_error
+#include <string>
+#include <thread>      // поток чтения
+#include <vector>
+
+#include <fcntl.h>     // open, posix_fadvise
+#include <sys/mman.h>  // mmap, madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // pread, close
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Моменты выборки: n, среднее, M2 = sum (x - mean)^2, min, max
+struct Moments {
+    long long n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    double variance() const { return n > 0 ? m2 / (double)n : 0.0; }        // генеральная
+    double sample_variance() const { return n > 1 ? m2 / (double)(n - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+};
+
+// Объединение двух частей (Chan, Golub, LeVeque): порядок слияния на результат
+// почти не влияет, поэтому части можно считать в любом разбиении
+inline void moments_merge(Moments& into, const Moments& b) {
+    if (b.n == 0) return;
+    if (into.n == 0) { into = b; return; }
+    long long n = into.n + b.n;
+    double delta = b.mean - into.mean;
+    double fb = (double)b.n / (double)n;
+    into.mean += delta * fb;
+    into.m2 += b.m2 + delta * delta * (double)into.n * fb;
+    into.n = n;
+    into.min = std::min(into.min, b.min);
+    into.max = std::max(into.max, b.max);
+}
+
+// Моменты непрерывного куска (один поток): два прохода по данным, оба векторизуются
+template <typename T>
+inline Moments moments_block(const T* a, long long n) {
+    Moments m;
+    if (n <= 0) return m;
+    double sum = 0.0, mn = a[0], mx = a[0];
+    #pragma omp simd reduction(+:sum) reduction(min:mn) reduction(max:mx)
+    for (long long i = 0; i < n; ++i) {
+        double x = (double)a[i];
+        sum += x;
+        mn = std::min(mn, x);
+        mx = std::max(mx, x);
+    }
+    double mean = sum / (double)n;
+    double m2 = 0.0, corr = 0.0;
+    #pragma omp simd reduction(+:m2) reduction(+:corr)
+    for (long long i = 0; i < n; ++i) {
+        double d = (double)a[i] - mean;
+        m2 += d * d;
+        corr += d;                       // ошибка округления среднего
+    }
+    m.n = n;
+    m.mean = mean + corr / (double)n;    // уточнённое среднее
+    m.m2 = m2 - corr * corr / (double)n; // поправка (Björck, corrected two-pass)
+    m.min = mn;
+    m.max = mx;
+    return m;
+}
+
+// Моменты куска всеми потоками OpenMP: подкуски [n*t/p; n*(t+1)/p), слияние в порядке потоков
+template <typename T>
+inline Moments moments_par(const T* a, long long n) {
+#ifdef _OPENMP
+    int nt = omp_get_max_threads();
+    if (nt <= 1 || n < 4096) return moments_block(a, n);
+    std::vector<Moments> part(nt);
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = omp_get_thread_num();
+        int used = omp_get_num_threads();
+        long long lo = n * t / used;
+        long long hi = n * (t + 1) / used;
+        part[t] = moments_block(a + lo, hi - lo);
+    }
+    Moments s;
+    for (const auto& p : part) moments_merge(s, p);
+    return s;
+#else
+    return moments_block(a, n);
+#endif
+}
+
+// ==================== ЧТЕНИЕ ФАЙЛА ====================
+
+enum class StreamMode { Read, Mmap };
+
+struct StreamConfig {
+    StreamMode mode = StreamMode::Read;
+    size_t chunk_bytes = 64u << 20;   // размер куска (и каждого из двух буферов)
+    long long first = 0;              // с какого элемента (кусок файла для rank'а MPI)
+    long long count = -1;             // сколько элементов (-1 — до конца файла)
+};
+
+struct StreamResult {
+    Moments m;
+    long long bytes = 0;              // сколько прочитано
+    int chunks = 0;
+    double seconds = 0.0;             // всё время прохода
+    double wait_seconds = 0.0;        // сколько вычисление ждало диск
+    double gbs() const { return seconds > 0 ? (double)bytes / seconds / 1e9 : 0.0; }
+};
+
+inline double stream_now_s() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Число элементов типа T в файле
+template <typename T>
+inline long long stream_file_elements(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) throw std::runtime_error("stream_stats: cannot stat " + path);
+    return (long long)st.st_size / (long long)sizeof(T);
+}
+
+// Дескриптор файла, закрывается при любом выходе из функции (в том числе по исключению)
+struct StreamFd {
+    int fd;
+    explicit StreamFd(int fd_) : fd(fd_) {}
+    StreamFd(const StreamFd&) = delete;
+    StreamFd& operator=(const StreamFd&) = delete;
+    ~StreamFd() { if (fd >= 0) close(fd); }
+};
+
+// Чтение ровно len байт с позиции off (pread может вернуть меньше)
+inline void stream_pread_all(int fd, char* buf, size_t len, off_t off) {
+    while (len > 0) {
+        ssize_t r = pread(fd, buf, len, off);
+        if (r <= 0) throw std::runtime_error("stream_stats: read failed");
+        buf += r;
+        len -= (size_t)r;
+        off += r;
+    }
+}
+
+// Один проход по [first; first + count) элементов файла
+template <typename T>
+inline StreamResult stream_stats_file(const std::string& path, const StreamConfig& cfg = StreamConfig()) {
+    StreamResult res;
+    long long total = stream_file_elements<T>(path);
+    long long first = std::min(std::max(0LL, cfg.first), total);
+    long long count = cfg.count < 0 ? total - first : std::min(cfg.count, total - first);
+    long long per_chunk = std::max<long long>(1, (long long)(cfg.chunk_bytes / sizeof(T)));
+    int nchunks = (int)((count + per_chunk - 1) / per_chunk);
+    res.chunks = nchunks;
+    res.bytes = count * (long long)sizeof(T);
+    if (count <= 0) return res;
+
+    StreamFd file(open(path.c_str(), O_RDONLY));
+    if (file.fd < 0) throw std::runtime_error("stream_stats: cannot open " + path);
+    const int fd = file.fd;
+    const off_t base = (off_t)first * (off_t)sizeof(T);
+    auto chunk_len = [&](int k) { return std::min(per_chunk, count - (long long)k * per_chunk); };
+
+    double t0 = stream_now_s();
+    if (cfg.mode == StreamMode::Read) {
+        posix_fadvise(fd, base, (off_t)res.bytes, POSIX_FADV_SEQUENTIAL);
+        size_t buf_len = (size_t)std::min(per_chunk, count);
+        std::vector<T> buf[2] = {std::vector<T>(buf_len), std::vector<T>(buf_len)};
+        auto load = [&](int k) {
+            stream_pread_all(fd, (char*)buf[k & 1].data(), (size_t)chunk_len(k) * sizeof(T),
+                             base + (off_t)k * per_chunk * (off_t)sizeof(T));
+        };
+        load(0);
+        for (int k = 0; k < nchunks; ++k) {
+            // пока считаем кусок k, отдельный поток читает k+1 во второй буфер
+            std::thread reader;
+            std::exception_ptr err;          // ошибка чтения передаётся в основной поток
+            if (k + 1 < nchunks)
+                reader = std::thread([&, k] {
+                    try { load(k + 1); } catch (...) { err = std::current_exception(); }
+                });
+            moments_merge(res.m, moments_par(buf[k & 1].data(), chunk_len(k)));
+            // прочитанное больше не нужно: не даём файлу вытеснить всё из page cache
+            posix_fadvise(fd, base + (off_t)k * per_chunk * (off_t)sizeof(T),
+                          (off_t)chunk_len(k) * (off_t)sizeof(T), POSIX_FADV_DONTNEED);
+            double w0 = stream_now_s();
+            if (reader.joinable()) reader.join();
+            res.wait_seconds += stream_now_s() - w0;
+            if (err) std::rethrow_exception(err);
+        }
+    } else {
+        // отображение должно начинаться с границы страницы
+        const off_t page = (off_t)sysconf(_SC_PAGESIZE);
+        off_t map_off = base / page * page;
+        size_t lead = (size_t)(base - map_off);
+        size_t map_len = lead + (size_t)res.bytes;
+        char* map = (char*)mmap(nullptr, map_len, PROT_READ, MAP_PRIVATE, fd, map_off);
+        if (map == (char*)MAP_FAILED) throw std::runtime_error("stream_stats: mmap failed");
+        madvise(map, map_len, MADV_SEQUENTIAL);
+        const T* data = (const T*)(map + lead);
+        // границы куска k в байтах отображения, выровненные по странице (для madvise)
+        auto range = [&](int k, char*& p, size_t& len) {
+            size_t b = lead + (size_t)k * (size_t)per_chunk * sizeof(T);
+            size_t e = b + (size_t)chunk_len(k) * sizeof(T);
+            b = b / (size_t)page * (size_t)page;
+            p = map + b;
+            len = e - b;
+        };
+        char* p;
+        size_t len;
+        range(0, p, len);
+        madvise(p, len, MADV_WILLNEED);
+        for (int k = 0; k < nchunks; ++k) {
+            if (k + 1 < nchunks) { range(k + 1, p, len); madvise(p, len, MADV_WILLNEED); } // readahead
+            moments_merge(res.m, moments_par(data + (long long)k * per_chunk, chunk_len(k)));
+            range(k, p, len);
+            madvise(p, len, MADV_DONTNEED);                                             // освобождаем
+        }
+        munmap(map, map_len);
+    }
+    res.seconds = stream_now_s() - t0;
+    return res;
+}
+
+// Запись n элементов в файл кусками (для тестов): fill(buf, count, first) заполняет кусок
+template <typename T, typename Fill>
+inline void stream_write_file(const std::string& path, long long n, Fill&& fill,
+                              size_t chunk_bytes = 64u << 20) {
+    StreamFd file(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+    if (file.fd < 0) throw std::runtime_error("stream_stats: cannot create " + path);
+    const int fd = file.fd;
+    long long per_chunk = std::max<long long>(1, (long long)(chunk_bytes / sizeof(T)));
+    std::vector<T> buf(per_chunk);
+    for (long long first = 0; first < n; first += per_chunk) {
+        long long c = std::min(per_chunk, n - first);
+        fill(buf.data(), c, first);
+        const char* p = (const char*)buf.data();
+        size_t left = (size_t)c * sizeof(T);
+        while (left > 0) {
+            ssize_t w = write(fd, p, left);
+            if (w <= 0) throw std::runtime_error("stream_stats: write failed");
+            p += w;
+            left -= (size_t)w;
+        }
+    }
+}
@@ -0,0 +1,214 @@
+// work_stealing.hpp
+// Планировщик задач с кражей работы (work stealing) и зависимостями между задачами.
+//  - граф задач TaskGraph: add(fn, {deps}) — задача с функцией и списком задач,
+//    которые должны завершиться раньше (зависимости только на уже добавленные,
+//    поэтому циклов быть не может);
+//  - у каждого рабочего своя деке Чейза–Лева (Chase–Lev): владелец кладёт и
+//    берёт с низа (LIFO — свежие данные ещё в кэше), остальные крадут с верха
+//    одним CAS. Ёмкость = число задач графа (каждая задача кладётся ровно один
+//    раз), поэтому деке не растёт и старые массивы не нужно хранить;
+//  - задача готова, когда счётчик незавершённых зависимостей дошёл до нуля:
+//    её кладёт к себе тот рабочий, который завершил последнюю зависимость —
+//    нет барьеров между "фазами", следующая стадия стартует сразу;
+//  - рабочие — потоки OpenMP (привязка к ядрам — bench_set_threads из bench.hpp);
+//  - статистика по рабочим: задачи, кражи (удачные / попытки), занятое время
+//    и загрузка = занятое / общее время запуска.
+// Граф можно запускать повторно: счётчики зависимостей восстанавливаются в run().
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>    // unique_ptr
+#include <thread>    // yield
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+const size_t WS_CACHE_LINE = 64;
+
+// ==================== ДЕКЕ ЧЕЙЗА–ЛЕВА ====================
+
+// Деке номеров задач: push / pop — только владелец, steal — любой поток.
+class WsDeque {
+public:
+    explicit WsDeque(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        buf_.reset(new std::atomic<int>[cap]);
+        top_.store(0, std::memory_order_relaxed);
+        bottom_.store(0, std::memory_order_relaxed);
+    }
+
+    void push(int v) {
+        long long b = bottom_.load(std::memory_order_relaxed);
+        buf_[(size_t)b & mask_].store(v, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_release);   // публикуем ячейку ворам
+    }
+
+    // Снять с низа (владелец). Последний элемент делим с ворами через CAS по top
+    bool pop(int& v) {
+        long long b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // bottom виден раньше, чем читаем top
+        long long t = top_.load(std::memory_order_relaxed);
+        if (t > b) {                                           // пусто
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        v = buf_[(size_t)b & mask_].load(std::memory_order_relaxed);
+        if (t < b) return true;                                // больше одного — воры не достанут
+        bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // Украсть с верха (чужой поток). false — пусто или проиграли гонку
+    bool steal(int& v) {
+        long long t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        v = buf_[(size_t)t & mask_].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::unique_ptr<std::atomic<int>[]> buf_;
+    size_t mask_ = 0;
+    alignas(WS_CACHE_LINE) std::atomic<long long> top_;      // воры и владелец — на разных строках кэша
+    alignas(WS_CACHE_LINE) std::atomic<long long> bottom_;
+};
+
+// ==================== СТАТИСТИКА ====================
+
+struct alignas(WS_CACHE_LINE) WsWorkerStats {
+    long long tasks = 0;            // выполнено задач
+    long long steals = 0;           // удачных краж
+    long long steal_attempts = 0;   // всех попыток (в т.ч. у пустых дек)
+    double busy_s = 0;              // время внутри задач
+};
+
+struct WsRunStats {
+    double wall_s = 0;                      // от старта рабочих до завершения последней задачи
+    std::vector<WsWorkerStats> workers;
+
+    double utilisation(size_t w) const { return wall_s > 0 ? workers[w].busy_s / wall_s : 0; }
+    long long total_steals() const {
+        long long s = 0;
+        for (const WsWorkerStats& w : workers) s += w.steals;
+        return s;
+    }
+};
+
+// ==================== ГРАФ ЗАДАЧ ====================
+
+class TaskGraph {
+public:
+    // Добавить задачу; deps — номера ранее добавленных задач. Возвращает номер задачи
+    int add(std::function<void()> fn, const std::vector<int>& deps) {
+        int id = (int)tasks_.size();
+        tasks_.emplace_back();
+        tasks_[id].fn = std::move(fn);
+        tasks_[id].ndeps = (int)deps.size();
+        for (int d : deps) tasks_[d].succ.push_back(id);
+        return id;
+    }
+    int add(std::function<void()> fn, std::initializer_list<int> deps = {}) {
+        return add(std::move(fn), std::vector<int>(deps));
+    }
+
+    size_t size() const { return tasks_.size(); }
+
+    // Выполнить граф на workers рабочих. Готовые с самого начала задачи
+    // раздаются по декам по кругу, дальше баланс — кражами
+    WsRunStats run(int workers) {
+        if (workers < 1) workers = 1;
+        size_t n = tasks_.size();
+        WsRunStats st;
+        st.workers.assign((size_t)workers, WsWorkerStats());
+        if (n == 0) return st;
+
+        std::unique_ptr<std::atomic<int>[]> pending(new std::atomic<int>[n]);
+        std::vector<std::unique_ptr<WsDeque>> dq;
+        for (int w = 0; w < workers; ++w) dq.emplace_back(new WsDeque(n));
+        int rr = 0;
+        for (size_t i = 0; i < n; ++i) {
+            pending[i].store(tasks_[i].ndeps, std::memory_order_relaxed);
+            if (tasks_[i].ndeps == 0) dq[(size_t)(rr++ % workers)]->push((int)i);
+        }
+        std::atomic<long long> remaining((long long)n);
+
+        auto now = [] {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        };
+        double t0 = now();
+        #pragma omp parallel num_threads(workers)
+        {
+#ifdef _OPENMP
+            int w = omp_get_thread_num();
+#else
+            int w = 0;
+#endif
+            WsWorkerStats& me = st.workers[(size_t)w];
+            WsDeque& mine = *dq[(size_t)w];
+            uint32_t rng = 2463534242u + 977u * (uint32_t)w;   // xorshift: выбор жертвы
+            int idle = 0;
+            while (remaining.load(std::memory_order_acquire) > 0) {
+                int id = -1;
+                if (!mine.pop(id)) {
+                    id = -1;
+                    // своя деке пуста — пробуем украсть у случайного рабочего
+                    if (workers > 1) {
+                        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+                        int v = (int)(rng % (uint32_t)(workers - 1));
+                        if (v >= w) ++v;
+                        ++me.steal_attempts;
+                        int got;
+                        if (dq[(size_t)v]->steal(got)) {
+                            id = got;
+                            ++me.steals;
+                        }
+                    }
+                    if (id < 0) {
+                        // работы нет: сначала крутимся, потом уступаем ядро
+                        if (++idle > 64) std::this_thread::yield();
+                        continue;
+                    }
+                }
+                idle = 0;
+                Task& task = tasks_[(size_t)id];
+                double c0 = now();
+                task.fn();
+                me.busy_s += now() - c0;
+                ++me.tasks;
+                // освобождаем последователей; acq_rel — результаты всех зависимостей
+                // видны тому, кто снял счётчик в ноль (и через push — вору)
+                for (int s : task.succ)
+                    if (pending[(size_t)s].fetch_sub(1, std::memory_order_acq_rel) == 1) mine.push(s);
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+        st.wall_s = now() - t0;
+        return st;
+    }
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        int ndeps = 0;               // число зависимостей
+        std::vector<int> succ;       // кто ждёт эту задачу
+    };
+    std::vector<Task> tasks_;
+};
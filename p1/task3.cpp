@@ -1,13 +1,16 @@
 #include <iostream>   // ввод/вывод: cout, cin
 #include <cstdlib>    // rand(), srand()
 #include <ctime>      // time() для зерна генератора случайных чисел
-#include <chrono>     // точное измерение времени выполнения
+
+#include "../common/bench.hpp"     // общий бенчмарк (прогрев, повторы, медиана/ДИ)
+#include "../common/numa_alloc.hpp" // массив: выравнивание, большие страницы, первое касание
+#include "../common/par_stats.hpp" // однопроходная SIMD-редукция (sum/min/max)
 
 #ifdef _OPENMP         // если компилируем с OpenMP (например, -fopenmp)
 #include <omp.h>       // функции OpenMP (omp_get_max_threads и т.д.)
 #endif
 
-using namespace std;   // чтобы не писать std::cout, std::cin, std::chrono и т.п.
+using namespace std;   // чтобы не писать std::cout, std::cin и т.п.
 
 // Последовательный подсчёт среднего значения массива
 double averageSequential(int* arr, int n) {     // функция получает указатель на массив и его размер
@@ -20,23 +23,11 @@ double averageSequential(int* arr, int n) {     // функция получае
     return static_cast<double>(sum) / n;        // переводим sum в double и делим на n -> среднее
 }
 
-// Параллельный подсчёт среднего (OpenMP + reduction)
+// Параллельный подсчёт среднего (OpenMP + SIMD, один проход по данным)
 double averageParallel(int* arr, int n) {       // то же самое, но с распараллеливанием
-    long long sum = 0;                          // общая сумма (будет собираться через reduction)
-
-#ifdef _OPENMP                                     // если OpenMP доступен
-    #pragma omp parallel for reduction(+:sum)      // параллельный for + суммирование sum со всех потоков
-    for (int i = 0; i < n; i++) {                  // каждый поток берёт часть индексов i
-        sum += arr[i];                             // суммируем, OpenMP потом аккуратно объединит частичные суммы
-    }
-#else                                              // если OpenMP не подключен
-    // Если OpenMP недоступен, считаем последовательно (чтобы программа всё равно работала)
-    for (int i = 0; i < n; i++) {                  // обычный цикл
-        sum += arr[i];                             // обычная сумма
-    }
-#endif
-
-    return static_cast<double>(sum) / n;           // возвращаем среднее значение
+    // Каждый поток суммирует свой непрерывный кусок векторным ядром,
+    // частичные суммы объединяются в порядке потоков (без OpenMP — один поток)
+    return compute_stats_par(arr, n).mean();       // возвращаем среднее значение
 }
 
 int main() {                                       // точка входа программы
@@ -48,8 +39,9 @@ int main() {                                       // точка входа пр
         return 1;                                  // выходим с кодом ошибки
     }
 
-    // 1) Динамический массив (вручную, через new)
-    int* arr = new int[n];                         // выделяем память под n int'ов (в куче/heap)
+    // 1) Динамический массив: выровнен на 64 байта, страницы "касаются" параллельно
+    //    теми же кусками, что потом суммируют потоки (на NUMA — память рядом с потоком)
+    int* arr = numa_alloc_array<int>(n);           // выделяем память под n int'ов
 
     // 2) Заполняем массив случайными числами от 1 до 100
     srand(static_cast<unsigned int>(time(nullptr))); // задаём зерно (seed) = текущее время, чтобы rand был "разный"
@@ -66,26 +58,26 @@ int main() {                                       // точка входа пр
         cout << "\n";                             // перевод строки
     }
 
-    // 3) Последовательное среднее + измерение времени (мс)
-    auto start_seq = chrono::high_resolution_clock::now(); // старт таймера (последовательно)
-    double avg_seq = averageSequential(arr, n);             // считаем среднее последовательно
-    auto end_seq = chrono::high_resolution_clock::now();    // конец таймера
-    double time_seq_ms =                                   // переменная под время в миллисекундах
-        chrono::duration<double, std::milli>(end_seq - start_seq).count(); // разница времени -> мс -> число
-
-    // 4) Параллельное среднее + измерение времени (мс)
-    auto start_par = chrono::high_resolution_clock::now();  // старт таймера (параллельно)
-    double avg_par = averageParallel(arr, n);               // считаем среднее с OpenMP (или fallback)
-    auto end_par = chrono::high_resolution_clock::now();    // конец таймера
-    double time_par_ms =                                   // время параллельного варианта
-        chrono::duration<double, std::milli>(end_par - start_par).count(); // разница -> мс
-
-    // 5) Вывод результатов
+    // 3) Последовательное среднее + замер общим бенчмарком (прогрев, повторы, медиана)
+    double avg_seq = 0.0;                                   // среднее (последовательно)
+    BenchResult seq = bench_measure("average", "seq", n, [&] {
+        avg_seq = averageSequential(arr, n);                // считаем среднее последовательно
+    });
+
+    // 4) Параллельное среднее + замер
+    double avg_par = 0.0;                                   // среднее (параллельно)
+    BenchResult par = bench_measure("average", "par", n, [&] {
+        avg_par = averageParallel(arr, n);                  // считаем среднее с OpenMP (или fallback)
+    });
+
+    // 5) Вывод результатов (медиана и 95% доверительный интервал, мс)
     cout << "Results:\n";                                   // заголовок вывода
     cout << "Sequential average: " << avg_seq               // среднее (последовательное)
-         << ", time = " << time_seq_ms << " ms\n";          // время в миллисекундах
+         << ", time = " << seq.median_ms << " ms"           // медиана времени
+         << " [" << seq.ci_lo_ms << "; " << seq.ci_hi_ms << "]\n";
     cout << "Parallel average:   " << avg_par               // среднее (параллельное)
-         << ", time = " << time_par_ms << " ms\n";          // время в миллисекундах
+         << ", time = " << par.median_ms << " ms"           // медиана времени
+         << " [" << par.ci_lo_ms << "; " << par.ci_hi_ms << "]\n";
 
 #ifdef _OPENMP
     cout << "OpenMP is enabled, max threads: "              // сообщение что OpenMP включен
@@ -95,7 +87,7 @@ int main() {                                       // точка входа пр
 #endif
 
     // 6) Освобождение памяти
-    delete[] arr;                                           // освобождаем массив, который делали через new[]
+    numa_free(arr, n);                                      // освобождаем массив
 
     return 0;                                               // успешное завершение программы
 }
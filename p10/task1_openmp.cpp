@@ -0,0 +1,271 @@
+#include <omp.h>        // OpenMP: потоки + omp_get_wtime()
+#include <vector>       // динамический массив
+#include <iostream>     // вывод
+#include <cmath>        // математика
+#include <iomanip>      // формат вывода
+
+#include "../common/bench.hpp"     // общий бенчмарк (повторы, медиана, CSV/JSON)
+#include "../common/numa_alloc.hpp" // NUMA: первое касание по кускам потоков, большие страницы
+#include "../common/par_stats.hpp" // однопроходная SIMD-редукция
+#include "../common/philox.hpp"    // параллельный счётчиковый генератор
+#include "../common/stream_stats.hpp" // потоковая статистика по файлу (out-of-core)
+#include "../common/omp_tune.hpp"  // автотюнер: потоки / schedule / chunk / порог по ядру и размеру
+#include <fstream>
+#include <string>
+
+// --gen: записать в файл N double из того же генератора (кусками, память не растёт)
+static int gen_file(const std::string& path, long long N) {
+    double t0 = omp_get_wtime();
+    stream_write_file<double>(path, N, [](double* buf, long long c, long long first) {
+        philox_uniform_par(buf, c, 123, 0.0, 1.0, first);   // те же данные, что в памяти
+    });
+    std::cout << "written " << path << ": N=" << N << ", "
+              << (double)N * sizeof(double) / 1e9 << " GB in " << omp_get_wtime() - t0 << " s\n";
+    return 0;
+}
+
+// --file: один проход по файлу кусками, чтение следующего куска параллельно со счётом
+static int stream_file(const std::string& path, const std::string& mode, long long chunk_mb) {
+    StreamConfig cfg;
+    cfg.mode = (mode == "mmap") ? StreamMode::Mmap : StreamMode::Read;
+    cfg.chunk_bytes = (size_t)chunk_mb << 20;
+    StreamResult r = stream_stats_file<double>(path, cfg);
+    std::cout << std::fixed << std::setprecision(6)
+              << "file=" << path << " | mode=" << (cfg.mode == StreamMode::Mmap ? "mmap" : "read")
+              << " | threads=" << omp_get_max_threads() << " | chunks=" << r.chunks
+              << " x " << chunk_mb << " MB\n"
+              << "N=" << r.m.n << " | mean=" << r.m.mean << " | var=" << r.m.variance()
+              << " | min=" << r.m.min << " | max=" << r.m.max << "\n"
+              << "time_s=" << r.seconds << " | GB/s=" << r.gbs()
+              << " | wait_io_s=" << r.wait_seconds << "\n";
+    return 0;
+}
+
+// ---------- ядра с конфигурацией из автотюнера ----------
+static const char* TUNING_FILE = "omp_tuning.txt";
+
+// sum, sumsq, min, max за один проход (упирается в память); частичные результаты по потокам
+static Stats<double> stats_tuned(const double* a, long long n, const OmpTuneConfig& c) {
+    std::vector<Stats<double>> part((size_t)std::max(1, c.threads));
+    omp_tuned_for(c, n, [&](long long b, long long e, int t) {
+        stats_merge(part[(size_t)t], stats_block(a + b, e - b, b));
+    });
+    Stats<double> s;
+    for (const auto& p : part) stats_merge(s, p);
+    return s;
+}
+
+// Многочлен 16-й степени по Горнеру в каждой точке (упирается в вычисления)
+static double poly16_tuned(const double* a, long long n, const OmpTuneConfig& c) {
+    struct alignas(64) Acc { double v = 0.0; };       // по строке кэша на поток
+    std::vector<Acc> part((size_t)std::max(1, c.threads));
+    omp_tuned_for(c, n, [&](long long b, long long e, int t) {
+        double acc = 0.0;
+        #pragma omp simd reduction(+ : acc)
+        for (long long i = b; i < e; i++) {
+            double x = a[i], y = 1.0;
+            for (int k = 0; k < 16; k++) y = y * x + 1.0 / (k + 2);
+            acc += y;
+        }
+        part[(size_t)t].v += acc;
+    });
+    double s = 0.0;
+    for (const Acc& p : part) s += p.v;
+    return s;
+}
+
+// --tune: поиск конфигурации для каждого ядра и размера 1e3 ... maxN, порог min_n,
+// модели Амдала (strong scaling на maxN) и Густафсона (weak scaling: maxN / p на поток)
+static int tune_mode(long long maxN) {
+    int maxT = omp_get_max_threads();
+    bench_set_threads(maxT);                       // привязка потоков к ядрам
+    numa_vector<double> a(maxN);
+    philox_uniform_par(a.data(), maxN, 123, 0.0, 1.0);
+    std::vector<long long> sizes;
+    for (long long n = 1000; n <= maxN; n *= 10) sizes.push_back(n);
+    if (sizes.empty() || sizes.back() != maxN) sizes.push_back(maxN);
+
+    OmpTuner tuner(TUNING_FILE);
+    std::cout << "tuning on " << tuner.host() << ", sizes 1e3.." << maxN << "\n";
+    volatile double sink = 0;
+    struct Kernel { const char* name; OmpTuner::KernelFn fn; };
+    const double* p = a.data();
+    std::vector<Kernel> kernels = {
+        {"stats", [&](const OmpTuneConfig& c, long long n) { sink = stats_tuned(p, n, c).sum; }},
+        {"poly16", [&](const OmpTuneConfig& c, long long n) { sink = poly16_tuned(p, n, c); }},
+    };
+
+    std::ofstream fit("omp_tune_fit.csv");
+    fit << "kernel,model,serial_fraction,r2,p,speedup\n";
+    std::cout << std::fixed << std::setprecision(4);
+    for (const Kernel& k : kernels) {
+        std::vector<OmpTuneResult> res = tuner.tune_kernel(k.name, sizes, k.fn);
+        std::cout << "\n[" << k.name << "] min_n=" << res.front().best.min_n << "\n";
+        for (const OmpTuneResult& r : res)
+            std::cout << "  n=" << std::setw(10) << r.n << " seq_ms=" << std::setw(10) << r.seq_ms
+                      << " best_ms=" << std::setw(10) << r.best_ms << " speedup=" << std::setw(7)
+                      << r.seq_ms / r.best_ms << " tried=" << std::setw(2) << r.tried << "  " << r.best.str() << "\n";
+
+        // Амдал: времена шага 1 (static, 1, 2, 4, ... потоков) на самом большом размере
+        const OmpTuneResult& big = res.back();
+        AmdahlFit am = omp_fit_amdahl(big.threads, big.threads_ms);
+
+        // Густафсон: на p потоках массив p * base, base = maxN / maxT
+        std::vector<int> ps;
+        std::vector<double> scaled;
+        long long base = std::max(1LL, maxN / maxT);
+        double t1 = 0;
+        for (int t : bench_thread_counts(maxT)) {
+            OmpTuneConfig c;
+            c.threads = t;
+            long long n = std::min(maxN, base * t);
+            double ms = bench_measure(k.name, "weak", n, [&] { k.fn(c, n); }, OmpTuner::quick_config()).median_ms;
+            if (t == 1) t1 = ms;
+            ps.push_back(t);
+            scaled.push_back((double)t * t1 / ms * (double)n / (double)(base * t));
+        }
+        GustafsonFit gu = omp_fit_gustafson(ps, scaled);
+
+        std::cout << "  amdahl:    serial=" << am.serial << " r2=" << am.r2
+                  << " limit=" << (am.limit() > 0 ? am.limit() : 0.0) << "\n"
+                  << "  gustafson: serial=" << gu.serial << " r2=" << gu.r2 << "\n"
+                  << "  extrapolated speedup (amdahl / gustafson):";
+        for (int pp : {maxT, 2 * maxT, 16, 64, 256}) {
+            std::cout << "  p=" << pp << ": " << std::setprecision(2) << am.speedup(pp) << " / "
+                      << gu.speedup(pp) << std::setprecision(4);
+            fit << k.name << ",amdahl," << am.serial << "," << am.r2 << "," << pp << "," << am.speedup(pp) << "\n"
+                << k.name << ",gustafson," << gu.serial << "," << gu.r2 << "," << pp << "," << gu.speedup(pp) << "\n";
+        }
+        std::cout << "\n";
+    }
+    tuner.save();
+    std::cout << "\nSaved " << TUNING_FILE << ", omp_tune_fit.csv\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+
+    // Потоковый режим для данных, которые не помещаются в память:
+    //   ./task1_openmp --gen data.bin N                     — записать N чисел в файл
+    //   ./task1_openmp --file data.bin [read|mmap] [chunk_mb] — статистика за один проход
+    if (argc > 2 && std::string(argv[1]) == "--gen")
+        return gen_file(argv[2], (argc > 3) ? std::stoll(argv[3]) : 100000000);
+    if (argc > 2 && std::string(argv[1]) == "--file")
+        return stream_file(argv[2], (argc > 3) ? argv[3] : "read", (argc > 4) ? std::stoll(argv[4]) : 64);
+    // Автотюнер: ./task1_openmp --tune [maxN] — записывает omp_tuning.txt
+    if (argc > 1 && std::string(argv[1]) == "--tune")
+        return tune_mode((argc > 2) ? std::stoll(argv[2]) : 100000000);
+
+    // Размер массива: либо из аргумента командной строки, либо по умолчанию 1e8
+    long long N = (argc > 1) ? std::stoll(argv[1]) : 100000000;
+
+    // Максимальное число потоков, доступное в системе
+    int max_threads = omp_get_max_threads();
+
+    // Выделяем память под массив: выравнивание 64 байта, большие страницы 2 МБ,
+    // первое касание параллельно теми же кусками, что у compute_stats_par —
+    // на двухсокетной машине каждый поток читает память своего узла
+    numa_vector<double> a(N);
+
+    // --- 1) Инициализация массива ---
+    // Philox: a[i] зависит только от (seed, i), поэтому заполняем всеми потоками,
+    // а данные побитово одинаковы при любом числе потоков (см. checksum)
+    double t0 = omp_get_wtime(); // старт времени
+    philox_uniform_par(a.data(), N, 123, 0.0, 1.0); // числа [0;1), seed = 123
+    double t1 = omp_get_wtime(); // конец инициализации
+
+    // Настройки красивого вывода
+    std::cout << "N=" << N << ", max_threads=" << max_threads
+              << ", simd=" << stats_isa_name(stats_isa())
+              << ", checksum=" << std::hex << philox_checksum(a.data(), N) << std::dec << "\n";
+    numa_report(a.data(), N);    // где реально лежат страницы
+    std::cout << std::fixed << std::setprecision(6);
+
+    // Время на 1 потоке (будем использовать для расчёта ускорения)
+    double T1 = 0.0;
+
+    // Все замеры складываем в общий набор (потом CSV/JSON)
+    BenchSuite suite;
+
+    // --- 2) Тестируем разные количества потоков: 1,2,4,... ---
+    for (int threads : bench_thread_counts(max_threads)) {
+
+        // Устанавливаем число потоков OpenMP (и привязываем потоки к ядрам)
+        bench_set_threads(threads);
+
+        // Один проход по массиву: sum, sumsq, min, max сразу
+        // (потоки делят массив как schedule(static), внутри — SIMD-ядро)
+        Stats<double> st;
+        const BenchResult& r = suite.add(bench_measure("sum_sumsq", "par", N, [&] {
+            st = compute_stats_par(a.data(), N);
+        }));
+        double sum = st.sum;
+        double sumsq = st.sumsq;
+
+        // Вычисляем среднее
+        double mean = sum / (double)N;
+
+        // Дисперсия: Var(x) = E[x^2] - (E[x])^2 (как в задании; при большом среднем
+        // разность почти равных чисел теряет знаки)
+        double var  = (sumsq / (double)N) - mean * mean;
+
+        // Та же дисперсия устойчиво: два прохода по кускам потоков + слияние по Чану
+        double var_stable = moments_par(a.data(), N).variance();
+
+        // Время инициализации (одинаково для всех потоков)
+        double t_init = t1 - t0;
+
+        // Время параллельных вычислений (медиана по повторам)
+        double t_calc = r.median_ms / 1000.0;
+
+        // Запоминаем время для 1 потока (нужно для speedup)
+        if (threads == 1) T1 = t_calc;
+
+        // Ускорение и эффективность
+        double S = T1 / t_calc;       // speedup = T1/Tp
+        double E = S / threads;       // efficiency = speedup/p
+
+        // Печать результатов
+        std::cout << "threads=" << threads
+                  << " | init_s=" << t_init
+                  << " | calc_s=" << t_calc
+                  << " | p99_s=" << r.p99_ms / 1000.0
+                  << " | speedup=" << S
+                  << " | eff=" << E
+                  << " | mean=" << mean
+                  << " | var=" << var
+                  << " | var_stable=" << var_stable
+                  << " | min=" << st.min
+                  << " | max=" << st.max << "\n";
+
+        // Аппаратные счётчики вычислительной фазы (только при PERF_COUNTERS=1):
+        // IPC и оценка трафика памяти рядом с ускорением
+        if (!r.perf.empty())
+            std::cout << "          ipc=" << r.perf.per_call().ipc()
+                      << " | llc_GBs=" << r.llc_gbs()
+                      << " | stream_GBs=" << (double)N * sizeof(double) / t_calc / 1e9 << "\n";
+    }
+
+    // --- 3) Конфигурация из omp_tuning.txt (после --tune) против настроек по умолчанию ---
+    bench_set_threads(max_threads);
+    OmpTuner tuner(TUNING_FILE);
+    volatile double sink = 0;
+    for (const char* kernel : {"stats", "poly16"}) {
+        OmpTuneConfig def, tuned = tuner.get(kernel, N);
+        auto run = [&](const OmpTuneConfig& c) {
+            if (std::string(kernel) == "stats") sink = stats_tuned(a.data(), N, c).sum;
+            else sink = poly16_tuned(a.data(), N, c);
+        };
+        double defMs = suite.add(bench_measure(kernel, "default", N, [&] { run(def); })).median_ms;
+        double tunedMs = suite.add(bench_measure(kernel, "tuned", N, [&] { run(tuned); })).median_ms;
+        std::cout << kernel << ": default_s=" << defMs / 1000.0 << " | tuned_s=" << tunedMs / 1000.0
+                  << " | " << (tuner.has(kernel) ? tuned.str() : "no entry in omp_tuning.txt (run --tune)") << "\n";
+    }
+
+    // Подробно: счётчики по потокам
+    suite.print_perf();
+
+    // Результаты для отслеживания регрессий
+    suite.write_csv("task1_results.csv");
+    suite.write_json("task1_results.json");
+}
@@ -0,0 +1,204 @@
+#include <mpi.h>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <cmath>
+
+#include "../common/philox.hpp" // счётчиковый генератор: каждый rank генерирует свой кусок
+#include "../common/mpi_stats.hpp" // сумма/sumsq/min/max и квантильный скетч одной редукцией (производный тип + MPI_Op)
+#include "../common/mpi_io.hpp"    // чтение своего куска общего файла (MPI-IO)
+#include "../common/mpi_hybrid.hpp" // MPI_Init_thread + потоки OpenMP на процесс
+#include <fstream>
+
+// mode: 0=strong (N_total фикс), 1=weak (local_n фикс)
+// op:   0=Reduce, 1=Allreduce, 2=Iallreduce с перекрытием: кусок массива c считается,
+//       пока по сети идёт неблокирующая редукция куска c-1
+// file: необязательный путь к файлу float — тогда каждый процесс читает свой кусок
+//       коллективно (MPI_File_read_at_all); с "write" файл сначала записывается
+//       (каждый процесс пишет свой сгенерированный кусок, MPI_File_write_at_all)
+
+int main(int argc, char** argv){
+    // гибридный режим: процесс на сокет / узел, внутри OpenMP (MPI зовёт только главный поток)
+    HybridInfo hy = hybrid_init(&argc, &argv);
+
+    int rank=0, size=1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    long long N_input = (argc > 1) ? std::stoll(argv[1]) : 5000000LL; // либо N_total, либо local_n
+    int mode = (argc > 2) ? std::stoi(argv[2]) : 0;                  // 0 strong / 1 weak
+    int op   = (argc > 3) ? std::stoi(argv[3]) : 0;                  // 0 reduce / 1 allreduce / 2 iallreduce
+    int reps = (argc > 4) ? std::stoi(argv[4]) : 5;                  // повторы для среднего
+    std::string file = (argc > 5) ? argv[5] : "";                    // "" — генерация Philox
+    bool write_file = (argc > 6) && std::string(argv[6]) == "write";
+
+    // считаем N_total
+    long long N_total = (mode == 0) ? N_input : (N_input * (long long)size);
+    if(!file.empty() && !write_file){
+        long long in_file = mpiio_file_elements<float>(file, MPI_COMM_WORLD);
+        if(in_file < N_total){
+            if(rank==0) std::cerr << file << ": only " << in_file << " floats, need " << N_total << "\n";
+            MPI_Finalize();
+            return 1;
+        }
+    }
+
+    // counts/displs: какой кусок глобального массива у какого процесса (неравномерно)
+    std::vector<int> counts(size), displs(size);
+    long long base = N_total / size, rem = N_total % size;
+    long long off = 0;
+    for(int i=0;i<size;i++){
+        long long n = base + (i < rem ? 1 : 0);
+        counts[i] = (int)n;
+        displs[i] = (int)off;
+        off += n;
+    }
+
+    // локальный массив у каждого процесса: свой кусок
+    // [displs[rank]; displs[rank] + counts[rank]) глобального массива —
+    // генерируется (Philox, seed 123) или читается из файла. В обоих случаях
+    // данные побитово те же при любом числе процессов, rank 0 ничего не рассылает.
+    std::vector<float> local(counts[rank]);
+
+    if(write_file){
+        philox_uniform_par(local.data(), counts[rank], 123, 0.f, 1.f, displs[rank]);
+        mpiio_write_slice(file, displs[rank], counts[rank], local.data(), MPI_COMM_WORLD);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double tg0 = MPI_Wtime();
+    if(file.empty())
+        philox_uniform_par(local.data(), counts[rank], 123, 0.f, 1.f, displs[rank]);
+    else
+        mpiio_read_slice(file, displs[rank], counts[rank], local.data(), MPI_COMM_WORLD);
+    double tg1 = MPI_Wtime();
+    double t_gen_local = tg1 - tg0, t_gen = 0.0;
+    MPI_Reduce(&t_gen_local, &t_gen, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    // контрольная сумма данных (не зависит от числа процессов)
+    unsigned long long cs_local = philox_checksum(local.data(), counts[rank], displs[rank]), cs = 0;
+    MPI_Reduce(&cs_local, &cs, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    double best_total = 1e30, best_comp=0, best_red=0;
+    SumStats st;              // сумма, sumsq, min, max всех элементов (для печати)
+
+    for(int r=0; r<reps; r++){
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        double t0 = MPI_Wtime();
+
+        double tc0 = 0, tc1 = 0, tr0 = 0;
+
+        if(op == 2){
+            // --- compute и Iallreduce вперемешку ---
+            // массив делится на OVERLAP_CHUNKS кусков; статистика куска c уходит
+            // в MPI_Iallreduce и "летит", пока потоки считают кусок c+1.
+            // MPI_Testall продвигает редукции (главный поток, вне parallel).
+            // time_compute_s — счёт, time_reduce_s — только ожидание в конце (не спрятанная часть)
+            const int OVERLAP_CHUNKS = 8;
+            std::vector<SumStats> part(OVERLAP_CHUNKS), part_all(OVERLAP_CHUNKS);
+            std::vector<MPI_Request> reqs(OVERLAP_CHUNKS, MPI_REQUEST_NULL);
+            long long n = (long long)local.size();
+            tc0 = MPI_Wtime();
+            for(int c=0; c<OVERLAP_CHUNKS; c++){
+                long long lo = n * c / OVERLAP_CHUNKS, hi = n * (c + 1) / OVERLAP_CHUNKS;
+                part[c] = sum_stats_par(local.data() + lo, hi - lo);
+                MPI_Iallreduce(&part[c], &part_all[c], 1, sumstats_mpi_type(), sumstats_mpi_op(),
+                               MPI_COMM_WORLD, &reqs[c]);
+                int done = 0;
+                MPI_Testall(c + 1, reqs.data(), &done, MPI_STATUSES_IGNORE);
+            }
+            tc1 = MPI_Wtime();
+            tr0 = MPI_Wtime();
+            MPI_Waitall(OVERLAP_CHUNKS, reqs.data(), MPI_STATUSES_IGNORE);
+            st = SumStats();
+            for(const auto& ps : part_all) st.merge(ps);   // в порядке кусков: результат воспроизводим
+        } else {
+            // --- compute (локально, без сети) ---
+            tc0 = MPI_Wtime();
+            // один проход: сумма и сумма квадратов компенсированные (Ноймайер) с
+            // double-накопителями по SIMD-дорожкам — данные остаются float, а точность
+            // как у double (float local_sum на 5M элементов теряет уже ~5 знаков); + min/max
+            SumStats local_st = sum_stats_par(local.data(), (long long)local.size());
+            tc1 = MPI_Wtime();
+
+            // --- Reduce / Allreduce (коммуникации) ---
+            tr0 = MPI_Wtime();
+
+            // одна коллективная операция вместо трёх: структура SumStats
+            // (производный тип) сливается пользовательской операцией MPI
+            if(op == 0){
+                // Reduce: результат только на rank 0
+                MPI_Reduce(&local_st, &st, 1, sumstats_mpi_type(), sumstats_mpi_op(), 0, MPI_COMM_WORLD);
+            } else {
+                // Allreduce: результат у всех процессов
+                MPI_Allreduce(&local_st, &st, 1, sumstats_mpi_type(), sumstats_mpi_op(), MPI_COMM_WORLD);
+            }
+        }
+
+        double tr1 = MPI_Wtime();
+        double t1  = MPI_Wtime();
+
+        double t_comp    = tc1 - tc0;
+        double t_reduce  = tr1 - tr0;
+        double t_total   = t1  - t0;
+
+        // берём лучший прогон (в Colab бывает шум)
+        if(t_total < best_total){
+            best_total = t_total;
+            best_comp = t_comp;
+            best_red = t_reduce;
+        }
+    }
+
+    // перцентили всего массива (вне замеров): скетч своего куска + одна редукция скетчей
+    MPI_Barrier(MPI_COMM_WORLD);
+    double ts0 = MPI_Wtime();
+    QuantileSketch sk_local = sketch_build_par(local.data(), (long long)local.size()), sk;
+    MPI_Reduce(&sk_local, &sk, 1, quantile_sketch_mpi_type(), quantile_sketch_mpi_op(), 0, MPI_COMM_WORLD);
+    double t_sketch = MPI_Wtime() - ts0;
+
+    // считаем долю коммуникаций
+    double comm_share = best_red / best_total;
+
+    const char* op_name = (op==0 ? "Reduce" : (op==1 ? "Allreduce" : "Iallreduce"));
+
+    // печать на rank 0 (для Reduce логично), но для Allreduce тоже ок
+    if(rank==0){
+        std::cout << "mode=" << (mode==0 ? "strong" : "weak")
+                  << " op="   << op_name
+                  << " procs="<< size
+                  << " threads="<< hy.threads
+                  << " cores="<< hy.cores()
+                  << " config="<< hy.config()
+                  << " N_total="<< N_total
+                  << " local_n~="<< counts[rank]
+                  << " time_total_s="<< best_total
+                  << (file.empty() ? " time_gen_s=" : " time_read_s=")<< t_gen
+                  << " time_compute_s="<< best_comp
+                  << " time_reduce_s="<< best_red
+                  << " comm_share="<< comm_share
+                  << " mean="<< st.mean()
+                  << " stddev="<< std::sqrt(st.variance())
+                  << " min="<< st.min
+                  << " max="<< st.max
+                  << " p50="<< sk.quantile(0.5)
+                  << " p99="<< sk.quantile(0.99)
+                  << " time_sketch_s="<< t_sketch
+                  << " checksum="<< std::hex << cs << std::dec
+                  << "\n";
+
+        // строка в task4_results.csv (дописывается): отчёт strong / weak scaling,
+        // чистый MPI и гибрид на одинаковом числе ядер сравниваются по cores
+        bool fresh = !std::ifstream("task4_results.csv").good();
+        std::ofstream csv("task4_results.csv", std::ios::app);
+        if(fresh) csv << "mode,op,config,procs,threads,cores,N_total,time_total_s,time_compute_s,time_reduce_s,comm_share\n";
+        csv << (mode==0 ? "strong" : "weak") << "," << op_name << "," << hy.config() << ","
+            << size << "," << hy.threads << "," << hy.cores() << "," << N_total << ","
+            << best_total << "," << best_comp << "," << best_red << "," << comm_share << "\n";
+    }
+
+    MPI_Finalize();
+    return 0;
+}
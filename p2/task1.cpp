@@ -1,7 +1,14 @@
 #include <iostream>    // ввод и вывод (cout, cin)
 #include <cstdlib>     // rand(), srand()
 #include <ctime>       // time() для генерации seed
-#include <chrono>      // высокоточный замер времени
+#include <string>      // выбор алгоритмов из командной строки
+#include <algorithm>   // max
+
+#include "../common/bench.hpp"     // общий бенчмарк (повторы, медиана)
+#include "../common/numa_alloc.hpp" // массивы с параллельным первым касанием
+#include "../common/par_stats.hpp" // однопроходная SIMD-редукция (min/argmin и т.д.)
+#include "../common/par_sort.hpp"  // параллельная сортировка слиянием (merge-path)
+#include "../common/radix_sort.hpp" // параллельная LSD radix-сортировка
 
 #ifdef _OPENMP
 #include <omp.h>       // библиотека OpenMP (потоки, reduction и т.д.)
@@ -11,10 +18,18 @@ using namespace std;   // чтобы не писать std::
 
 // ==================== ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ ====================
 
+int maxValue = 100000;                   // верхняя граница значений (второй аргумент программы)
+string algos = "all";                    // какие сортировки запускать (первый аргумент программы)
+
+// Выбрана ли сортировка name: "all" или имя есть в списке через запятую
+bool enabled(const string& name) {
+    return algos == "all" || algos.find(name) != string::npos;
+}
+
 // Заполняем массив случайными числами
 void fillArray(int* a, int n) {          // a — указатель на массив, n — размер
     for (int i = 0; i < n; i++) {        // проходим по всем элементам
-        a[i] = rand() % 100000 + 1;      // случайное число от 1 до 100000
+        a[i] = rand() % maxValue + 1;    // случайное число от 1 до maxValue
     }
 }
 
@@ -33,22 +48,18 @@ bool isSorted(const int* a, int n) {
     return true;                          // если нарушений нет — OK
 }
 
-// Структура для хранения минимума и его индекса
-struct MinPair {
-    int val;                              // значение элемента
-    int idx;                              // индекс элемента
-};
-
-// reduction для MinPair: выбираем пару с минимальным val
-#pragma omp declare reduction( \
-    minpair : MinPair : \
-    omp_out = (omp_in.val < omp_out.val ? omp_in : omp_out) \
-) initializer(omp_priv = omp_orig)
-
-// Функция для удобного подсчёта времени в миллисекундах
-long long diffMs(chrono::high_resolution_clock::time_point start,
-                 chrono::high_resolution_clock::time_point end) {
-    return chrono::duration_cast<chrono::milliseconds>(end - start).count();
+// Замер одной сортировки общим бенчмарком (common/bench.hpp).
+// Перед каждым запуском work заново копируется из original (копирование не входит во время);
+// без прогрева: долгие O(n^2) прогоны выполняются один раз, короткие — повторяются
+BenchResult timeSort(const char* name, const char* variant, void (*sortFn)(int*, int),
+                     const int* original, int* work, int n) {
+    BenchConfig cfg;
+    cfg.warmup = 0;                       // первый запуск сразу идёт в выборку
+    cfg.min_reps = 1;                     // длинная сортировка — достаточно одного
+    cfg.min_time_s = 0.5;                 // короткие повторяем, пока не наберём 0.5 с
+    return bench_measure(name, variant, n,
+                         [&] { sortFn(work, n); },
+                         [&] { copyArray(original, work, n); }, cfg);
 }
 
 // ==================== ПОСЛЕДОВАТЕЛЬНЫЕ СОРТИРОВКИ ====================
@@ -121,109 +132,120 @@ void bubblePar(int* a, int n) {
 
 // Параллельная сортировка выбором
 void selectionPar(int* a, int n) {
-#ifdef _OPENMP
     for (int i = 0; i < n - 1; i++) {           // позиция минимума
-        MinPair best{a[i], i};                  // текущий минимум
-
-        #pragma omp parallel for reduction(minpair: best)
-        for (int j = i + 1; j < n; j++) {       // поиск минимума параллельно
-            if (a[j] < best.val) {
-                best = MinPair{a[j], j};
-            }
-        }
+        // Поиск минимума справа от i: потоки + SIMD, argmin — первый минимум
+        // (если минимум уже стоит в a[i], вернётся индекс i)
+        long long minIdx = i + compute_stats_par(a + i, n - i).argmin;
 
-        if (best.idx != i) {                    // меняем найденный минимум
+        if (minIdx != i) {                      // меняем найденный минимум
             int tmp = a[i];
-            a[i] = a[best.idx];
-            a[best.idx] = tmp;
+            a[i] = a[minIdx];
+            a[minIdx] = tmp;
         }
     }
-#else
-    selectionSeq(a, n);                         // fallback без OpenMP
-#endif
 }
 
 // Insertion Sort не распараллеливается,
 // потому что каждый шаг зависит от предыдущего
 // (левая часть массива должна быть уже отсортирована).
 
-// ==================== ТЕСТИРОВАНИЕ И СРАВНЕНИЕ ====================
-
-void testOneSize(int n) {
-    cout << "\n--- Размер массива: " << n << " ---\n";
-
-    int* original = new int[n];                 // исходный массив
-    fillArray(original, n);                     // заполняем случайными числами
+// Сортировка слиянием: O(n log n), листья — std::sort,
+// половины сортируются задачами OpenMP, слияние делится по merge-path
+void mergeSeq(int* a, int n) {
+    merge_sort(a, n);
+}
 
-    // ---------- Bubble ----------
-    {
-        int* seqArr = new int[n];
-        int* parArr = new int[n];
-        copyArray(original, seqArr, n);
-        copyArray(original, parArr, n);
+void mergePar(int* a, int n) {
+    merge_sort_par(a, n);
+}
 
-        auto s1 = chrono::high_resolution_clock::now();
-        bubbleSeq(seqArr, n);
-        auto e1 = chrono::high_resolution_clock::now();
+// LSD radix-сортировка: не сравнивает элементы, сортирует по разрядам.
+// Диапазон ключей проверяется заранее: для 1..100 это один проход подсчётом
+void radixSeq(int* a, int n) {
+    radix_sort(a, n);
+}
 
-        auto s2 = chrono::high_resolution_clock::now();
-        bubblePar(parArr, n);
-        auto e2 = chrono::high_resolution_clock::now();
+void radixPar(int* a, int n) {
+    radix_sort_par(a, n);
+}
 
-        cout << "Bubble    seq: " << diffMs(s1, e1)
-             << " ms | par: " << diffMs(s2, e2)
-             << (isSorted(parArr, n) ? " | OK\n" : " | ERROR\n");
+// ==================== ТЕСТИРОВАНИЕ И СРАВНЕНИЕ ====================
 
-        delete[] seqArr;
-        delete[] parArr;
-    }
+// O(n^2) сортировки дальше этого размера не запускаем (часы работы)
+const int QUADRATIC_MAX_N = 100000;
 
-    // ---------- Selection ----------
-    {
-        int* seqArr = new int[n];
-        int* parArr = new int[n];
-        copyArray(original, seqArr, n);
-        copyArray(original, parArr, n);
+// Строка таблицы: seq и par на одинаковых данных, время — медиана в мс
+void compareSorts(const char* label, const char* name,
+                  void (*seqFn)(int*, int), void (*parFn)(int*, int),
+                  const int* original, int n) {
+    int* seqArr = numa_alloc_array<int>(n);     // первое касание параллельно (см. common/numa_alloc.hpp)
+    int* parArr = numa_alloc_array<int>(n);
 
-        auto s1 = chrono::high_resolution_clock::now();
-        selectionSeq(seqArr, n);
-        auto e1 = chrono::high_resolution_clock::now();
+    BenchResult seq = timeSort(name, "seq", seqFn, original, seqArr, n);
+    BenchResult par = timeSort(name, "par", parFn, original, parArr, n);
 
-        auto s2 = chrono::high_resolution_clock::now();
-        selectionPar(parArr, n);
-        auto e2 = chrono::high_resolution_clock::now();
+    cout << label << " seq: " << seq.median_ms
+         << " ms | par: " << par.median_ms
+         << ((isSorted(seqArr, n) && isSorted(parArr, n)) ? " | OK\n" : " | ERROR\n");
 
-        cout << "Selection seq: " << diffMs(s1, e1)
-             << " ms | par: " << diffMs(s2, e2)
-             << (isSorted(parArr, n) ? " | OK\n" : " | ERROR\n");
+    // Аппаратные счётчики на одну сортировку (только при PERF_COUNTERS=1)
+    perf_print(seq.perf);
+    perf_print(par.perf);
 
-        delete[] seqArr;
-        delete[] parArr;
-    }
-
-    // ---------- Insertion ----------
-    {
-        int* seqArr = new int[n];
-        copyArray(original, seqArr, n);
+    numa_free(seqArr, n);
+    numa_free(parArr, n);
+}
 
-        auto s1 = chrono::high_resolution_clock::now();
-        insertionSeq(seqArr, n);
-        auto e1 = chrono::high_resolution_clock::now();
+void testOneSize(int n) {
+    cout << "\n--- Размер массива: " << n << " ---\n";
 
-        cout << "Insertion seq: " << diffMs(s1, e1)
-             << " ms | par: N/A (not parallelized) "
-             << (isSorted(seqArr, n) ? "| OK\n" : "| ERROR\n");
+    int* original = numa_alloc_array<int>(n);   // исходный массив
+    fillArray(original, n);                     // заполняем случайными числами
 
-        delete[] seqArr;
+    bool quadratic = enabled("bubble") || enabled("selection") || enabled("insertion");
+    if (!quadratic) {
+        // O(n^2) сортировки не выбраны
+    } else if (n > QUADRATIC_MAX_N) {
+        cout << "Bubble/Selection/Insertion: skipped (O(n^2), n > "
+             << QUADRATIC_MAX_N << ")\n";
+    } else {
+        if (enabled("bubble"))
+            compareSorts("Bubble   ", "bubble", bubbleSeq, bubblePar, original, n);
+        if (enabled("selection"))
+            compareSorts("Selection", "selection", selectionSeq, selectionPar, original, n);
+
+        // ---------- Insertion ----------
+        if (enabled("insertion")) {
+            int* seqArr = numa_alloc_array<int>(n);
+            BenchResult seq = timeSort("insertion", "seq", insertionSeq, original, seqArr, n);
+
+            cout << "Insertion seq: " << seq.median_ms
+                 << " ms | par: N/A (not parallelized) "
+                 << (isSorted(seqArr, n) ? "| OK\n" : "| ERROR\n");
+            perf_print(seq.perf);
+
+            numa_free(seqArr, n);
+        }
     }
 
-    delete[] original;                          // освобождаем память
+    if (enabled("merge"))
+        compareSorts("Merge    ", "merge", mergeSeq, mergePar, original, n);
+    if (enabled("radix"))
+        compareSorts("Radix    ", "radix", radixSeq, radixPar, original, n);
+
+    numa_free(original, n);                     // освобождаем память
 }
 
-int main() {
+// Запуск: ./task1 [algos] [maxValue]
+//   algos    — "all" или список через запятую: bubble,selection,insertion,merge,radix
+//   maxValue — значения будут в диапазоне 1..maxValue (по умолчанию 100000)
+int main(int argc, char** argv) {
     ios::sync_with_stdio(false);               // ускоряем ввод/вывод
     cin.tie(nullptr);                          // отключаем привязку cin к cout
 
+    if (argc > 1) algos = argv[1];             // выбор сортировок
+    if (argc > 2) maxValue = max(1, atoi(argv[2])); // диапазон значений
+
     srand((unsigned)time(nullptr));            // seed для rand()
 
 #ifdef _OPENMP
@@ -233,7 +255,8 @@ int main() {
     cout << "OpenMP отключён (компиляция без -fopenmp)\n";
 #endif
 
-    int sizes[] = {1000, 10000, 100000};       // размеры массивов для тестов
+    int sizes[] = {1000, 10000, 100000,        // размеры массивов для тестов
+                   1000000, 10000000, 100000000}; // большие — только O(n log n)
     for (int n : sizes) {
         testOneSize(n);                        // запускаем тесты
     }
@@ -0,0 +1,417 @@
+// sort_pipeline_cpu.cpp
+// CPU-версия конвейера gpu_sort_chunk_and_merge из main.cu: сортировка чанков
+// (bitonic / quick / heap — выбирается как mode) и попарное слияние CHUNK -> 2CHUNK -> ...
+// Два способа выполнить один и тот же конвейер:
+//   phased — как на GPU: omp for по чанкам, потом omp for по слияниям каждого уровня,
+//            после каждой стадии барьер (неравные по времени чанки оставляют ядра без работы);
+//   ws     — граф задач на планировщике с кражей работы (common/work_stealing.hpp):
+//            слияние пары стартует, как только отсортированы оба его входа.
+// Большие слияния режутся на куски по диагоналям merge-path (то же, что бинарный поиск
+// в mergePairsSimple, но на кусок выхода, а не на каждый элемент) — куски одинаковые
+// в обоих способах, отличается только синхронизация.
+// dist=skewed: каждый 4-й чанк уже отсортирован — quick с опорным последним элементом
+// (как device_quick_sort) на нём вырождается в O(CHUNK^2), чанки становятся неравными.
+// Для ws печатаются задачи, кражи и загрузка каждого рабочего.
+//
+// ./sort_pipeline_cpu [mode=all|merge|quick|heap] [n=0 -> 10000,100000,1000000]
+//                     [chunk=4096] [workers=ядра] [dist=random|skewed] [reps=5]
+
+#include <algorithm>   // sort, swap, min, max, copy
+#include <climits>     // INT_MAX
+#include <cstdlib>     // atoi, atoll
+#include <fstream>     // CSV
+#include <iomanip>     // setw
+#include <iostream>
+#include <random>      // mt19937 — те же данные, что в main.cu
+#include <string>
+#include <thread>      // hardware_concurrency
+#include <vector>
+
+#include <omp.h>
+
+#include "../common/work_stealing.hpp"  // TaskGraph, WsRunStats
+#include "../common/par_sort.hpp"       // merge_path_partition
+#include "../common/bench.hpp"          // bench_now_s, bench_set_threads, bench_percentile
+
+// режим: какой алгоритм сортировки чанков использовать (как GpuMode в main.cu)
+enum CpuMode { CPU_MERGE = 1, CPU_QUICK = 2, CPU_HEAP = 3 };
+
+static const char* mode_name(int mode) {
+    return mode == CPU_MERGE ? "merge" : (mode == CPU_QUICK ? "quick" : "heap");
+}
+
+// ============================================================
+// 1) Сортировка одного чанка (CPU-порты ядер из main.cu)
+// ============================================================
+
+// bitonicSortChunks: та же сеть сравнений; tid пробегается циклом, а не потоками.
+// s — рабочий буфер на chunk элементов (chunk — степень двойки), хвост = INT_MAX
+static void bitonic_sort_chunk(int* a, int len, int chunk, int* s) {
+    for (int i = 0; i < chunk; i++) s[i] = (i < len) ? a[i] : INT_MAX;
+    for (int k = 2; k <= chunk; k <<= 1) {
+        for (int j = k >> 1; j > 0; j >>= 1) {
+            for (int tid = 0; tid < chunk; tid++) {
+                int ixj = tid ^ j;
+                if (ixj > tid) {
+                    bool up = ((tid & k) == 0);
+                    int x = s[tid], y = s[ixj];
+                    if ((up && x > y) || (!up && x < y)) { s[tid] = y; s[ixj] = x; }
+                }
+            }
+        }
+    }
+    for (int i = 0; i < len; i++) a[i] = s[i];
+}
+
+// device_quick_sort: итеративно, опорный — последний элемент.
+// Стек — vector (на GPU было int L[64], R[64] — на вырожденных данных переполняется)
+static void quick_sort_chunk(int* a, int n, std::vector<int>& st) {
+    st.clear();
+    st.push_back(0); st.push_back(n - 1);
+    while (!st.empty()) {
+        int r = st.back(); st.pop_back();
+        int l = st.back(); st.pop_back();
+        if (l >= r) continue;
+        int pivot = a[r];
+        int i = l;
+        for (int j = l; j < r; j++) {
+            if (a[j] <= pivot) { std::swap(a[i], a[j]); i++; }
+        }
+        std::swap(a[i], a[r]);
+        if (i - 1 > l) { st.push_back(l); st.push_back(i - 1); }
+        if (i + 1 < r) { st.push_back(i + 1); st.push_back(r); }
+    }
+}
+
+// device_heapify / device_heap_sort
+static void heapify(int* a, int n, int i) {
+    while (true) {
+        int largest = i;
+        int L = 2 * i + 1, R = 2 * i + 2;
+        if (L < n && a[L] > a[largest]) largest = L;
+        if (R < n && a[R] > a[largest]) largest = R;
+        if (largest == i) break;
+        std::swap(a[i], a[largest]);
+        i = largest;
+    }
+}
+
+static void heap_sort_chunk(int* a, int n) {
+    for (int i = n / 2 - 1; i >= 0; i--) heapify(a, n, i);
+    for (int i = n - 1; i > 0; i--) {
+        std::swap(a[0], a[i]);
+        heapify(a, i, 0);
+    }
+}
+
+// Сортировка чанка c выбранным mode; буферы — свои у каждого потока
+static void sort_chunk(int* d, int n, int chunk, int c, int mode) {
+    thread_local std::vector<int> scratch;
+    thread_local std::vector<int> st;
+    int start = c * chunk;
+    int len = std::min(chunk, n - start);
+    if (mode == CPU_MERGE) {
+        if ((int)scratch.size() < chunk) scratch.resize((size_t)chunk);
+        bitonic_sort_chunk(d + start, len, chunk, scratch.data());
+    } else if (mode == CPU_QUICK) {
+        quick_sort_chunk(d + start, len, st);
+    } else {
+        heap_sort_chunk(d + start, len);
+    }
+}
+
+// ============================================================
+// 2) Описание конвейера: стадии и куски слияния
+// ============================================================
+
+// Кусок слияния пары [left0, mid0) + [mid0, right0) уровня level: позиции выхода [k0, k1)
+struct MergePiece {
+    int level;
+    int left0, mid0, right0;
+    int k0, k1;
+};
+
+// Уровень слияния: куски и для каждой пары — номера её кусков
+struct MergeLevel {
+    int run;                                  // длина входных отсортированных отрезков
+    std::vector<MergePiece> pieces;
+    std::vector<std::vector<int>> pair_pieces;
+};
+
+struct Pipeline {
+    int n = 0, chunk = 0, chunks = 0;
+    std::vector<MergeLevel> levels;
+};
+
+// run = chunk, 2chunk, ... как while (run < n) в gpu_sort_chunk_and_merge;
+// пара длиннее grain режется на куски по grain элементов выхода
+static Pipeline make_pipeline(int n, int chunk, int grain) {
+    Pipeline p;
+    p.n = n;
+    p.chunk = chunk;
+    p.chunks = (n + chunk - 1) / chunk;
+    int level = 0;
+    for (long long run = chunk; run < n; run *= 2, level++) {
+        MergeLevel L;
+        L.run = (int)run;
+        int pairs = (int)((n + 2 * run - 1) / (2 * run));
+        for (int pr = 0; pr < pairs; pr++) {
+            long long left0 = (long long)pr * 2 * run;
+            int mid0 = (int)std::min<long long>(left0 + run, n);
+            int right0 = (int)std::min<long long>(left0 + 2 * run, n);
+            int total = right0 - (int)left0;
+            int parts = std::max(1, (total + grain - 1) / grain);
+            std::vector<int> ids;
+            for (int q = 0; q < parts; q++) {
+                MergePiece m;
+                m.level = level;
+                m.left0 = (int)left0; m.mid0 = mid0; m.right0 = right0;
+                m.k0 = (int)((long long)total * q / parts);
+                m.k1 = (int)((long long)total * (q + 1) / parts);
+                ids.push_back((int)L.pieces.size());
+                L.pieces.push_back(m);
+            }
+            L.pair_pieces.push_back(ids);
+        }
+        p.levels.push_back(L);
+    }
+    return p;
+}
+
+// Буфер уровня: читаем из buf[level % 2], пишем в buf[(level + 1) % 2] (ping-pong как in/out)
+static void run_piece(int* const buf[2], const MergePiece& m) {
+    const int* in = buf[m.level % 2];
+    int* out = buf[(m.level + 1) % 2];
+    const int* A = in + m.left0;
+    const int* B = in + m.mid0;
+    long long aN = m.mid0 - m.left0, bN = m.right0 - m.mid0;
+    long long a0 = merge_path_partition(A, aN, B, bN, (long long)m.k0);
+    long long a1 = merge_path_partition(A, aN, B, bN, (long long)m.k1);
+    std::merge(A + a0, A + a1, B + (m.k0 - a0), B + (m.k1 - a1), out + m.left0 + m.k0);
+}
+
+// Кусок копирования результата обратно в d (если он остался в temp)
+static void copy_back(const int* from, int* to, int n, int q, int parts) {
+    int b = (int)((long long)n * q / parts), e = (int)((long long)n * (q + 1) / parts);
+    std::copy(from + b, from + e, to + b);
+}
+
+// ============================================================
+// 3) Два исполнителя одного конвейера
+// ============================================================
+
+// phased: стадии по очереди, барьер после каждой (неявный в конце omp for).
+// busy — время в работе по потокам (для загрузки)
+static double run_phased(const Pipeline& p, int* d, int* temp, int mode, int workers, int grain,
+                         std::vector<double>& busy) {
+    int* buf[2] = {d, temp};
+    busy.assign((size_t)workers, 0.0);
+    bool inTemp = (p.levels.size() % 2) == 1;
+    int copyParts = std::max(1, (p.n + grain - 1) / grain);
+    double t0 = bench_now_s();
+    #pragma omp parallel num_threads(workers)
+    {
+        int t = omp_get_thread_num();
+        double my = 0;
+        #pragma omp for schedule(static)
+        for (int c = 0; c < p.chunks; c++) {
+            double c0 = bench_now_s();
+            sort_chunk(d, p.n, p.chunk, c, mode);
+            my += bench_now_s() - c0;
+        }
+        for (const MergeLevel& L : p.levels) {
+            #pragma omp for schedule(static)
+            for (int i = 0; i < (int)L.pieces.size(); i++) {
+                double c0 = bench_now_s();
+                run_piece(buf, L.pieces[(size_t)i]);
+                my += bench_now_s() - c0;
+            }
+        }
+        if (inTemp) {
+            #pragma omp for schedule(static)
+            for (int q = 0; q < copyParts; q++) {
+                double c0 = bench_now_s();
+                copy_back(temp, d, p.n, q, copyParts);
+                my += bench_now_s() - c0;
+            }
+        }
+        busy[(size_t)t] = my;
+    }
+    return (bench_now_s() - t0) * 1e3;
+}
+
+// ws: тот же конвейер как граф задач. Узел "отрезок готов" — задача сортировки чанка
+// (уровень 0) или пустая задача-соединитель после кусков пары (если кусков больше одного)
+static TaskGraph build_graph(const Pipeline& p, int* d, int* temp, int mode, int grain) {
+    TaskGraph g;
+    int n = p.n, chunk = p.chunk;
+    std::vector<int> ready;                          // номер задачи "отрезок готов" по отрезкам уровня
+    for (int c = 0; c < p.chunks; c++)
+        ready.push_back(g.add([=] { sort_chunk(d, n, chunk, c, mode); }));
+
+    for (const MergeLevel& L : p.levels) {
+        std::vector<int> next;
+        for (size_t pr = 0; pr < L.pair_pieces.size(); pr++) {
+            // входы пары — отрезки 2*pr и 2*pr+1 (последний может быть без пары)
+            std::vector<int> deps = {ready[2 * pr]};
+            if (2 * pr + 1 < ready.size()) deps.push_back(ready[2 * pr + 1]);
+            std::vector<int> pieces;
+            for (int i : L.pair_pieces[pr]) {
+                MergePiece m = L.pieces[(size_t)i];
+                pieces.push_back(g.add([=] {
+                    int* buf[2] = {d, temp};
+                    run_piece(buf, m);
+                }, deps));
+            }
+            next.push_back(pieces.size() == 1 ? pieces[0] : g.add([] {}, pieces));
+        }
+        ready.swap(next);
+    }
+    // если результат в temp — копируем назад кусками, как только готов весь массив
+    if (p.levels.size() % 2 == 1) {
+        int parts = std::max(1, (n + grain - 1) / grain);
+        for (int q = 0; q < parts; q++)
+            g.add([=] { copy_back(temp, d, n, q, parts); }, {ready[0]});
+    }
+    return g;
+}
+
+// ============================================================
+// 4) Бенчмарк: phased vs work stealing
+// ============================================================
+
+struct PipelineResult {
+    int n = 0, mode = 0;
+    double phasedMs = 0, wsMs = 0;
+    double phasedUtil = 0, wsUtil = 0;     // средняя загрузка рабочих
+    bool okPhased = false, okWs = false;
+    WsRunStats ws;                         // статистика последнего запуска ws
+};
+
+static double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    return bench_percentile(v, 0.5);
+}
+
+int main(int argc, char** argv) {
+    std::string modeArg = (argc > 1) ? argv[1] : "all";
+    long long nArg = (argc > 2) ? std::atoll(argv[2]) : 0;
+    int chunk = (argc > 3) ? std::atoi(argv[3]) : 4096;
+    int workers = (argc > 4) ? std::atoi(argv[4]) : (int)std::thread::hardware_concurrency();
+    std::string dist = (argc > 5) ? argv[5] : "random";
+    int reps = (argc > 6) ? std::max(1, std::atoi(argv[6])) : 5;
+    workers = std::max(1, workers);
+
+    // bitonic-сети нужна степень двойки
+    int c2 = 2;
+    while (c2 < chunk) c2 <<= 1;
+    chunk = c2;
+    const int grain = std::max(chunk, 1 << 16);   // кусок слияния / копирования
+
+    std::vector<int> modes;
+    if (modeArg == "merge") modes = {CPU_MERGE};
+    else if (modeArg == "quick") modes = {CPU_QUICK};
+    else if (modeArg == "heap") modes = {CPU_HEAP};
+    else modes = {CPU_MERGE, CPU_QUICK, CPU_HEAP};
+
+    std::vector<int> sizes = {10000, 100000, 1000000};   // как в main.cu
+    if (nArg > 0) sizes = {(int)nArg};
+
+    std::cout << "chunk=" << chunk << " workers=" << workers << " dist=" << dist << " reps=" << reps
+              << " (hardware " << std::thread::hardware_concurrency() << ")\n";
+    bench_set_threads(workers);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> udist(0, 1000000);
+    std::vector<PipelineResult> results;
+
+    for (int N : sizes) {
+        std::vector<int> base((size_t)N);
+        for (int i = 0; i < N; i++) base[(size_t)i] = udist(rng);
+        if (dist == "skewed")
+            for (int s = 0; s < N; s += 4 * chunk)
+                std::sort(base.begin() + s, base.begin() + std::min(N, s + chunk));
+        std::vector<int> ref = base;
+        std::sort(ref.begin(), ref.end());
+
+        Pipeline p = make_pipeline(N, chunk, grain);
+        std::vector<int> d((size_t)N), temp((size_t)N);
+
+        for (int mode : modes) {
+            PipelineResult r;
+            r.n = N;
+            r.mode = mode;
+
+            // phased (+ прогрев)
+            std::vector<double> times, busy;
+            r.okPhased = true;
+            for (int rep = 0; rep <= reps; rep++) {
+                d = base;
+                double ms = run_phased(p, d.data(), temp.data(), mode, workers, grain, busy);
+                if (rep > 0) times.push_back(ms);
+                r.okPhased = r.okPhased && (d == ref);
+            }
+            r.phasedMs = median(times);
+            double sumBusy = 0;
+            for (double b : busy) sumBusy += b;
+            r.phasedUtil = sumBusy * 1e3 / (times.back() * workers);
+
+            // work stealing: граф строится один раз, данные те же (d / temp)
+            TaskGraph g = build_graph(p, d.data(), temp.data(), mode, grain);
+            times.clear();
+            r.okWs = true;
+            for (int rep = 0; rep <= reps; rep++) {
+                d = base;                                  // тот же буфер — лямбды держат указатели
+                r.ws = g.run(workers);
+                if (rep > 0) times.push_back(r.ws.wall_s * 1e3);
+                r.okWs = r.okWs && (d == ref);
+            }
+            r.wsMs = median(times);
+            double u = 0;
+            for (size_t w = 0; w < r.ws.workers.size(); w++) u += r.ws.utilisation(w);
+            r.wsUtil = u / (double)r.ws.workers.size();
+            results.push_back(r);
+
+            // ---------- вывод ----------
+            std::cout << "\nN = " << N << ", mode = " << mode_name(mode) << ", tasks = " << g.size() << "\n";
+            std::cout << std::fixed << std::setprecision(3);
+            std::cout << "  phased (omp for + barriers): " << std::setw(9) << r.phasedMs << " ms | "
+                      << (r.okPhased ? "OK" : "ERROR") << " | avg util " << std::setprecision(1)
+                      << 100.0 * r.phasedUtil << "%\n" << std::setprecision(3);
+            std::cout << "  work stealing:               " << std::setw(9) << r.wsMs << " ms | "
+                      << (r.okWs ? "OK" : "ERROR") << " | avg util " << std::setprecision(1)
+                      << 100.0 * r.wsUtil << "% | steals " << r.ws.total_steals() << "\n";
+            std::cout << "  speedup (phased/ws): " << std::setprecision(2) << r.phasedMs / r.wsMs << "x\n";
+            std::cout << "  worker  tasks  steals  attempts   busy_ms   util\n";
+            for (size_t w = 0; w < r.ws.workers.size(); w++) {
+                const WsWorkerStats& s = r.ws.workers[w];
+                std::cout << "  " << std::setw(6) << w << std::setw(7) << s.tasks << std::setw(8) << s.steals
+                          << std::setw(10) << s.steal_attempts << std::setprecision(3) << std::setw(10)
+                          << s.busy_s * 1e3 << std::setprecision(1) << std::setw(6)
+                          << 100.0 * r.ws.utilisation(w) << "%\n";
+            }
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+
+    // ---------- CSV ----------
+    std::ofstream csv("sort_pipeline_cpu.csv");
+    csv << "n,mode,dist,chunk,workers,phased_ms,ws_ms,phased_util,ws_util,ws_steals,ok\n";
+    for (const PipelineResult& r : results)
+        csv << r.n << "," << mode_name(r.mode) << "," << dist << "," << chunk << "," << workers << ","
+            << r.phasedMs << "," << r.wsMs << "," << r.phasedUtil << "," << r.wsUtil << ","
+            << r.ws.total_steals() << "," << ((r.okPhased && r.okWs) ? 1 : 0) << "\n";
+    std::ofstream wcsv("sort_pipeline_workers.csv");
+    wcsv << "n,mode,worker,tasks,steals,steal_attempts,busy_ms,util\n";
+    for (const PipelineResult& r : results)
+        for (size_t w = 0; w < r.ws.workers.size(); w++) {
+            const WsWorkerStats& s = r.ws.workers[w];
+            wcsv << r.n << "," << mode_name(r.mode) << "," << w << "," << s.tasks << "," << s.steals << ","
+                 << s.steal_attempts << "," << s.busy_s * 1e3 << "," << r.ws.utilisation(w) << "\n";
+        }
+    std::cout << "\nSaved sort_pipeline_cpu.csv, sort_pipeline_workers.csv\n";
+
+    bool allOk = true;
+    for (const PipelineResult& r : results) allOk = allOk && r.okPhased && r.okWs;
+    return allOk ? 0 : 1;
+}
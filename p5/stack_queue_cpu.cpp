@@ -0,0 +1,225 @@
+// stack_queue_cpu.cpp
+// CPU-аналог stack_queue_bench.cu: очередь и стек для стадий производитель / потребитель.
+// В GPU-версии очередь работает только в две фазы (сначала все enqueue, потом все dequeue):
+// dequeue читает *tail без атомарности, а откат head / tail через atomicSub ломается,
+// если enqueue и dequeue идут одновременно. Здесь производители и потребители работают
+// одновременно, структуры — из common/lockfree.hpp:
+//   mpmc        — кольцевая очередь с номером seq в каждой ячейке
+//   treiber     — стек Трайбера на пуле узлов, вершина с тегом (без ABA)
+//   mutex_queue / mutex_stack — то же под std::mutex (база)
+// Для каждой структуры, размера пакета (1 и BATCH) и числа производителей / потребителей:
+// пропускная способность (млн элементов/с) и задержка одного вызова push / pop
+// (p50 / p99 / p99.9, каждый LAT_EVERY-й вызов, включая повторы при полной / пустой структуре).
+// Проверка: все элементы получены ровно по разу (количество, сумма, сумма квадратов);
+// у очередей — порядок FIFO: каждый потребитель видит элементы одного производителя по возрастанию.
+//
+// ./stack_queue_cpu [ops_per_producer] [max_threads] [capacity]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#include "../common/lockfree.hpp"  // MpmcQueue, TreiberStack, MutexQueue, MutexStack
+#include "../common/bench.hpp"     // bench_set_threads (привязка к ядрам), bench_percentile
+
+const int BATCH = 16;              // размер пакета для *_batch
+const int LAT_EVERY = 16;          // задержку меряем у каждого 16-го вызова
+
+struct RunResult {
+    std::string name;
+    int producers = 0, consumers = 0, batch = 1;
+    double mops = 0;               // млн элементов в секунду (push + pop одного элемента = 1)
+    double push_p50 = 0, push_p99 = 0, push_p999 = 0;   // нс на вызов
+    double pop_p50 = 0, pop_p99 = 0, pop_p999 = 0;
+    bool ok = false;
+};
+
+// элемент: номер производителя в старших битах, порядковый номер — в младших
+static inline uint64_t encode(int p, long long i) { return ((uint64_t)p << 40) | (uint64_t)i; }
+
+// ожидание при полной / пустой структуре: сначала крутимся, потом уступаем ядро
+// (потоков может быть больше, чем ядер)
+static inline void backoff(int& spins) {
+    if (++spins < 64) return;
+    std::this_thread::yield();
+}
+
+static inline long long now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename S>
+static RunResult run_one(const std::string& name, bool fifo, int P, int C, int batch,
+                         long long ops, size_t cap) {
+    S s(cap);
+    const long long total = (long long)P * ops;
+    std::atomic<long long> consumed{0};
+    int T = P + C;
+
+    std::vector<std::vector<double>> lat(T);              // выборки задержек по потокам
+    std::vector<uint64_t> sum(T, 0), sumsq(T, 0);         // контрольные суммы потребителей
+    std::vector<long long> cnt(T, 0);
+    std::vector<int> order_ok(T, 1);
+
+    bench_set_threads(T);
+    double t0 = bench_now_s();
+    #pragma omp parallel num_threads(T)
+    {
+        int t = omp_get_thread_num();
+        std::vector<uint64_t> buf(batch);
+        std::vector<double>& my_lat = lat[t];
+        my_lat.reserve((size_t)(ops / batch / LAT_EVERY + 16));
+        long long calls = 0;
+
+        if (t < P) {
+            // производитель: ops элементов пакетами по batch
+            for (long long i = 0; i < ops; i += batch) {
+                int k = (int)std::min<long long>(batch, ops - i);
+                for (int j = 0; j < k; ++j) buf[j] = encode(t, i + j);
+                bool sample = (calls++ % LAT_EVERY) == 0;
+                long long c0 = sample ? now_ns() : 0;
+                int done = 0, spins = 0;
+                while (done < k) {
+                    size_t got = s.try_push_batch(buf.data() + done, (size_t)(k - done));
+                    if (got == 0) backoff(spins);
+                    done += (int)got;
+                }
+                if (sample) my_lat.push_back((double)(now_ns() - c0));
+            }
+        } else {
+            // потребитель: пока все элементы не разобраны
+            std::vector<long long> last(P, -1);
+            uint64_t s1 = 0, s2 = 0;
+            long long n = 0;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                bool sample = (calls++ % LAT_EVERY) == 0;
+                long long c0 = sample ? now_ns() : 0;
+                size_t k = 0;
+                int spins = 0;
+                while ((k = s.try_pop_batch(buf.data(), (size_t)batch)) == 0) {
+                    if (consumed.load(std::memory_order_relaxed) >= total) break;
+                    backoff(spins);
+                }
+                if (k == 0) break;
+                if (sample) my_lat.push_back((double)(now_ns() - c0));
+                consumed.fetch_add((long long)k, std::memory_order_relaxed);
+                for (size_t j = 0; j < k; ++j) {
+                    uint64_t v = buf[j];
+                    s1 += v;
+                    s2 += v * v;
+                    int p = (int)(v >> 40);
+                    long long i = (long long)(v & ((1ULL << 40) - 1));
+                    if (fifo && i <= last[p]) order_ok[t] = 0;
+                    last[p] = i;
+                }
+                n += (long long)k;
+            }
+            sum[t] = s1;
+            sumsq[t] = s2;
+            cnt[t] = n;
+        }
+    }
+    double t1 = bench_now_s();
+
+    // проверка: все элементы ровно по разу
+    uint64_t s1 = 0, s2 = 0, e1 = 0, e2 = 0;
+    long long n = 0;
+    bool order = true;
+    for (int t = P; t < T; ++t) {
+        s1 += sum[t];
+        s2 += sumsq[t];
+        n += cnt[t];
+        order = order && order_ok[t];
+    }
+    for (int p = 0; p < P; ++p)
+        for (long long i = 0; i < ops; ++i) {
+            uint64_t v = encode(p, i);
+            e1 += v;
+            e2 += v * v;
+        }
+
+    RunResult r;
+    r.name = name;
+    r.producers = P;
+    r.consumers = C;
+    r.batch = batch;
+    r.mops = (double)total / (t1 - t0) / 1e6;
+    r.ok = (n == total) && s1 == e1 && s2 == e2 && order;
+
+    auto pct = [&](int from, int to, double& p50, double& p99, double& p999) {
+        std::vector<double> all;
+        for (int t = from; t < to; ++t) all.insert(all.end(), lat[t].begin(), lat[t].end());
+        std::sort(all.begin(), all.end());
+        p50 = bench_percentile(all, 0.50);
+        p99 = bench_percentile(all, 0.99);
+        p999 = bench_percentile(all, 0.999);
+    };
+    pct(0, P, r.push_p50, r.push_p99, r.push_p999);
+    pct(P, T, r.pop_p50, r.pop_p99, r.pop_p999);
+    return r;
+}
+
+int main(int argc, char** argv) {
+    long long ops = (argc > 1) ? std::atoll(argv[1]) : 200000;       // элементов на производителя
+    int max_threads = (argc > 2) ? std::atoi(argv[2]) : std::max(2, (int)std::thread::hardware_concurrency());
+    size_t cap = (argc > 3) ? (size_t)std::atoll(argv[3]) : 1024;    // ёмкость структур
+    max_threads = std::max(2, max_threads);
+
+    // производители x потребители: 1x1, 2x2, 4x4, ... и перекосы 1 x (T-1), (T-1) x 1
+    std::vector<std::pair<int, int>> configs;
+    for (int p = 1; 2 * p <= max_threads; p *= 2) configs.push_back({p, p});
+    if (max_threads >= 3) {
+        configs.push_back({1, max_threads - 1});
+        configs.push_back({max_threads - 1, 1});
+    }
+
+    std::cout << "ops/producer=" << ops << " capacity=" << cap << " max_threads=" << max_threads
+              << " (hardware " << std::thread::hardware_concurrency() << ")\n";
+    std::cout << std::left << std::setw(12) << "struct" << std::right << std::setw(6) << "batch"
+              << std::setw(5) << "P" << std::setw(5) << "C" << std::setw(10) << "Mops/s"
+              << std::setw(11) << "push p50" << std::setw(11) << "push p99" << std::setw(12) << "push p99.9"
+              << std::setw(10) << "pop p50" << std::setw(10) << "pop p99" << std::setw(11) << "pop p99.9"
+              << std::setw(5) << "ok" << "\n";
+
+    std::vector<RunResult> results;
+    for (auto [P, C] : configs)
+        for (int batch : {1, BATCH}) {
+            results.push_back(run_one<MpmcQueue<uint64_t>>("mpmc", true, P, C, batch, ops, cap));
+            results.push_back(run_one<MutexQueue<uint64_t>>("mutex_queue", true, P, C, batch, ops, cap));
+            results.push_back(run_one<TreiberStack<uint64_t>>("treiber", false, P, C, batch, ops, cap));
+            results.push_back(run_one<MutexStack<uint64_t>>("mutex_stack", false, P, C, batch, ops, cap));
+            for (size_t i = results.size() - 4; i < results.size(); ++i) {
+                const RunResult& r = results[i];
+                std::cout << std::left << std::setw(12) << r.name << std::right << std::setw(6) << r.batch
+                          << std::setw(5) << r.producers << std::setw(5) << r.consumers
+                          << std::fixed << std::setprecision(2) << std::setw(10) << r.mops
+                          << std::setprecision(0) << std::setw(11) << r.push_p50 << std::setw(11) << r.push_p99
+                          << std::setw(12) << r.push_p999 << std::setw(10) << r.pop_p50
+                          << std::setw(10) << r.pop_p99 << std::setw(11) << r.pop_p999
+                          << std::setw(5) << (r.ok ? "yes" : "NO") << "\n";
+            }
+        }
+
+    std::ofstream csv("stack_queue_cpu.csv");
+    csv << "struct,batch,producers,consumers,mops,push_p50_ns,push_p99_ns,push_p999_ns,pop_p50_ns,pop_p99_ns,pop_p999_ns,ok\n";
+    for (const RunResult& r : results)
+        csv << r.name << "," << r.batch << "," << r.producers << "," << r.consumers << "," << r.mops << ","
+            << r.push_p50 << "," << r.push_p99 << "," << r.push_p999 << ","
+            << r.pop_p50 << "," << r.pop_p99 << "," << r.pop_p999 << "," << (r.ok ? 1 : 0) << "\n";
+    std::cout << "Saved stack_queue_cpu.csv\n";
+
+    bool all_ok = true;
+    for (const RunResult& r : results) all_ok = all_ok && r.ok;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+// ------------------------------------------------------------
+// Ядра OpenCL практической работы 6
+//   vector_add    — задача 1 (C = A + B)
+//   matmul        — задача 2, исходное ядро: каждый work-item читает строку A
+//                   и столбец B прямо из глобальной памяти
+//   matmul_tiled  — задача 2, плиточное ядро: плитки A и B в локальной памяти,
+//                   регистровый блок WPTM x WPTN на work-item, векторные типы
+// ------------------------------------------------------------
+
+__kernel void vector_add(__global const float* A,
+                         __global const float* B,
+                         __global float* C,
+                         const int n)
+{
+    int id = get_global_id(0);
+    if (id < n) C[id] = A[id] + B[id];
+}
+
+__kernel void matmul(__global const float* A,
+                     __global const float* B,
+                     __global float* C,
+                     const int N, const int M, const int K)
+{
+    // C is N x K
+    int row = get_global_id(0);
+    int col = get_global_id(1);
+
+    if (row < N && col < K) {
+        float sum = 0.0f;
+        for (int i = 0; i < M; i++) {
+            sum += A[row * M + i] * B[i * K + col];
+        }
+        C[row * K + col] = sum;
+    }
+}
+
+// ------------------------------------------------------------
+// Плиточное ядро. Параметры задаются при сборке программы (-D ...),
+// их перебирает автотюнер в matmul.cpp; ниже — значения по умолчанию.
+//   TSM x TSN — плитка C на work-group, TSK — шаг по внутренней размерности;
+//   WPTM x WPTN — элементов C на work-item: WPTM строк с шагом TSM/WPTM
+//   и WPTN соседних столбцов одним вектором floatW (WPTN = 1, 2, 4, 8).
+// Work-group: (TSN/WPTN, TSM/WPTM), измерение 0 — столбцы C (как соседние
+// адреса в памяти), измерение 1 — строки.
+// Размеры N, M, K любые: края плиток дополняются нулями при загрузке.
+// ------------------------------------------------------------
+#ifndef TSM
+#define TSM 64
+#endif
+#ifndef TSN
+#define TSN 64
+#endif
+#ifndef TSK
+#define TSK 16
+#endif
+#ifndef WPTM
+#define WPTM 4
+#endif
+#ifndef WPTN
+#define WPTN 4
+#endif
+
+#define RTSM (TSM / WPTM)          // work-item по строкам
+#define RTSN (TSN / WPTN)          // work-item по столбцам
+#define WG   (RTSM * RTSN)         // размер work-group
+
+#if WPTN == 1
+#define floatW float
+#define VLOADW(p)     (*(p))
+#define VSTOREW(v, p) (*(p) = (v))
+#elif WPTN == 2
+#define floatW float2
+#define VLOADW(p)     vload2(0, p)
+#define VSTOREW(v, p) vstore2(v, 0, p)
+#elif WPTN == 4
+#define floatW float4
+#define VLOADW(p)     vload4(0, p)
+#define VSTOREW(v, p) vstore4(v, 0, p)
+#elif WPTN == 8
+#define floatW float8
+#define VLOADW(p)     vload8(0, p)
+#define VSTOREW(v, p) vstore8(v, 0, p)
+#else
+#error "WPTN must be 1, 2, 4 or 8"
+#endif
+
+__kernel __attribute__((reqd_work_group_size(RTSN, RTSM, 1)))
+void matmul_tiled(__global const float* A,
+                  __global const float* B,
+                  __global float* C,
+                  const int N, const int M, const int K)
+{
+    const int tx = get_local_id(0);              // столбцы (векторы по WPTN)
+    const int ty = get_local_id(1);              // строки
+    const int lid = ty * RTSN + tx;              // номер work-item в группе
+    const int row0 = get_group_id(1) * TSM;      // левый верхний угол плитки C
+    const int col0 = get_group_id(0) * TSN;
+
+    // +1 столбец у A: соседние строки плитки не попадают в один банк локальной памяти
+    __local float Asub[TSM][TSK + 1];
+    __local float Bsub[TSK][TSN];
+
+    // регистровый блок: WPTM строк по WPTN столбцов
+    floatW acc[WPTM];
+    for (int wm = 0; wm < WPTM; wm++) acc[wm] = (floatW)(0.0f);
+
+    for (int k0 = 0; k0 < M; k0 += TSK) {
+        // 1) вся группа загружает плитку A (TSM x TSK): соседние work-item — соседние адреса
+        for (int l = lid; l < TSM * TSK; l += WG) {
+            int r = l / TSK, k = l % TSK;
+            int gr = row0 + r, gk = k0 + k;
+            Asub[r][k] = (gr < N && gk < M) ? A[gr * M + gk] : 0.0f;
+        }
+        // 2) плитку B (TSK x TSN) — векторами по WPTN, на краю матрицы — поэлементно
+        for (int l = lid; l < TSK * RTSN; l += WG) {
+            int k = l / RTSN, c = (l % RTSN) * WPTN;
+            int gk = k0 + k, gc = col0 + c;
+            if (gk < M && gc + WPTN <= K) {
+                VSTOREW(VLOADW(B + gk * K + gc), &Bsub[k][c]);
+            } else {
+                for (int w = 0; w < WPTN; w++)
+                    Bsub[k][c + w] = (gk < M && gc + w < K) ? B[gk * K + gc + w] : 0.0f;
+            }
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        // 3) счёт из локальной памяти: на одну загрузку вектора B — WPTM умножений
+        for (int k = 0; k < TSK; k++) {
+            floatW b = VLOADW(&Bsub[k][tx * WPTN]);
+            for (int wm = 0; wm < WPTM; wm++)
+                acc[wm] += Asub[ty + wm * RTSM][k] * b;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    // 4) запись блока C; вектор, выходящий за край матрицы, — поэлементно
+    const int gc = col0 + tx * WPTN;
+    for (int wm = 0; wm < WPTM; wm++) {
+        int gr = row0 + ty + wm * RTSM;
+        if (gr >= N) continue;
+        if (gc + WPTN <= K) {
+            VSTOREW(acc[wm], C + gr * K + gc);
+        } else {
+            float t[WPTN];
+            VSTOREW(acc[wm], t);
+            for (int w = 0; w < WPTN; w++)
+                if (gc + w < K) C[gr * K + gc + w] = t[w];
+        }
+    }
+}
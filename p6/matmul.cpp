@@ -0,0 +1,441 @@
+// ------------------------------------------------------------
+// Лабораторная работа: OpenCL Matrix Multiplication (C = A * B)
+// A: N×M, B: M×K, C: N×K
+// Среда: Google Colab (CPU: POCL, GPU: NVIDIA CUDA OpenCL)
+// Автор: (впиши своё ФИО)
+//
+// Ядра (kernel.cl):
+//   matmul       — исходное, всё из глобальной памяти (для сравнения)
+//   matmul_tiled — плитки в локальной памяти + регистровый блок + float4/float8;
+//                  размеры плиток и work-group подбирает автотюнер под устройство
+//                  и сохраняет в matmul_tuning.txt (ключ — имя устройства и версия драйвера)
+// Эталон на CPU — блочный GEMM с SIMD и OpenMP (common/gemm.hpp) вместо тройного цикла.
+// Контекст, программы и буферы — common/cl_runtime.hpp: собранные программы (в том числе
+// все варианты автотюнера) лежат в дисковом кэше .clcache и не компилируются повторно.
+// ------------------------------------------------------------
+
+#define CL_TARGET_OPENCL_VERSION 120   // Целевая версия OpenCL (1.2 хватает для базового кода)
+#include <CL/cl.h>
+
+#include <algorithm>   // max
+#include <chrono>      // время CPU GEMM
+#include <cmath>       // sin/cos для генерации чисел
+#include <cstdlib>     // atoi, exit
+#include <fstream>     // чтение kernel.cl, файл настроек
+#include <iostream>    // вывод
+#include <sstream>     // -D опции сборки, разбор файла настроек
+#include <string>
+#include <vector>      // массивы на хосте
+
+#include "../common/gemm.hpp"        // блочный GEMM на CPU (эталон)
+#include "../common/cl_runtime.hpp"  // контекст, очередь, программы (с дисковым кэшем), пул буферов
+
+// Аргументы ядра: kernel(A, B, C, N, M, K) — одинаковые у matmul и matmul_tiled
+static void setMatmulArgs(cl_kernel kernel, cl_mem bufA, cl_mem bufB, cl_mem bufC,
+                          int N, int M, int K) {
+    cl_check(clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufA), "arg0(A)");
+    cl_check(clSetKernelArg(kernel, 1, sizeof(cl_mem), &bufB), "arg1(B)");
+    cl_check(clSetKernelArg(kernel, 2, sizeof(cl_mem), &bufC), "arg2(C)");
+    cl_check(clSetKernelArg(kernel, 3, sizeof(int), &N), "arg3(N)");
+    cl_check(clSetKernelArg(kernel, 4, sizeof(int), &M), "arg4(M)");
+    cl_check(clSetKernelArg(kernel, 5, sizeof(int), &K), "arg5(K)");
+}
+
+// Прогрев + iters запусков; время берём из event profiling (START/END) => kernel-only time.
+// Возвращаем среднее время ядра в миллисекундах или -1, если запуск не удался.
+static double timeKernel(cl_command_queue queue, cl_kernel kernel,
+                         const size_t global[2], const size_t local[2], int iters) {
+    // Прогревочный запуск (warmup) — чтобы замеры были стабильнее
+    cl_event ew = nullptr;
+    if (clEnqueueNDRangeKernel(queue, kernel, 2, nullptr, global, local, 0, nullptr, &ew) != CL_SUCCESS)
+        return -1.0;
+    clWaitForEvents(1, &ew);
+    clReleaseEvent(ew);
+
+    double totalKernelMs = 0.0;
+    for (int i = 0; i < iters; i++) {
+        cl_event e = nullptr;
+        cl_check(clEnqueueNDRangeKernel(queue, kernel, 2, nullptr, global, local, 0, nullptr, &e), "kernel");
+        clWaitForEvents(1, &e);
+
+        cl_ulong start = 0, end = 0;
+        cl_check(clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &start, nullptr), "profiling(start)");
+        cl_check(clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr), "profiling(end)");
+        totalKernelMs += (double)(end - start) * 1e-6; // ns -> ms
+
+        clReleaseEvent(e);
+    }
+    return totalKernelMs / iters;
+}
+
+// Округление вверх до кратного m (global NDRange кратен local)
+static size_t roundUp(size_t x, size_t m) {
+    return ((x + m - 1) / m) * m;
+}
+
+// ----------------------------
+// Параметры плиточного ядра (см. kernel.cl)
+// ----------------------------
+struct TileConfig {
+    int tsm = 64, tsn = 64, tsk = 16;   // плитка C на work-group и шаг по M
+    int wptm = 4, wptn = 4;             // регистровый блок work-item
+
+    std::string options() const {
+        std::ostringstream o;
+        o << "-DTSM=" << tsm << " -DTSN=" << tsn << " -DTSK=" << tsk
+          << " -DWPTM=" << wptm << " -DWPTN=" << wptn;
+        return o.str();
+    }
+    std::string str() const {
+        std::ostringstream o;
+        o << tsm << "x" << tsn << "x" << tsk << "/" << wptm << "x" << wptn;
+        return o.str();
+    }
+    size_t wgSize() const { return (size_t)(tsn / wptn) * (tsm / wptm); }
+    size_t localMemBytes() const { return sizeof(float) * ((size_t)tsm * (tsk + 1) + (size_t)tsk * tsn); }
+    // NDRange: измерение 0 — столбцы C (по WPTN), измерение 1 — строки (по WPTM)
+    void ranges(int N, int K, size_t global[2], size_t local[2]) const {
+        local[0] = tsn / wptn;
+        local[1] = tsm / wptm;
+        global[0] = roundUp((size_t)K, tsn) / wptn;
+        global[1] = roundUp((size_t)N, tsm) / wptm;
+    }
+};
+
+// Файл настроек: строка "<устройство> | <драйвер>\tTSM TSN TSK WPTM WPTN ms".
+// Ключ с версией драйвера: после обновления драйвера лучшая конфигурация может измениться.
+static const char* TUNING_FILE = "matmul_tuning.txt";
+
+static bool loadTuning(const std::string& key, TileConfig& cfg) {
+    std::ifstream f(TUNING_FILE);
+    std::string line;
+    while (std::getline(f, line)) {
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.compare(0, tab, key) != 0 || tab != key.size()) continue;
+        std::istringstream in(line.substr(tab + 1));
+        TileConfig c;
+        if (in >> c.tsm >> c.tsn >> c.tsk >> c.wptm >> c.wptn) {
+            cfg = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Записываем лучшую конфигурацию устройства: строка с тем же ключом заменяется, остальные сохраняются
+static void saveTuning(const std::string& key, const TileConfig& c, double ms) {
+    std::vector<std::string> lines;
+    {
+        std::ifstream f(TUNING_FILE);
+        std::string line;
+        while (std::getline(f, line))
+            if (line.compare(0, key.size() + 1, key + "\t") != 0) lines.push_back(line);
+    }
+    std::ostringstream o;
+    o << key << "\t" << c.tsm << " " << c.tsn << " " << c.tsk << " " << c.wptm << " " << c.wptn << " " << ms;
+    lines.push_back(o.str());
+    std::ofstream out(TUNING_FILE);
+    for (const auto& l : lines) out << l << "\n";
+}
+
+// Максимальное отличие от эталона
+static double maxAbsErr(const std::vector<float>& X, const std::vector<float>& Y) {
+    double m = 0.0;
+    for (size_t i = 0; i < X.size(); i++) {
+        m = std::max(m, std::abs((double)X[i] - (double)Y[i]));
+    }
+    return m;
+}
+
+// Результат одной конфигурации плиточного ядра
+struct TiledRun {
+    double ms = -1.0;
+    double err = 0.0;
+};
+
+// Сборка matmul_tiled с конфигурацией c (программа — из кэша, если уже собиралась) и замер;
+// ядро, которое не собралось, не помещается на устройство или считает неверно, получает ms = -1
+static TiledRun runTiled(ClRuntime& rt, const std::string& src, const TileConfig& c,
+                         cl_mem bufA, cl_mem bufB, cl_mem bufC,
+                         std::vector<float>& C, const std::vector<float>& Cref,
+                         int N, int M, int K, int iters, bool quiet) {
+    TiledRun r;
+    cl_kernel kernel = cl_kernel_get(rt, src, c.options(), "matmul_tiled", quiet);
+    if (!kernel) return r;
+
+    // после сборки устройство знает, сколько work-item реально помещается (регистры)
+    size_t kernelWG = 0;
+    clGetKernelWorkGroupInfo(kernel, rt.device, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &kernelWG, nullptr);
+    if (c.wgSize() <= kernelWG) {
+        setMatmulArgs(kernel, bufA, bufB, bufC, N, M, K);
+        size_t global[2], local[2];
+        c.ranges(N, K, global, local);
+        r.ms = timeKernel(rt.queue, kernel, global, local, iters);
+        if (r.ms > 0) {
+            cl_check(clEnqueueReadBuffer(rt.queue, bufC, CL_TRUE, 0, sizeof(float) * C.size(), C.data(), 0, nullptr, nullptr), "read(C)");
+            r.err = maxAbsErr(C, Cref);
+            // float-накопление: допуск растёт с длиной скалярного произведения M
+            if (r.err > 1e-5 * M + 1e-3) r.ms = -1.0;
+        }
+    }
+    return r;
+}
+
+// Автотюнер: перебор плиток и регистровых блоков под устройство.
+//   этап 1: TSM = TSN из {16..128}, WPTM x WPTN из {1,2,4,8}^2 при TSK = 16;
+//   этап 2: для лучшей — TSK из {8, 32}.
+// Отсекаем заранее: work-group больше допустимой или меньше 16 (на GPU — меньше варпа),
+// локальная память больше, чем есть, и больше 64 накопителей на work-item (регистры).
+// Собранные варианты остаются в дисковом кэше: повторная настройка не компилирует заново.
+static TileConfig autotune(ClRuntime& rt, const std::string& src, cl_mem bufA, cl_mem bufB, cl_mem bufC,
+                           std::vector<float>& C, const std::vector<float>& Cref,
+                           int N, int M, int K, double& bestMs) {
+    size_t maxWG = 0;
+    cl_ulong localMem = 0;
+    clGetDeviceInfo(rt.device, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(size_t), &maxWG, nullptr);
+    clGetDeviceInfo(rt.device, CL_DEVICE_LOCAL_MEM_SIZE, sizeof(cl_ulong), &localMem, nullptr);
+
+    auto fits = [&](const TileConfig& c) {
+        return c.wgSize() >= 16 && c.wgSize() <= maxWG && c.localMemBytes() <= localMem &&
+               c.wptm * c.wptn <= 64;
+    };
+
+    const int tuneIters = 3;
+    TileConfig best;
+    bestMs = -1.0;
+    int tried = 0;
+    auto tryConfig = [&](const TileConfig& c) {
+        if (!fits(c)) return;
+        TiledRun r = runTiled(rt, src, c, bufA, bufB, bufC, C, Cref, N, M, K, tuneIters, true);
+        tried++;
+        std::cout << "  tune " << c.str() << ": " << (r.ms > 0 ? std::to_string(r.ms) + " ms" : "skip") << "\n";
+        if (r.ms > 0 && (bestMs < 0 || r.ms < bestMs)) {
+            bestMs = r.ms;
+            best = c;
+        }
+    };
+
+    for (int ts : {16, 32, 64, 128})
+        for (int wptm : {1, 2, 4, 8})
+            for (int wptn : {1, 2, 4, 8}) {
+                TileConfig c;
+                c.tsm = c.tsn = ts;
+                c.tsk = 16;
+                c.wptm = wptm;
+                c.wptn = wptn;
+                if (ts % wptm == 0 && ts % wptn == 0) tryConfig(c);
+            }
+    if (bestMs > 0) {
+        TileConfig base = best;
+        for (int tsk : {8, 32}) {
+            TileConfig c = base;
+            c.tsk = tsk;
+            tryConfig(c);
+        }
+    }
+    std::cout << "Autotune: " << tried << " configs, best " << best.str() << " (" << bestMs << " ms)\n";
+    return best;
+}
+
+// Результат запуска на одном устройстве
+struct DeviceRun {
+    bool ok = false;
+    double naiveMs = -1.0, tiledMs = -1.0;
+    double naiveErr = 0.0, tiledErr = 0.0;
+    double setupMs = 0.0;               // среда + программа + буферы до первого ядра
+    const char* programFrom = "";       // source / disk / memory
+    TileConfig cfg;
+};
+
+// Запуск OpenCL matmul на CPU или GPU: исходное ядро и плиточное с настройкой
+// из matmul_tuning.txt (или автотюнер, если записи для устройства нет либо retune).
+// Контекст, очередь, программы и буферы берутся из cl_runtime и не освобождаются:
+// повторный вызов (другие размеры, другая конфигурация) подготовку не повторяет.
+static DeviceRun run_opencl_matmul(cl_device_type devType,
+                                   const std::vector<float>& A,
+                                   const std::vector<float>& B,
+                                   const std::vector<float>& Cref,
+                                   int N, int M, int K,
+                                   int iters,
+                                   const std::string& kernelPath,
+                                   const std::string& tag,
+                                   bool retune) {
+    DeviceRun res;
+    double t0 = cl_now_ms();
+
+    // Выбираем устройство (при первом вызове — перебор платформ, контекст, очередь)
+    ClRuntime* rtp = cl_runtime(devType);
+    if (!rtp) {
+        std::cerr << "[" << tag << "] No device found.\n";
+        return res;
+    }
+    ClRuntime& rt = *rtp;
+
+    // Информация для отчёта: на каком устройстве запустилось
+    std::cout << "\n=== " << tag << " ===\n";
+    std::cout << "Platform: " << cl_platform_name(rt.platform) << "\n";
+    std::cout << "Device:   " << rt.device_key << "\n";
+
+    const std::string& src = cl_source(rt, kernelPath);
+    cl_kernel naive = cl_kernel_get(rt, src, "", "matmul");
+    res.programFrom = rt.last_program_from;
+
+    // Считаем размеры буферов в байтах
+    size_t bytesA = sizeof(float) * (size_t)N * (size_t)M;
+    size_t bytesB = sizeof(float) * (size_t)M * (size_t)K;
+    size_t bytesC = sizeof(float) * (size_t)N * (size_t)K;
+
+    // Буферы на устройстве — из пула
+    cl_mem bufA = cl_buffer_acquire(rt, CL_MEM_READ_ONLY,  bytesA);
+    cl_mem bufB = cl_buffer_acquire(rt, CL_MEM_READ_ONLY,  bytesB);
+    cl_mem bufC = cl_buffer_acquire(rt, CL_MEM_WRITE_ONLY, bytesC);
+    res.setupMs = cl_now_ms() - t0;
+    std::cout << "Setup: " << res.setupMs << " ms (program from " << res.programFrom << ")\n";
+
+    // Копируем A и B на устройство (host -> device)
+    cl_check(clEnqueueWriteBuffer(rt.queue, bufA, CL_TRUE, 0, bytesA, A.data(), 0, nullptr, nullptr), "write(A)");
+    cl_check(clEnqueueWriteBuffer(rt.queue, bufB, CL_TRUE, 0, bytesB, B.data(), 0, nullptr, nullptr), "write(B)");
+
+    std::vector<float> C((size_t)N * (size_t)K, 0.0f);
+
+    // ----------------------------
+    // 1) Исходное ядро matmul, local 16x16: global = (N, K), округлённый вверх
+    // ----------------------------
+    {
+        setMatmulArgs(naive, bufA, bufB, bufC, N, M, K);
+
+        const size_t local[2]  = { 16, 16 };
+        const size_t global[2] = { roundUp((size_t)N, local[0]), roundUp((size_t)K, local[1]) };
+        res.naiveMs = timeKernel(rt.queue, naive, global, local, iters);
+        if (res.naiveMs > 0) {
+            cl_check(clEnqueueReadBuffer(rt.queue, bufC, CL_TRUE, 0, bytesC, C.data(), 0, nullptr, nullptr), "read(C)");
+            res.naiveErr = maxAbsErr(C, Cref);
+            std::cout << "matmul (naive, 16x16): " << res.naiveMs << " ms\n";
+        } else {
+            std::cerr << "[" << tag << "] matmul (naive) failed: work-group 16x16 is too large for the device\n";
+        }
+    }
+
+    // ----------------------------
+    // 2) Плиточное ядро: настройка из файла или автотюнер
+    // ----------------------------
+    TileConfig cfg;
+    if (!retune && loadTuning(rt.device_key, cfg)) {
+        std::cout << "Tuning: " << cfg.str() << " from " << TUNING_FILE << "\n";
+    } else {
+        double bestMs = -1.0;
+        cfg = autotune(rt, src, bufA, bufB, bufC, C, Cref, N, M, K, bestMs);
+        if (bestMs > 0) saveTuning(rt.device_key, cfg, bestMs);
+    }
+
+    TiledRun r = runTiled(rt, src, cfg, bufA, bufB, bufC, C, Cref, N, M, K, iters, false);
+    if (r.ms < 0) {
+        std::cerr << "[" << tag << "] matmul_tiled " << cfg.str() << " failed (delete " << TUNING_FILE
+                  << " or pass 'tune' to re-tune)\n";
+    } else {
+        std::cout << "matmul_tiled (" << cfg.str() << ", local " << cfg.tsn / cfg.wptn << "x"
+                  << cfg.tsm / cfg.wptm << "): " << r.ms << " ms (iters=" << iters << ")\n";
+    }
+    res.tiledMs = r.ms;
+    res.tiledErr = r.err;
+    res.cfg = cfg;
+    res.ok = true;
+
+    // Буферы — обратно в пул
+    cl_buffer_release(rt, bufA);
+    cl_buffer_release(rt, bufB);
+    cl_buffer_release(rt, bufC);
+
+    return res;
+}
+
+int main(int argc, char** argv) {
+    // Размеры матриц можно задавать аргументами:
+    // ./matmul N M K iters [tune]   (tune — заново подобрать плитки, даже если есть в файле)
+    int N = (argc >= 2) ? std::atoi(argv[1]) : 512;
+    int M = (argc >= 3) ? std::atoi(argv[2]) : 512;
+    int K = (argc >= 4) ? std::atoi(argv[3]) : 512;
+    int iters = (argc >= 5) ? std::atoi(argv[4]) : 10;
+    bool retune = (argc >= 6) && std::string(argv[5]) == "tune";
+
+    std::cout << "Matrix sizes: A=" << N << "x" << M
+              << ", B=" << M << "x" << K
+              << ", C=" << N << "x" << K
+              << ", iters=" << iters << "\n";
+
+    // ----------------------------
+    // Подготовка матриц на хосте
+    // ----------------------------
+    std::vector<float> A((size_t)N * (size_t)M);
+    std::vector<float> B((size_t)M * (size_t)K);
+    std::vector<float> Cref((size_t)N * (size_t)K, 0.0f);   // эталон (блочный GEMM на CPU)
+
+    // Заполняем A и B детерминированно (чтобы повторяемость результатов была одинаковой)
+    for (size_t i = 0; i < A.size(); i++) A[i] = std::sin(i * 0.001f);
+    for (size_t i = 0; i < B.size(); i++) B[i] = std::cos(i * 0.001f);
+
+    // ----------------------------
+    // Эталон: блочный GEMM (SIMD + OpenMP), лучший из iters запусков
+    // ----------------------------
+    std::cout << "\nComputing CPU reference (blocked GEMM, OpenMP)...\n";
+    double cpuGemmMs = 1e30;
+    for (int i = 0; i < std::max(1, iters); i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        gemm_blocked_par(A.data(), B.data(), Cref.data(), N, M, K);
+        auto t1 = std::chrono::steady_clock::now();
+        cpuGemmMs = std::min(cpuGemmMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    double flop = 2.0 * N * M * K;
+    auto gflops = [&](double ms) { return ms > 0 ? flop / (ms * 1e6) : 0.0; };
+    std::cout << "CPU GEMM: " << cpuGemmMs << " ms, " << gflops(cpuGemmMs) << " GFLOP/s\n";
+
+    // ----------------------------
+    // Запуск OpenCL на CPU и на GPU
+    // ----------------------------
+    DeviceRun cpu = run_opencl_matmul(CL_DEVICE_TYPE_CPU, A, B, Cref, N, M, K, iters,
+                                      "kernel.cl", "CPU(OpenCL)", retune);
+    DeviceRun gpu = run_opencl_matmul(CL_DEVICE_TYPE_GPU, A, B, Cref, N, M, K, iters,
+                                      "kernel.cl", "GPU(OpenCL)", retune);
+
+    // ----------------------------
+    // Проверка корректности и производительность
+    // ----------------------------
+    std::cout << "\n===== Correctness (max abs error vs CPU GEMM) =====\n";
+    if (cpu.ok) std::cout << "OpenCL CPU: naive " << cpu.naiveErr << ", tiled " << cpu.tiledErr << "\n";
+    if (gpu.ok) std::cout << "OpenCL GPU: naive " << gpu.naiveErr << ", tiled " << gpu.tiledErr << "\n";
+
+    std::cout << "\n===== Performance (kernel time) =====\n";
+    std::cout << "CPU GEMM (host):      " << cpuGemmMs << " ms, " << gflops(cpuGemmMs) << " GFLOP/s\n";
+    for (const DeviceRun* d : {&cpu, &gpu}) {
+        if (!d->ok) continue;
+        const char* name = (d == &cpu) ? "CPU(OpenCL)" : "GPU(OpenCL)";
+        std::cout << name << " setup:    " << d->setupMs << " ms (program from " << d->programFrom << ")\n";
+        std::cout << name << " naive:    " << d->naiveMs << " ms, " << gflops(d->naiveMs) << " GFLOP/s\n";
+        std::cout << name << " tiled:    " << d->tiledMs << " ms, " << gflops(d->tiledMs) << " GFLOP/s";
+        if (d->tiledMs > 0) std::cout << " (x" << d->naiveMs / d->tiledMs << " vs naive)";
+        std::cout << "\n";
+    }
+    if (cpu.tiledMs > 0 && gpu.tiledMs > 0) {
+        std::cout << "Speedup tiled (CPU/GPU): " << (cpu.tiledMs / gpu.tiledMs) << "x\n";
+    }
+
+    // ----------------------------
+    // Сохраняем CSV (для графиков/отчёта)
+    // ----------------------------
+    std::ofstream out("results_matmul.csv");
+    out << "device,kernel,config,avg_kernel_ms,gflops,max_abs_error\n";
+    out << "host,gemm_blocked,," << cpuGemmMs << "," << gflops(cpuGemmMs) << ",0\n";
+    for (const DeviceRun* d : {&cpu, &gpu}) {
+        if (!d->ok) continue;
+        const char* dev = (d == &cpu) ? "CPU" : "GPU";
+        out << dev << ",naive,16x16," << d->naiveMs << "," << gflops(d->naiveMs) << "," << d->naiveErr << "\n";
+        if (d->tiledMs > 0)
+            out << dev << ",tiled," << d->cfg.str() << "," << d->tiledMs << "," << gflops(d->tiledMs) << ","
+                << d->tiledErr << "\n";
+    }
+    out.close();
+    std::cout << "Saved results_matmul.csv\n";
+
+    cl_runtime_release_all();
+    return 0;
+}
@@ -0,0 +1,216 @@
+// ------------------------------------------------------------
+// Лабораторная работа: OpenCL Vector Add (A + B = C)
+// Среда: Google Colab (CPU: POCL, GPU: NVIDIA CUDA OpenCL)
+// Автор: (впиши своё ФИО)
+//
+// Подготовка OpenCL (платформы, контекст, очередь, компиляция kernel.cl, буферы)
+// вынесена в common/cl_runtime.hpp и делается один раз: ядро запускается calls раз,
+// первый вызов — холодный старт, остальные — тёплый (всё уже готово).
+// Собранная программа лежит в дисковом кэше .clcache, поэтому и холодный старт
+// следующего запуска программы не компилирует kernel.cl заново.
+// ------------------------------------------------------------
+
+#define CL_TARGET_OPENCL_VERSION 120   // Указываем целевую версию OpenCL (1.2 достаточно для базовых задач)
+#include <CL/cl.h>
+
+#include <cmath>      // sin/cos для генерации данных
+#include <cstdlib>    // atoi, exit
+#include <fstream>    // results.csv
+#include <iostream>   // вывод в консоль
+#include <string>
+#include <vector>     // массивы на хосте
+#include <algorithm>  // max
+
+#include "../common/cl_runtime.hpp"  // контекст, очередь, программы (с дисковым кэшем), пул буферов
+
+// Результат одного вызова vector_add
+struct VecAddRun {
+    double setupMs = -1.0;        // от вызова до готового к запуску ядра (среда, программа, буферы)
+    double kernelMs = -1.0;       // среднее время ядра
+    double maxAbsErr = 0.0;
+    const char* programFrom = ""; // source / disk / memory
+};
+
+// Один вызов ядра vector_add на выбранном типе устройства (CPU или GPU).
+// Среда, программа, kernel и буферы берутся из cl_runtime: на первом вызове они
+// создаются (холодный старт), на следующих — переиспользуются (тёплый).
+static VecAddRun runVectorAdd(cl_device_type devType,
+                              const std::vector<float>& A, const std::vector<float>& B,
+                              const std::vector<float>& Ref, int iters,
+                              const std::string& kernelPath, const std::string& tag, bool verbose) {
+    VecAddRun res;
+    int n = (int)A.size();
+    double t0 = cl_now_ms();
+
+    // Выбираем платформу + устройство (при первом вызове), контекст и очередь
+    ClRuntime* rtp = cl_runtime(devType);
+    if (!rtp) {
+        std::cerr << "[" << tag << "] No device found.\n";
+        return res;
+    }
+    ClRuntime& rt = *rtp;
+
+    // Исходник — из памяти, программа — из памяти / дискового кэша / компиляция
+    cl_kernel kernel = cl_kernel_get(rt, cl_source(rt, kernelPath), "", "vector_add");
+    res.programFrom = rt.last_program_from;
+
+    // ----------------------------
+    // 1) Буферы на устройстве — из пула (на тёплом вызове те же самые)
+    // ----------------------------
+    size_t bytes = sizeof(float) * (size_t)n;
+    cl_mem bufA = cl_buffer_acquire(rt, CL_MEM_READ_ONLY,  bytes);
+    cl_mem bufB = cl_buffer_acquire(rt, CL_MEM_READ_ONLY,  bytes);
+    cl_mem bufC = cl_buffer_acquire(rt, CL_MEM_WRITE_ONLY, bytes);
+
+    // ----------------------------
+    // 2) Передаём аргументы в ядро
+    // ----------------------------
+    cl_check(clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufA), "arg0(A)");
+    cl_check(clSetKernelArg(kernel, 1, sizeof(cl_mem), &bufB), "arg1(B)");
+    cl_check(clSetKernelArg(kernel, 2, sizeof(cl_mem), &bufC), "arg2(C)");
+    cl_check(clSetKernelArg(kernel, 3, sizeof(int), &n),       "arg3(n)");
+    res.setupMs = cl_now_ms() - t0;
+
+    if (verbose) {
+        // Для отчёта выводим, где именно запустились
+        std::cout << "\n=== " << tag << " ===\n";
+        std::cout << "Platform: " << cl_platform_name(rt.platform) << "\n";
+        std::cout << "Device:   " << rt.device_key << "\n";
+    }
+
+    // Копируем A и B на устройство
+    cl_check(clEnqueueWriteBuffer(rt.queue, bufA, CL_TRUE, 0, bytes, A.data(), 0, nullptr, nullptr), "write(A)");
+    cl_check(clEnqueueWriteBuffer(rt.queue, bufB, CL_TRUE, 0, bytes, B.data(), 0, nullptr, nullptr), "write(B)");
+
+    // ----------------------------
+    // 3) Настройка глобального размера (1D)
+    // Глобальный размер = количество элементов n
+    // ----------------------------
+    size_t global = static_cast<size_t>(n);
+
+    // Прогрев (warmup): один запуск без учёта времени (чтобы стабилизировать замер)
+    {
+        cl_event eWarm = nullptr;
+        cl_check(clEnqueueNDRangeKernel(rt.queue, kernel, 1, nullptr, &global, nullptr, 0, nullptr, &eWarm),
+                 "kernel(warmup)");
+        clWaitForEvents(1, &eWarm);
+        clReleaseEvent(eWarm);
+    }
+
+    // ----------------------------
+    // 4) Основные замеры времени ядра (iters запусков)
+    // Время берём из event profiling: START/END
+    // ----------------------------
+    double totalKernelMs = 0.0;
+    for (int i = 0; i < iters; i++) {
+        cl_event e = nullptr;
+        cl_check(clEnqueueNDRangeKernel(rt.queue, kernel, 1, nullptr, &global, nullptr, 0, nullptr, &e),
+                 "kernel");
+        clWaitForEvents(1, &e);
+
+        cl_ulong start = 0, end = 0;
+        cl_check(clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &start, nullptr),
+                 "profiling(start)");
+        cl_check(clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr),
+                 "profiling(end)");
+
+        // nanoseconds -> milliseconds
+        totalKernelMs += (double)(end - start) * 1e-6;
+
+        clReleaseEvent(e);
+    }
+
+    // Считываем результат C с устройства на CPU
+    std::vector<float> C(n, 0.0f);
+    cl_check(clEnqueueReadBuffer(rt.queue, bufC, CL_TRUE, 0, bytes, C.data(), 0, nullptr, nullptr), "read(C)");
+
+    // ----------------------------
+    // 5) Проверка корректности
+    // ----------------------------
+    for (int i = 0; i < n; i++) {
+        res.maxAbsErr = std::max(res.maxAbsErr, std::abs((double)C[i] - (double)Ref[i]));
+    }
+    res.kernelMs = totalKernelMs / iters;
+
+    // Буферы — обратно в пул (освобождаются в cl_runtime_release_all)
+    cl_buffer_release(rt, bufA);
+    cl_buffer_release(rt, bufB);
+    cl_buffer_release(rt, bufC);
+
+    return res;
+}
+
+// calls вызовов на устройстве: печать холодного / тёплого старта, возвращаем сводку
+struct DeviceSummary {
+    double kernelMs = -1.0;      // время ядра (последний вызов)
+    double coldMs = -1.0;        // подготовка в первом вызове
+    double warmMs = -1.0;        // подготовка в следующих (среднее)
+    const char* coldFrom = "";   // откуда программа в первом вызове
+};
+
+static DeviceSummary runDevice(cl_device_type devType, const std::vector<float>& A, const std::vector<float>& B,
+                               const std::vector<float>& Ref, int iters, int calls, const std::string& tag) {
+    DeviceSummary s;
+    double warmSum = 0.0;
+    for (int c = 0; c < calls; c++) {
+        VecAddRun r = runVectorAdd(devType, A, B, Ref, iters, "kernel.cl", tag, c == 0);
+        if (r.kernelMs < 0) return s;
+        std::cout << "call " << (c + 1) << ": setup " << r.setupMs << " ms ("
+                  << (c == 0 ? "cold" : "warm") << ", program from " << r.programFrom << "), kernel "
+                  << r.kernelMs << " ms, max abs error " << r.maxAbsErr << "\n";
+        if (c == 0) {
+            s.coldMs = r.setupMs;
+            s.coldFrom = r.programFrom;
+        } else {
+            warmSum += r.setupMs;
+        }
+        s.kernelMs = r.kernelMs;
+    }
+    if (calls > 1) s.warmMs = warmSum / (calls - 1);
+    return s;
+}
+
+int main(int argc, char** argv) {
+    // Размер вектора, количество итераций и вызовов можно задать аргументами командной строки
+    // Пример: ./vec_add 16777216 50 3
+    int n     = (argc >= 2) ? std::atoi(argv[1]) : (1 << 24); // по умолчанию ~16M
+    int iters = (argc >= 3) ? std::atoi(argv[2]) : 50;
+    int calls = (argc >= 4) ? std::max(1, std::atoi(argv[3])) : 3;
+
+    std::cout << "Vector size n=" << n << ", iters=" << iters << ", calls=" << calls << "\n";
+
+    // ----------------------------
+    // Подготовка данных на CPU (host) — один раз для всех вызовов
+    // ----------------------------
+    std::vector<float> A(n), B(n), Ref(n);
+    for (int i = 0; i < n; i++) {
+        A[i] = std::sin(i * 0.001f);
+        B[i] = std::cos(i * 0.001f);
+        Ref[i] = A[i] + B[i]; // эталон для проверки корректности
+    }
+
+    // Запуск на CPU и GPU
+    DeviceSummary cpu = runDevice(CL_DEVICE_TYPE_CPU, A, B, Ref, iters, calls, "CPU(OpenCL)");
+    DeviceSummary gpu = runDevice(CL_DEVICE_TYPE_GPU, A, B, Ref, iters, calls, "GPU(OpenCL)");
+
+    // Сохраняем результат в CSV (для построения графика)
+    std::ofstream out("results.csv");
+    out << "device,avg_kernel_ms,setup_cold_ms,setup_warm_ms,cold_program_from\n";
+    if (cpu.kernelMs > 0) out << "CPU," << cpu.kernelMs << "," << cpu.coldMs << "," << cpu.warmMs << "," << cpu.coldFrom << "\n";
+    if (gpu.kernelMs > 0) out << "GPU," << gpu.kernelMs << "," << gpu.coldMs << "," << gpu.warmMs << "," << gpu.coldFrom << "\n";
+    out.close();
+
+    // Итоговый вывод
+    std::cout << "\n===== Summary =====\n";
+    std::cout << "CPU avg kernel time: " << cpu.kernelMs << " ms, setup cold " << cpu.coldMs
+              << " ms (" << cpu.coldFrom << ") / warm " << cpu.warmMs << " ms\n";
+    std::cout << "GPU avg kernel time: " << gpu.kernelMs << " ms, setup cold " << gpu.coldMs
+              << " ms (" << gpu.coldFrom << ") / warm " << gpu.warmMs << " ms\n";
+    if (cpu.kernelMs > 0 && gpu.kernelMs > 0) {
+        std::cout << "Speedup (CPU/GPU): " << (cpu.kernelMs / gpu.kernelMs) << "x\n";
+    }
+    std::cout << "Saved results.csv\n";
+
+    cl_runtime_release_all();
+    return 0;
+}
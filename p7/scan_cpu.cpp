@@ -0,0 +1,207 @@
+// scan_cpu.cpp
+// Префиксная сумма на CPU (common/par_scan.hpp) против последовательного
+// cpu_scan_exclusive из prac7_task2_scan_arg.cu и std::exclusive_scan
+// (без политики и с std::execution::par), размеры 1K ... 1B — задание 3
+// в ноутбуке остановилось на 10M.
+// Для каждого размера (name / variant):
+//   exclusive  — seq (цикл из задания), std_seq, std_par, simd (1 поток), par (все потоки)
+//   inclusive  — seq, par
+//   inplace    — seq, par (exclusive на месте; копия входа не входит во время)
+//   segmented  — seq, par (inclusive, сегменты случайной длины ~1000)
+//   compact    — seq (std::copy_if), par: оставить x >= 2
+//   partition  — seq (подсчёт + запись двумя указателями), par: сначала x >= 2
+// Данные — int 0..3 (Philox): сумма 1e9 элементов помещается в int.
+// Проверка — один линейный проход без эталонного массива (out[i] = out[i-1] + in[i-1] ...),
+// чтобы 1B элементов помещался в память: вход + выход + флаги сегментов = 9 байт на элемент;
+// размеры, которым не хватает MemAvailable, пропускаются.
+//
+// ./scan_cpu [max_n=1000000000]
+// -DNO_PSTL — без std::execution::par (если нет TBB)
+
+#include <algorithm>   // copy, copy_if, min
+#include <cstdint>
+#include <cstdlib>     // atoll
+#include <fstream>     // /proc/meminfo
+#include <iostream>
+#include <numeric>     // exclusive_scan
+#include <string>
+#include <vector>
+#ifndef NO_PSTL
+#include <execution>   // std::execution::par (libstdc++: бэкенд TBB, -ltbb)
+#endif
+
+#include "../common/bench.hpp"      // bench_measure, BenchSuite
+#include "../common/numa_alloc.hpp" // numa_vector: первое касание параллельно
+#include "../common/philox.hpp"     // philox_int_par
+#include "../common/par_scan.hpp"
+
+volatile long long sink = 0;
+
+// CPU: последовательный exclusive scan (как в prac7_task2_scan_arg.cu)
+static void cpu_scan_exclusive(const int* in, int* out, long long n) {
+    long long run = 0;
+    for (long long i = 0; i < n; i++) {
+        out[i] = (int)run;
+        run += in[i];
+    }
+}
+
+// Свободная память (байт) по /proc/meminfo; 0 — неизвестно
+static long long mem_available() {
+    std::ifstream f("/proc/meminfo");
+    std::string key;
+    long long kb = 0;
+    std::string unit;
+    while (f >> key >> kb >> unit)
+        if (key == "MemAvailable:") return kb * 1024;
+    return 0;
+}
+
+static const auto keep = [](int x) { return x >= 2; };
+
+// ---------- проверки (один проход) ----------
+
+static bool check_exclusive(const int* in, const int* out, long long n) {
+    if (n > 0 && out[0] != 0) return false;
+    for (long long i = 1; i < n; i++)
+        if (out[i] != out[i - 1] + in[i - 1]) return false;
+    return true;
+}
+
+static bool check_inclusive(const int* in, const int* out, long long n) {
+    if (n > 0 && out[0] != in[0]) return false;
+    for (long long i = 1; i < n; i++)
+        if (out[i] != out[i - 1] + in[i]) return false;
+    return true;
+}
+
+static bool check_segmented(const int* in, const uint8_t* head, const int* out, long long n) {
+    for (long long i = 0; i < n; i++) {
+        int prev = (i == 0 || head[i]) ? 0 : out[i - 1];
+        if (out[i] != prev + in[i]) return false;
+    }
+    return true;
+}
+
+// compact / partition: порядок сохранён — сравниваем с последовательным обходом
+static bool check_partition(const int* in, const int* out, long long n, long long k, bool withRest) {
+    long long kt = 0, kf = k;
+    for (long long i = 0; i < n; i++) {
+        if (keep(in[i])) {
+            if (kt >= k || out[kt++] != in[i]) return false;
+        } else if (withRest) {
+            if (kf >= n || out[kf++] != in[i]) return false;
+        }
+    }
+    return kt == k && (!withRest || kf == n);
+}
+
+int main(int argc, char** argv) {
+    long long maxN = (argc > 1) ? std::atoll(argv[1]) : 1000000000LL;
+
+    std::vector<long long> sizes;
+    for (long long n = 1000; n <= maxN; n *= 10) sizes.push_back(n);
+
+    bench_set_threads(bench_max_threads());
+    std::cout << "threads=" << bench_max_threads() << " isa=" << stats_isa_name(stats_isa())
+#ifdef NO_PSTL
+              << " (std_par disabled: NO_PSTL)"
+#endif
+              << "\n";
+
+    BenchSuite suite;
+    bool allOk = true;
+
+    for (long long n : sizes) {
+        long long need = n * 9;
+        long long avail = mem_available();
+        if (avail > 0 && need > avail * 8 / 10) {
+            std::cout << "skip n=" << n << ": needs ~" << (need >> 20) << " MB, available "
+                      << (avail >> 20) << " MB\n";
+            continue;
+        }
+
+        BenchConfig cfg;
+        if (n >= 100000000) {                   // один вызов — сотни мс
+            cfg.min_reps = 3;
+            cfg.min_time_s = 0.0;
+        }
+
+        numa_vector<int> in(n), out(n);
+        numa_vector<uint8_t> head(n);
+        philox_int_par(in.data(), n, 7, 0, 3);
+        // начала сегментов: в среднем раз на 1000 элементов
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; i++)
+            head[i] = (uint8_t)((uint64_t)philox_mix64((uint64_t)i ^ 0x5EEDULL) % 1000 == 0);
+
+        const int* a = in.data();
+        int* o = out.data();
+        const uint8_t* h = head.data();
+        auto copyIn = [&] { std::copy(in.begin(), in.end(), out.begin()); };
+
+        // ---------- корректность (один раз, вне замеров) ----------
+        bool ok = true;
+        auto report = [&](const char* what, bool good) {
+            if (!good) std::cout << "ERROR: " << what << " n=" << n << "\n";
+            ok = ok && good;
+        };
+        scan_exclusive(a, o, n);                          report("exclusive simd", check_exclusive(a, o, n));
+        scan_exclusive_par(a, o, n);                      report("exclusive par", check_exclusive(a, o, n));
+        scan_inclusive_par(a, o, n);                      report("inclusive par", check_inclusive(a, o, n));
+        copyIn(); scan_exclusive_inplace_par(o, n);       report("inplace par", check_exclusive(a, o, n));
+        scan_inclusive_segmented_par(a, h, o, n);         report("segmented par", check_segmented(a, h, o, n));
+        long long k = compact_par(a, n, keep, o);         report("compact par", check_partition(a, o, n, k, false));
+        k = stable_partition_par(a, n, keep, o);          report("partition par", check_partition(a, o, n, k, true));
+        allOk = allOk && ok;
+
+        // ---------- exclusive ----------
+        suite.add(bench_measure("exclusive", "seq", n, [&] { cpu_scan_exclusive(a, o, n); }, cfg));
+        suite.add(bench_measure("exclusive", "std_seq", n, [&] { std::exclusive_scan(a, a + n, o, 0); }, cfg));
+#ifndef NO_PSTL
+        suite.add(bench_measure("exclusive", "std_par", n, [&] {
+            std::exclusive_scan(std::execution::par, a, a + n, o, 0);
+        }, cfg));
+#endif
+        suite.add(bench_measure("exclusive", "simd", n, [&] { sink = scan_exclusive(a, o, n); }, cfg));
+        suite.add(bench_measure("exclusive", "par", n, [&] { sink = scan_exclusive_par(a, o, n); }, cfg));
+
+        // ---------- inclusive ----------
+        suite.add(bench_measure("inclusive", "seq", n, [&] {
+            int run = 0;
+            for (long long i = 0; i < n; i++) { run += a[i]; o[i] = run; }
+        }, cfg));
+        suite.add(bench_measure("inclusive", "par", n, [&] { sink = scan_inclusive_par(a, o, n); }, cfg));
+
+        // ---------- in-place ----------
+        suite.add(bench_measure("inplace", "seq", n, [&] { cpu_scan_exclusive(o, o, n); }, copyIn, cfg));
+        suite.add(bench_measure("inplace", "par", n, [&] { sink = scan_exclusive_inplace_par(o, n); }, copyIn, cfg));
+
+        // ---------- segmented ----------
+        suite.add(bench_measure("segmented", "seq", n, [&] { seg_scan_block(a, h, o, n, 0, true); }, cfg));
+        suite.add(bench_measure("segmented", "par", n, [&] { scan_inclusive_segmented_par(a, h, o, n); }, cfg));
+
+        // ---------- compaction / partition ----------
+        suite.add(bench_measure("compact", "seq", n, [&] { sink = std::copy_if(a, a + n, o, keep) - o; }, cfg));
+        suite.add(bench_measure("compact", "par", n, [&] { sink = compact_par(a, n, keep, o); }, cfg));
+        suite.add(bench_measure("partition", "seq", n, [&] {
+            long long kt = 0;
+            for (long long i = 0; i < n; i++) kt += keep(a[i]) ? 1 : 0;
+            long long t = 0, f = kt;
+            for (long long i = 0; i < n; i++) {
+                if (keep(a[i])) o[t++] = a[i];
+                else o[f++] = a[i];
+            }
+            sink = kt;
+        }, cfg));
+        suite.add(bench_measure("partition", "par", n, [&] { sink = stable_partition_par(a, n, keep, o); }, cfg));
+
+        std::cout << "n=" << n << " " << (ok ? "OK" : "ERROR") << "\n";
+    }
+
+    suite.print_table();
+    suite.write_csv("scan_results.csv");
+    suite.write_json("scan_results.json");
+    std::cout << "Saved scan_results.csv, scan_results.json\n";
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// hybrid_split.cpp
+// mul2_kernel (out = in * 2) из task3_hybrid.cu совместно на CPU (OpenMP) и устройстве
+// OpenCL, но без фиксированного деления пополам: common/hetero.hpp мерит скорость каждого
+// исполнителя и подстраивает долю между итерациями (adaptive) или раздаёт работу кусками
+// по ходу (dynamic). Устройство — любое OpenCL: GPU или CPU (POCL), поэтому программа
+// проверяется и на машине без видеокарты.
+// Режимы (каждый — iters вызовов на одном массиве):
+//   cpu      — только OpenMP (cpu_mul2_openmp)
+//   device   — только OpenCL (копирование + ядро + копирование назад)
+//   fixed    — половина / половина, как в task3 / task4
+//   adaptive — доля устройства = Rd / (Rc + Rd) по скользящим оценкам скорости
+//   dynamic  — общий счётчик кусков, поток 0 ведёт устройство
+// Идеал — скорости cpu и device складываются: n / (n / cpu_ms + n / device_ms).
+// Если устройство — тот же CPU (POCL), оба исполнителя делят одни ядра и память,
+// идеал недостижим по определению: отчёт показывает, сколько от него получилось.
+//
+// ./hybrid_split [N=10000000] [iters=20] [device=auto|gpu|cpu] [cpu_chunk=65536] [dev_chunk=2097152]
+
+#include <algorithm>   // sort, max
+#include <cmath>       // fabsf
+#include <cstdlib>     // atoi, atoll
+#include <fstream>     // CSV
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include "../common/cl_runtime.hpp"  // среда OpenCL, программа (с дисковым кэшем), пул буферов
+#include "../common/hetero.hpp"      // HeteroExecutor
+
+// Устройство OpenCL для HeteroExecutor: буферы на весь массив, кусок [b, e) —
+// неблокирующая запись, ядро со смещением b, неблокирующее чтение. Время устройства —
+// от начала первой команды до конца последней (event profiling).
+struct ClMul2Device {
+    ClRuntime* rt = nullptr;
+    cl_kernel kernel = nullptr;
+    cl_mem bufIn = nullptr, bufOut = nullptr;
+    const float* in = nullptr;
+    float* out = nullptr;
+    std::vector<cl_event> events;
+
+    void submit(long long b, long long e) {
+        size_t off = sizeof(float) * (size_t)b, bytes = sizeof(float) * (size_t)(e - b);
+        cl_event ew = nullptr, ek = nullptr, er = nullptr;
+        cl_check(clEnqueueWriteBuffer(rt->queue, bufIn, CL_FALSE, off, bytes, in + b, 0, nullptr, &ew), "write(in)");
+        int end = (int)e;
+        cl_check(clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufIn), "arg0(in)");
+        cl_check(clSetKernelArg(kernel, 1, sizeof(cl_mem), &bufOut), "arg1(out)");
+        cl_check(clSetKernelArg(kernel, 2, sizeof(int), &end), "arg2(n)");
+        size_t offset = (size_t)b, global = (size_t)(e - b);
+        cl_check(clEnqueueNDRangeKernel(rt->queue, kernel, 1, &offset, &global, nullptr, 0, nullptr, &ek), "kernel");
+        cl_check(clEnqueueReadBuffer(rt->queue, bufOut, CL_FALSE, off, bytes, out + b, 0, nullptr, &er), "read(out)");
+        clFlush(rt->queue);
+        events.push_back(ew);
+        events.push_back(ek);
+        events.push_back(er);
+    }
+
+    double finish() {
+        if (events.empty()) return 0.0;
+        clWaitForEvents((cl_uint)events.size(), events.data());
+        cl_ulong first = ~(cl_ulong)0, last = 0;
+        for (cl_event ev : events) {
+            cl_ulong s = 0, e = 0;
+            clGetEventProfilingInfo(ev, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &s, nullptr);
+            clGetEventProfilingInfo(ev, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &e, nullptr);
+            first = std::min(first, s);
+            last = std::max(last, e);
+            clReleaseEvent(ev);
+        }
+        events.clear();
+        return (double)(last - first) * 1e-6;
+    }
+};
+
+// CPU: cpu_mul2_openmp из задания, но на кусок [b, e) в текущем потоке
+static void cpu_mul2(const float* in, float* out, long long b, long long e) {
+    for (long long i = b; i < e; i++) out[i] = in[i] * 2.0f;
+}
+
+struct ModeSummary {
+    HeteroMode mode;
+    double medianMs = 0;      // медиана total_ms по итерациям (без первой — прогрев)
+    double ratio = 0;         // доля устройства на последней итерации
+    double maxErr = 0;
+};
+
+static double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    return v.empty() ? 0.0 : v[v.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    long long N = (argc > 1) ? std::atoll(argv[1]) : 10000000;    // как в task3_hybrid.cu
+    int iters = (argc > 2) ? std::max(2, std::atoi(argv[2])) : 20;
+    std::string devArg = (argc > 3) ? argv[3] : "auto";
+    HeteroConfig cfg;
+    if (argc > 4) cfg.cpu_chunk = std::max(1LL, std::atoll(argv[4]));
+    if (argc > 5) cfg.dev_chunk = std::max(1LL, std::atoll(argv[5]));
+
+    // Устройство: GPU, если есть, иначе CPU (POCL)
+    ClRuntime* rt = nullptr;
+    if (devArg != "cpu") rt = cl_runtime(CL_DEVICE_TYPE_GPU);
+    if (!rt && devArg != "gpu") rt = cl_runtime(CL_DEVICE_TYPE_CPU);
+    if (!rt) {
+        std::cerr << "No OpenCL device found (" << devArg << ").\n";
+        return 1;
+    }
+
+    std::vector<float> h_in((size_t)N), h_out((size_t)N), h_ref((size_t)N);
+    for (long long i = 0; i < N; i++) {
+        h_in[(size_t)i] = (float)(i % 100) * 0.5f;
+        h_ref[(size_t)i] = h_in[(size_t)i] * 2.0f;
+    }
+
+    ClMul2Device dev;
+    dev.rt = rt;
+    dev.kernel = cl_kernel_get(*rt, cl_source(*rt, "mul2.cl"), "", "mul2_kernel");
+    dev.bufIn = cl_buffer_acquire(*rt, CL_MEM_READ_ONLY, sizeof(float) * (size_t)N);
+    dev.bufOut = cl_buffer_acquire(*rt, CL_MEM_WRITE_ONLY, sizeof(float) * (size_t)N);
+    dev.in = h_in.data();
+    dev.out = h_out.data();
+
+    std::cout << "N=" << N << " iters=" << iters << " omp_threads=" << omp_get_max_threads()
+              << "\nPlatform: " << cl_platform_name(rt->platform) << "\nDevice:   " << rt->device_key
+              << " (program from " << rt->last_program_from << ")\n";
+
+    HeteroDevice hd;
+    hd.submit = [&](long long b, long long e) { dev.submit(b, e); };
+    hd.finish = [&] { return dev.finish(); };
+    const float* in = h_in.data();
+    float* out = h_out.data();
+    HeteroCpuFn cpu = [=](long long b, long long e) { cpu_mul2(in, out, b, e); };
+
+    std::ofstream csv("hybrid_split.csv");
+    csv << "mode,iter,ratio,n_cpu,n_dev,cpu_ms,dev_ms,total_ms,melem_s,dev_chunks\n";
+
+    std::vector<ModeSummary> sums;
+    for (HeteroMode mode : {HeteroMode::CpuOnly, HeteroMode::DevOnly, HeteroMode::Fixed,
+                            HeteroMode::Adaptive, HeteroMode::Dynamic}) {
+        HeteroExecutor ex(cpu, hd, cfg);          // у каждого режима свои оценки скорости
+        ModeSummary ms;
+        ms.mode = mode;
+        std::vector<double> times;
+        if (mode == HeteroMode::Adaptive) std::cout << "\nadaptive: iter ratio(device) cpu_ms dev_ms total_ms\n";
+        for (int it = 0; it < iters; it++) {
+            std::fill(h_out.begin(), h_out.end(), 0.0f);
+            HeteroStep s = ex.run(N, mode);
+            if (it > 0) times.push_back(s.total_ms);  // первая итерация — прогрев
+            ms.ratio = s.ratio;
+            for (long long i = 0; i < N; i++)
+                ms.maxErr = std::max(ms.maxErr, (double)std::fabs(h_out[(size_t)i] - h_ref[(size_t)i]));
+            csv << hetero_mode_name(mode) << "," << it << "," << s.ratio << "," << s.n_cpu << "," << s.n_dev << ","
+                << s.cpu_ms << "," << s.dev_ms << "," << s.total_ms << "," << (double)N / s.total_ms * 1e-3 << ","
+                << s.dev_chunks << "\n";
+            if (mode == HeteroMode::Adaptive)
+                std::cout << std::setw(5) << it << std::fixed << std::setprecision(3) << std::setw(8) << s.ratio
+                          << std::setw(10) << s.cpu_ms << std::setw(10) << s.dev_ms << std::setw(10) << s.total_ms
+                          << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+        ms.medianMs = median(times);
+        sums.push_back(ms);
+    }
+
+    // ---------- сводка: достигнутая скорость против идеальной ----------
+    double cpuMs = sums[0].medianMs, devMs = sums[1].medianMs;
+    double idealMs = 1.0 / (1.0 / cpuMs + 1.0 / devMs);
+    double idealRatio = cpuMs / (cpuMs + devMs);     // доля устройства, при которой оба заканчивают вместе
+    std::cout << "\nideal combined: " << std::fixed << std::setprecision(3) << idealMs << " ms, "
+              << (double)N / idealMs * 1e-3 << " Melem/s at device share " << idealRatio << "\n";
+    std::cout << std::left << std::setw(10) << "mode" << std::right << std::setw(12) << "median_ms"
+              << std::setw(12) << "Melem/s" << std::setw(10) << "%ideal" << std::setw(14) << "device_share"
+              << std::setw(12) << "max_err" << "\n";
+    std::ofstream scsv("hybrid_split_summary.csv");
+    scsv << "mode,median_ms,melem_s,ideal_melem_s,efficiency,device_share,max_err\n";
+    bool ok = true;
+    for (const ModeSummary& m : sums) {
+        double thr = (double)N / m.medianMs * 1e-3;
+        double eff = idealMs / m.medianMs;
+        std::cout << std::left << std::setw(10) << hetero_mode_name(m.mode) << std::right << std::setprecision(3)
+                  << std::setw(12) << m.medianMs << std::setw(12) << thr << std::setprecision(1) << std::setw(9)
+                  << 100.0 * eff << "%" << std::setprecision(3) << std::setw(14) << m.ratio
+                  << std::setw(12) << m.maxErr << "\n";
+        scsv << hetero_mode_name(m.mode) << "," << m.medianMs << "," << thr << "," << (double)N / idealMs * 1e-3
+             << "," << eff << "," << m.ratio << "," << m.maxErr << "\n";
+        ok = ok && m.maxErr == 0.0;
+    }
+    std::cout << "Saved hybrid_split.csv, hybrid_split_summary.csv\n";
+
+    cl_buffer_release(*rt, dev.bufIn);
+    cl_buffer_release(*rt, dev.bufOut);
+    cl_runtime_release_all();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+// ------------------------------------------------------------
+// Ядро OpenCL практической работы 8
+//   mul2_kernel — то же, что в task2_gpu_cuda.cu / task3_hybrid.cu (out = in * 2).
+//   Запускается со смещением (global_work_offset = b): get_global_id(0) — сразу
+//   индекс в массиве, n — конец куска [b, n), так что любой кусок обрабатывается
+//   в общих буферах на весь массив.
+// ------------------------------------------------------------
+
+__kernel void mul2_kernel(__global const float* in,
+                          __global float* out,
+                          const int n)
+{
+    int idx = get_global_id(0);
+    if (idx < n) out[idx] = in[idx] * 2.0f;
+}
@@ -0,0 +1,125 @@
+#include <mpi.h>
+#include <algorithm>   // is_sorted, max, min
+#include <climits>     // INT_MAX
+#include <cstdint>
+#include <fstream>     // CSV
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../common/philox.hpp"     // счётчиковый генератор: каждый процесс генерирует свой кусок
+#include "../common/mpi_hybrid.hpp" // MPI_Init_thread + потоки OpenMP на процесс
+#include "../common/mpi_sort.hpp"   // build_counts_displs + sample_sort_mpi
+
+// Распределённая сортировка выборкой: N ключей int, куски — build_counts_displs (как в task1),
+// каждый процесс генерирует свой кусок Philox (без Scatterv с rank 0).
+//   ./sample_sort_mpi [N=100000000] [dist=uniform|dup] [oversample=4] [reps=1]
+// dist=dup — всего 1000 различных ключей: проверка делителей с разрешением равных ключей.
+// Проверка: каждый кусок отсортирован, последний ключ процесса r <= первого ключа r + 1,
+// число ключей и сумма хешей ключей (не зависит от порядка) те же, что до сортировки.
+// Печать (rank 0): время фаз (максимум по процессам), дисбаланс max / среднее длин кусков
+// после обмена, объём обмена; строка дописывается в sample_sort_results.csv.
+
+// Хеш мультимножества ключей: сумма mix(ключ) по модулю 2^64
+static uint64_t keys_hash(const std::vector<int>& a) {
+    uint64_t h = 0;
+    #pragma omp parallel for schedule(static) reduction(+:h)
+    for (long long i = 0; i < (long long)a.size(); i++) h += philox_mix64((uint64_t)(uint32_t)a[(size_t)i]);
+    return h;
+}
+
+int main(int argc, char** argv) {
+    HybridInfo hy = hybrid_init(&argc, &argv);
+
+    int rank = 0, p = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    int N = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 100000000;   // до ~2.1e9 (int)
+    std::string dist = (argc > 2) ? argv[2] : "uniform";
+    int oversample = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 4;
+    int reps = (argc > 4) ? std::max(1, std::atoi(argv[4])) : 1;
+    int hi = (dist == "dup") ? 999 : INT_MAX;
+
+    std::vector<int> counts, displs;
+    build_counts_displs(N, p, counts, displs);
+
+    SampleSortStats best;
+    best.t_total = 1e30;
+    bool ok = true;
+    std::vector<int> local;
+    for (int r = 0; r < reps; r++) {
+        // свой кусок [displs[rank]; displs[rank] + counts[rank]) глобального массива
+        local.assign((size_t)counts[rank], 0);
+        philox_int_par(local.data(), counts[rank], 123, 0, hi, displs[rank]);
+        uint64_t hIn = keys_hash(local);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        SampleSortStats st;
+        sample_sort_mpi(local, MPI_COMM_WORLD, oversample, &st);
+
+        // ---------- проверка ----------
+        bool good = std::is_sorted(local.begin(), local.end());
+        // граница с соседом: последний ключ предыдущего непустого процесса <= нашего первого
+        long long has = local.empty() ? 0 : 1;
+        int last = local.empty() ? INT_MIN : local.back(), prevLast = INT_MIN;
+        std::vector<int> lasts(p);
+        std::vector<long long> hasAll(p);
+        MPI_Allgather(&last, 1, MPI_INT, lasts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        MPI_Allgather(&has, 1, MPI_LONG_LONG, hasAll.data(), 1, MPI_LONG_LONG, MPI_COMM_WORLD);
+        for (int q = 0; q < rank; q++)
+            if (hasAll[q]) prevLast = std::max(prevLast, lasts[q]);
+        if (!local.empty() && prevLast > local.front()) good = false;
+        uint64_t hOut = keys_hash(local), hSum[2] = {0, 0}, hLoc[2] = {hIn, hOut};
+        MPI_Allreduce(hLoc, hSum, 2, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+        long long nOut = st.n_out, nAll = 0;
+        MPI_Allreduce(&nOut, &nAll, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+        good = good && hSum[0] == hSum[1] && nAll == N;
+        int goodAll = 0, goodLoc = good ? 1 : 0;
+        MPI_Allreduce(&goodLoc, &goodAll, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        ok = ok && goodAll;
+
+        // ---------- времена фаз: максимум по процессам ----------
+        double t[5] = {st.t_local, st.t_splitters, st.t_exchange, st.t_merge, st.t_total}, tMax[5];
+        MPI_Allreduce(t, tMax, 5, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        if (tMax[4] < best.t_total) {
+            best = st;
+            best.t_local = tMax[0];
+            best.t_splitters = tMax[1];
+            best.t_exchange = tMax[2];
+            best.t_merge = tMax[3];
+            best.t_total = tMax[4];
+        }
+    }
+
+    // длины кусков после обмена и объём обмена (последний повтор: данные те же)
+    long long nMax = 0, nMin = 0, sent = 0, sentMax = 0;
+    MPI_Reduce(&best.n_out, &nMax, 1, MPI_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&best.n_out, &nMin, 1, MPI_LONG_LONG, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&best.sent_bytes, &sent, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&best.sent_bytes, &sentMax, 1, MPI_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        double avg = (double)N / p;
+        double imbalance = (double)nMax / avg;
+        std::cout << "SampleSort: N=" << N << " dist=" << dist << " procs=" << p << " threads=" << hy.threads
+                  << " oversample=" << oversample << (ok ? " OK" : " ERROR") << "\n";
+        std::cout << "time_total_s=" << best.t_total << " local_sort_s=" << best.t_local
+                  << " splitters_s=" << best.t_splitters << " exchange_s=" << best.t_exchange
+                  << " merge_s=" << best.t_merge << "\n";
+        std::cout << "keys_per_rank min=" << nMin << " max=" << nMax << " imbalance=" << imbalance
+                  << " exchange_MB=" << (double)sent / 1e6 << " (max per rank " << (double)sentMax / 1e6 << ")"
+                  << " Mkeys/s=" << (double)N / best.t_total / 1e6 << "\n";
+
+        bool fresh = !std::ifstream("sample_sort_results.csv").good();
+        std::ofstream csv("sample_sort_results.csv", std::ios::app);
+        if (fresh) csv << "N,dist,procs,threads,oversample,time_total_s,local_sort_s,splitters_s,exchange_s,merge_s,"
+                          "imbalance,exchange_bytes,ok\n";
+        csv << N << "," << dist << "," << p << "," << hy.threads << "," << oversample << "," << best.t_total << ","
+            << best.t_local << "," << best.t_splitters << "," << best.t_exchange << "," << best.t_merge << ","
+            << imbalance << "," << sent << "," << (ok ? 1 : 0) << "\n";
+    }
+
+    MPI_Finalize();
+    return ok ? 0 : 1;
+}
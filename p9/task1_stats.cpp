@@ -0,0 +1,128 @@
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include <string>
+
+#include "../common/philox.hpp" // счётчиковый генератор: каждый процесс генерирует свой кусок
+#include "../common/stream_stats.hpp" // потоковая статистика по файлу + слияние моментов (Chan)
+#include "../common/mpi_stats.hpp"    // моменты как производный тип MPI + операция слияния
+#include "../common/mpi_io.hpp"       // коллективное чтение своего куска файла (MPI-IO)
+#include "../common/mpi_hybrid.hpp"   // MPI_Init_thread + потоки OpenMP на процесс
+#include "../common/mpi_decomp.hpp"   // build_counts_displs: разбиение массива между процессами
+
+// Потоковый режим: файл double (сотни ГБ) делится между процессами по элементам,
+// каждый процесс читает только свой кусок порциями с двойной буферизацией:
+//   read / mmap — POSIX (common/stream_stats.hpp), файл на локальном диске или общей ФС;
+//   mpiio       — MPI-IO, коллективные MPI_File_iread_at_all (common/mpi_io.hpp):
+//                 реализация MPI объединяет запросы процессов (для параллельных ФС).
+// Моменты процессов сливаются формулой Чана одной MPI_Reduce (moments_mpi_op)
+static void run_file(const std::string& path, const std::string& mode, int rank, int p) {
+    long long total = mpiio_file_elements<double>(path, MPI_COMM_WORLD);
+    long long first = total * rank / p;                 // кусок этого процесса
+    long long count = total * (rank + 1) / p - first;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t0 = MPI_Wtime();
+    Moments lm;
+    double wait = 0.0;
+    if (mode == "mpiio") {
+        const long long chunk = (64LL << 20) / (long long)sizeof(double);   // 64 МБ, как в StreamConfig
+        wait = mpiio_stream<double>(path, first, count, chunk,
+            [&](const double* a, long long n, long long) { moments_merge(lm, moments_par(a, n)); });
+    } else {
+        StreamConfig cfg;
+        cfg.mode = (mode == "mmap") ? StreamMode::Mmap : StreamMode::Read;
+        cfg.first = first;
+        cfg.count = count;
+        StreamResult r = stream_stats_file<double>(path, cfg);
+        lm = r.m;
+        wait = r.wait_seconds;
+    }
+
+    Moments m;
+    MPI_Reduce(&lm, &m, 1, moments_mpi_type(), moments_mpi_op(), 0, MPI_COMM_WORLD);
+    double t1 = MPI_Wtime();
+
+    double wait_max = 0.0;
+    MPI_Reduce(&wait, &wait_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        std::cout << "Task1 (file " << path << ", " << mode << "): N=" << m.n << " procs=" << p << "\n";
+        std::cout << "mean=" << m.mean << " stddev=" << m.stddev()
+                  << " min=" << m.min << " max=" << m.max << "\n";
+        std::cout << "Execution time: " << (t1 - t0) << " s, "
+                  << (double)total * sizeof(double) / (t1 - t0) / 1e9 << " GB/s"
+                  << " (max I/O wait " << wait_max << " s)\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    // гибридный режим: процесс на сокет / узел, моменты считают потоки OpenMP
+    hybrid_init(&argc, &argv);
+
+    int rank = 0, p = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    // Данные из файла: ./task1 --file data.bin [read|mmap|mpiio]
+    if (argc >= 3 && std::string(argv[1]) == "--file") {
+        run_file(argv[2], argc >= 4 ? argv[3] : "read", rank, p);
+        MPI_Finalize();
+        return 0;
+    }
+
+    // Размер массива можно передать аргументом: ./task1 1000000
+    int N = 1000000;
+    if (argc >= 2) N = std::max(1, std::atoi(argv[1]));
+
+    std::vector<int> counts, displs;
+    build_counts_displs(N, p, counts, displs);
+
+    // Каждый процесс сразу генерирует свой кусок [displs[rank]; displs[rank] + counts[rank])
+    // глобального массива: Philox зависит только от (seed, индекс), поэтому данные
+    // побитово те же, что при генерации целиком на root, и Scatterv не нужен
+    std::vector<double> local(counts[rank]);
+
+    double tg0 = MPI_Wtime();
+    philox_uniform_par(local.data(), counts[rank], 123, 0.0, 1.0, displs[rank]);
+    double tg1 = MPI_Wtime();
+
+    // Контрольная сумма данных (одинакова при любом числе процессов)
+    // (неблокирующая MPI_Ireduce: идёт по сети, пока считаются моменты)
+    unsigned long long cs_local = philox_checksum(local.data(), counts[rank], displs[rank]), cs = 0;
+    MPI_Request cs_req;
+    MPI_Ireduce(&cs_local, &cs, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD, &cs_req);
+
+    double t0 = MPI_Wtime();
+
+    // Локальные моменты (mean, M2 = sum (x - mean)^2): два прохода по своему куску,
+    // без sum(x^2)/N - mean^2, которое теряет точность при большом среднем
+    Moments lm = moments_par(local.data(), counts[rank]);
+    MPI_Wait(&cs_req, MPI_STATUS_IGNORE);
+
+    // Одна редукция: n, mean, M2, min, max — производный тип MPI, слияние формулой Чана
+    Moments m;
+    MPI_Reduce(&lm, &m, 1, moments_mpi_type(), moments_mpi_op(), 0, MPI_COMM_WORLD);
+
+    double t1 = MPI_Wtime();
+
+    if (rank == 0) {
+        // mean = sum/N, stddev = sqrt(M2/N)
+        double mean = m.mean;
+        double stddev = m.stddev();
+
+        std::cout << "Task1: N=" << N << " procs=" << p << " ";
+        hybrid_print(std::cout);
+        std::cout << "\n";
+        std::cout << "mean=" << mean << " stddev=" << stddev << "\n";
+        std::cout << "Execution time: " << (t1 - t0) << " s\n";
+        std::cout << "Generation time (rank 0): " << (tg1 - tg0) << " s"
+                  << ", checksum=" << std::hex << cs << std::dec << "\n";
+    }
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,377 @@
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+#include <string>
+
+#include "../common/philox.hpp" // матрица генерируется по глобальным индексам: каждый процесс — свои элементы
+#include "../common/mpi_hybrid.hpp" // MPI_Init_thread + потоки OpenMP на процесс
+#include "../common/iter_solve_mpi.hpp" // генератор системы, Якоби и CG по строкам (режим compare)
+
+// Метод Гаусса с частичным выбором ведущего элемента (LU-разложение расширенной
+// матрицы [A | b]) на 2D блочно-циклическом распределении, как в ScaLAPACK:
+//  - процессы образуют решётку Pr x Pc; блок nb x nb с номером (I, J) хранит
+//    процесс (I mod Pr, J mod Pc). Когда k растёт, активная часть матрицы
+//    по-прежнему есть у всех процессов (при блочном разбиении по строкам
+//    процессы с верхними строками простаивали);
+//  - владелец строки / столбца вычисляется за O(1) (owner_of), без перебора;
+//  - шаг = панель из nb столбцов:
+//      1) столбец процессов, хранящий панель, раскладывает её по столбцам:
+//         поиск ведущего (MPI_MAXLOC по столбцу), перестановка строк, исключение;
+//      2) панель вместе с перестановками расходится по строке процессов
+//         конвейерным кольцом (ring_bcast), перестановки применяются к остальным столбцам;
+//      3) строка процессов с ведущим блоком считает U12 = L11^-1 A12 и
+//         рассылает его кольцом по столбцу процессов;
+//      4) все обновляют свой кусок A22 -= L21 * U12 (OpenMP).
+//    Кольцо пересылает сообщение частями: процесс принимает часть, сразу
+//    отправляет её дальше неблокирующим MPI_Isend и, получив всё, начинает
+//    обновление, не дожидаясь, пока сообщение дойдёт до остальных;
+//  - b — последний столбец расширенной матрицы, прямой ход для него делается
+//    вместе с разложением; обратный ход распределённый (x копируется всем);
+//  - проверка: невязка ||Ax - b|| / (||A|| ||x|| N eps), A генерируется заново.
+// Матрица по умолчанию — равномерная [-1; 1) БЕЗ диагонального преобладания
+// (без выбора ведущего элемента такой метод разваливается); "dd" — с преобладанием,
+// "spd" — симметричная с преобладанием (common/iter_solve.hpp: linsys_gen).
+// "compare" — после Гаусса та же система (тот же N и seed) решается Якоби и CG
+// (common/iter_solve_mpi.hpp, строки кусками по процессам): время до решения и max |x - x_gauss|.
+static const long long RING_SEG = 1 << 16;   // часть сообщения в кольце (double)
+
+// Сколько из n глобальных индексов (блоки по nb, циклически по np) у процесса ip
+static int numroc(int n, int nb, int ip, int np) {
+    int nblocks = n / nb;
+    int count = (nblocks / np) * nb;
+    int extra = nblocks % np;
+    if (ip < extra) count += nb;
+    else if (ip == extra) count += n % nb;
+    return count;
+}
+
+// Процесс (в своём измерении решётки), хранящий глобальный индекс g
+static int owner_of(int g, int nb, int np) { return (g / nb) % np; }
+
+// Глобальный индекс -> локальный (у владельца) и обратно
+static int g2l(int g, int nb, int np) { return (g / nb / np) * nb + g % nb; }
+static int l2g(int l, int nb, int ip, int np) { return ((l / nb) * np + ip) * nb + l % nb; }
+
+// Конвейерная рассылка по кольцу root -> root+1 -> ... частями по RING_SEG:
+// часть s пересылается дальше, пока принимается часть s+1. Запросы отправки
+// добавляются в fwd — буфер нельзя менять до MPI_Waitall(fwd)
+static void ring_bcast(double* buf, long long n, int root, MPI_Comm comm, int tag,
+                       std::vector<MPI_Request>& fwd) {
+    int me = 0, np = 1;
+    MPI_Comm_rank(comm, &me);
+    MPI_Comm_size(comm, &np);
+    if (np == 1 || n == 0) return;
+    int next = (me + 1) % np, prev = (me - 1 + np) % np;
+    for (long long off = 0; off < n; off += RING_SEG) {
+        int c = (int)std::min(RING_SEG, n - off);
+        if (me != root) MPI_Recv(buf + off, c, MPI_DOUBLE, prev, tag, comm, MPI_STATUS_IGNORE);
+        if (next != root) {
+            fwd.emplace_back();
+            MPI_Isend(buf + off, c, MPI_DOUBLE, next, tag, comm, &fwd.back());
+        }
+    }
+}
+
+// Локальная часть матрицы и её параметры
+struct Dist {
+    int N, nb, Pr, Pc, myrow, mycol;
+    int mloc, nloc;              // локальные строки / столбцы (столбцов N + 1: последний — b)
+    std::vector<double> A;       // по строкам, ведущая размерность nloc
+    MPI_Comm row_comm, col_comm; // ранг в row_comm = mycol, в col_comm = myrow
+    double* row(int li) { return A.data() + (size_t)li * nloc; }
+};
+
+// Локальная строка li расширенной матрицы (элемент (i, j) = Philox[i*(N+1) + j],
+// с преобладанием — a_ii += N: |a_ij| < 1, поэтому + N хватает)
+static void gen_local_row(const Dist& d, int li, LinsysKind kind, double* out) {
+    int gi = l2g(li, d.nb, d.myrow, d.Pr);
+    for (int lc0 = 0; lc0 < d.nloc; lc0 += d.nb) {
+        int w = std::min(d.nb, d.nloc - lc0);
+        linsys_gen(gi, d.N, l2g(lc0, d.nb, d.mycol, d.Pc), w, kind, out + lc0);
+    }
+}
+
+// Перестановка строк j и pv в локальных столбцах [c0; c0 + n) (по столбцу процессов)
+static void swap_rows(Dist& d, int j, int pv, int c0, int n) {
+    if (j == pv || n <= 0) return;
+    int oj = owner_of(j, d.nb, d.Pr), op = owner_of(pv, d.nb, d.Pr);
+    if (oj == d.myrow && op == d.myrow) {
+        std::swap_ranges(d.row(g2l(j, d.nb, d.Pr)) + c0, d.row(g2l(j, d.nb, d.Pr)) + c0 + n,
+                         d.row(g2l(pv, d.nb, d.Pr)) + c0);
+    } else if (oj == d.myrow) {
+        MPI_Sendrecv_replace(d.row(g2l(j, d.nb, d.Pr)) + c0, n, MPI_DOUBLE, op, 3, op, 3,
+                             d.col_comm, MPI_STATUS_IGNORE);
+    } else if (op == d.myrow) {
+        MPI_Sendrecv_replace(d.row(g2l(pv, d.nb, d.Pr)) + c0, n, MPI_DOUBLE, oj, 3, oj, 3,
+                             d.col_comm, MPI_STATUS_IGNORE);
+    }
+}
+
+// Разложение панели [k0; k0 + kb) столбцом процессов mycol == владелец панели.
+// piv[t] — с какой строкой переставлена строка k0 + t. Возвращает false, если ведущий = 0
+static bool factor_panel(Dist& d, int k0, int kb, std::vector<int>& piv) {
+    bool ok = true;
+    int lck = g2l(k0, d.nb, d.Pc);
+    std::vector<double> prow(kb);
+    for (int t = 0; t < kb; ++t) {
+        int j = k0 + t;
+
+        // ведущий элемент: максимум |a_ij| по строкам i >= j всех процессов столбца
+        struct { double v; int i; } loc = {-1.0, INT_MAX}, glob;
+        for (int li = numroc(j, d.nb, d.myrow, d.Pr); li < d.mloc; ++li) {
+            double v = std::fabs(d.row(li)[lck + t]);
+            if (v > loc.v) { loc.v = v; loc.i = l2g(li, d.nb, d.myrow, d.Pr); }
+        }
+        MPI_Allreduce(&loc, &glob, 1, MPI_DOUBLE_INT, MPI_MAXLOC, d.col_comm);
+        piv[t] = glob.i;
+        if (glob.v == 0.0) { ok = false; continue; }   // вырожденная матрица
+
+        // переставляем строки в пределах панели и рассылаем ведущую строку
+        swap_rows(d, j, glob.i, lck, kb);
+        int oj = owner_of(j, d.nb, d.Pr);
+        if (oj == d.myrow) std::copy(d.row(g2l(j, d.nb, d.Pr)) + lck, d.row(g2l(j, d.nb, d.Pr)) + lck + kb, prow.begin());
+        MPI_Bcast(prow.data(), kb, MPI_DOUBLE, oj, d.col_comm);
+
+        // исключение в пределах панели: l_ij = a_ij / a_jj, a_i,c -= l_ij * a_j,c
+        int first = numroc(j + 1, d.nb, d.myrow, d.Pr);
+        double inv = 1.0 / prow[t];
+        #pragma omp parallel for schedule(static) if (d.mloc - first > 256)
+        for (int li = first; li < d.mloc; ++li) {
+            double* a = d.row(li) + lck;
+            double l = a[t] * inv;
+            a[t] = l;
+            for (int c = t + 1; c < kb; ++c) a[c] -= l * prow[c];
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    // гибридный режим: процесс на сокет / узел, обновление A22 и панели — потоки OpenMP
+    // (MPI вызывается только главным потоком вне parallel-регионов: FUNNELED)
+    hybrid_init(&argc, &argv);
+
+    int rank = 0, p = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    // ./task2 N [nb] [Pr] [dd|spd] [compare]
+    int N = 256;
+    if (argc >= 2) N = std::max(1, std::atoi(argv[1]));
+    int nb = (argc >= 3) ? std::max(1, std::atoi(argv[2])) : 64;
+    int Pr = (argc >= 4) ? std::atoi(argv[3]) : 0;
+    std::string mat = (argc >= 5) ? argv[4] : "";
+    LinsysKind kind = mat == "dd" ? LinsysKind::DiagDominant : mat == "spd" ? LinsysKind::SymDominant : LinsysKind::Random;
+    bool compare = (argc >= 6) && std::string(argv[5]) == "compare";
+
+    // решётка процессов: Pr x Pc, по умолчанию ближе к квадрату (Pr <= Pc)
+    if (Pr <= 0 || p % Pr != 0) {
+        Pr = 1;
+        for (int r = 1; r * r <= p; ++r)
+            if (p % r == 0) Pr = r;
+    }
+
+    Dist d;
+    d.N = N;
+    d.nb = nb;
+    d.Pr = Pr;
+    d.Pc = p / Pr;
+    d.myrow = rank / d.Pc;
+    d.mycol = rank % d.Pc;
+    d.mloc = numroc(N, nb, d.myrow, d.Pr);
+    d.nloc = numroc(N + 1, nb, d.mycol, d.Pc);
+    MPI_Comm_split(MPI_COMM_WORLD, d.myrow, d.mycol, &d.row_comm);
+    MPI_Comm_split(MPI_COMM_WORLD, d.mycol, d.myrow, &d.col_comm);
+
+    // Каждый процесс генерирует только свои блоки: root ничего не рассылает
+    double tg0 = MPI_Wtime();
+    d.A.resize((size_t)d.mloc * d.nloc);
+    #pragma omp parallel for schedule(static)
+    for (int li = 0; li < d.mloc; ++li) gen_local_row(d, li, kind, d.row(li));
+    double tg1 = MPI_Wtime();
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t0 = MPI_Wtime();
+
+    // ===== Прямой ход: блочное LU с выбором ведущего элемента =====
+    bool ok = true;
+    std::vector<int> piv(nb);
+    std::vector<double> panel, ubuf;
+    std::vector<MPI_Request> fwd;
+    for (int k0 = 0; k0 < N; k0 += nb) {
+        int kb = std::min(nb, N - k0);
+        int pr = owner_of(k0, nb, d.Pr), pc = owner_of(k0, nb, d.Pc);
+        int lr0 = numroc(k0, nb, d.myrow, d.Pr);       // первая локальная строка >= k0
+        int lr1 = numroc(k0 + kb, nb, d.myrow, d.Pr);  // первая строка под панелью
+        int lc1 = numroc(k0 + kb, nb, d.mycol, d.Pc);  // первый столбец правее панели
+        int nr = d.nloc - lc1;
+
+        // 1) панель: [перестановки (kb) | строки lr0.. столбцов панели (по kb)]
+        panel.assign(kb + (size_t)(d.mloc - lr0) * kb, 0.0);
+        if (d.mycol == pc) {
+            ok = factor_panel(d, k0, kb, piv) && ok;
+            int lck = g2l(k0, nb, d.Pc);
+            for (int t = 0; t < kb; ++t) panel[t] = piv[t];
+            for (int li = lr0; li < d.mloc; ++li)
+                std::copy(d.row(li) + lck, d.row(li) + lck + kb, panel.begin() + kb + (size_t)(li - lr0) * kb);
+        }
+
+        // 2) панель — по строке процессов, перестановки — к столбцам правее панели
+        ring_bcast(panel.data(), (long long)panel.size(), pc, d.row_comm, 1, fwd);
+        const double* L = panel.data() + kb;
+        for (int t = 0; t < kb; ++t) swap_rows(d, k0 + t, (int)panel[t], lc1, nr);
+
+        // 3) U12 = L11^-1 A12 (L11 — единичная нижнетреугольная) и рассылка по столбцу
+        ubuf.resize((size_t)kb * nr);
+        if (d.myrow == pr) {
+            for (int t = 0; t < kb; ++t) {
+                double* u = d.row(lr0 + t) + lc1;
+                for (int s = 0; s < t; ++s) {
+                    double l = L[(size_t)t * kb + s];
+                    const double* us = d.row(lr0 + s) + lc1;
+                    #pragma omp simd
+                    for (int c = 0; c < nr; ++c) u[c] -= l * us[c];
+                }
+                std::copy(u, u + nr, ubuf.begin() + (size_t)t * nr);
+            }
+        }
+        ring_bcast(ubuf.data(), (long long)ubuf.size(), pr, d.col_comm, 2, fwd);
+
+        // 4) A22 -= L21 * U12: по строкам, столбцы — полосами, чтобы строки U12 оставались в кэше
+        const int CB = 512;
+        #pragma omp parallel for schedule(static)
+        for (int li = lr1; li < d.mloc; ++li) {
+            double* a = d.row(li) + lc1;
+            const double* l = L + (size_t)(li - lr0) * kb;
+            for (int c0 = 0; c0 < nr; c0 += CB) {
+                int c1 = std::min(nr, c0 + CB);
+                for (int t = 0; t < kb; ++t) {
+                    double lt = l[t];
+                    if (lt == 0.0) continue;
+                    const double* u = ubuf.data() + (size_t)t * nr;
+                    #pragma omp simd
+                    for (int c = c0; c < c1; ++c) a[c] -= lt * u[c];
+                }
+            }
+        }
+
+        // пересылки дальше по кольцу должны закончиться до переиспользования буферов
+        MPI_Waitall((int)fwd.size(), fwd.data(), MPI_STATUSES_IGNORE);
+        fwd.clear();
+    }
+    double t1 = MPI_Wtime();
+
+    // ===== Обратный ход: U x = y (y — преобразованный столбец b), x есть у всех =====
+    std::vector<double> x(N, 0.0);
+    std::vector<int> gcol(d.nloc);
+    for (int lc = 0; lc < d.nloc; ++lc) gcol[lc] = l2g(lc, nb, d.mycol, d.Pc);
+    int nblocks = (N + nb - 1) / nb;
+    std::vector<double> s(nb), sum(nb);
+    for (int K = nblocks - 1; K >= 0; --K) {
+        int k0 = K * nb, kb = std::min(nb, N - k0);
+        int pr = owner_of(k0, nb, d.Pr), pc = owner_of(k0, nb, d.Pc);
+        if (d.myrow == pr) {
+            // частичные суммы y_i - sum_{j >= k0+kb} u_ij x_j по своим столбцам
+            int lr = g2l(k0, nb, d.Pr);
+            int lc1 = numroc(k0 + kb, nb, d.mycol, d.Pc);
+            for (int t = 0; t < kb; ++t) {
+                const double* a = d.row(lr + t);
+                double acc = 0.0;
+                for (int lc = lc1; lc < d.nloc; ++lc)
+                    acc += (gcol[lc] == N) ? a[lc] : -a[lc] * x[gcol[lc]];
+                s[t] = acc;
+            }
+            MPI_Reduce(s.data(), sum.data(), kb, MPI_DOUBLE, MPI_SUM, pc, d.row_comm);
+            if (d.mycol == pc) {
+                // треугольный блок на диагонали
+                int lc = g2l(k0, nb, d.Pc);
+                for (int t = kb - 1; t >= 0; --t) {
+                    const double* a = d.row(lr + t) + lc;
+                    double v = sum[t];
+                    for (int u = t + 1; u < kb; ++u) v -= a[u] * x[k0 + u];
+                    x[k0 + t] = v / a[t];
+                }
+            }
+        }
+        MPI_Bcast(x.data() + k0, kb, MPI_DOUBLE, pr * d.Pc + pc, MPI_COMM_WORLD);
+    }
+    double t2 = MPI_Wtime();
+
+    // ===== Проверка: r = A x - b на исходной матрице (генерируется заново по строкам) =====
+    std::vector<double> part(2 * (size_t)d.mloc, 0.0), rowv(d.nloc);
+    for (int li = 0; li < d.mloc; ++li) {
+        gen_local_row(d, li, kind, rowv.data());
+        double r = 0.0, an = 0.0;
+        for (int lc = 0; lc < d.nloc; ++lc) {
+            if (gcol[lc] == N) { r -= rowv[lc]; continue; }
+            r += rowv[lc] * x[gcol[lc]];
+            an += std::fabs(rowv[lc]);
+        }
+        part[2 * li] = r;
+        part[2 * li + 1] = an;
+    }
+    std::vector<double> full(part.size());
+    MPI_Reduce(part.data(), full.data(), (int)part.size(), MPI_DOUBLE, MPI_SUM, 0, d.row_comm);
+    double norms[2] = {0.0, 0.0}, gnorms[2] = {0.0, 0.0};   // ||r||_inf, ||A||_inf
+    if (d.mycol == 0) {
+        for (int li = 0; li < d.mloc; ++li) {
+            norms[0] = std::max(norms[0], std::fabs(full[2 * li]));
+            norms[1] = std::max(norms[1], full[2 * li + 1]);
+        }
+        MPI_Reduce(norms, gnorms, 2, MPI_DOUBLE, MPI_MAX, 0, d.col_comm);
+    }
+    int all_ok = 0, my_ok = ok ? 1 : 0;
+    MPI_Reduce(&my_ok, &all_ok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        double xn = 0.0;
+        for (double v : x) xn = std::max(xn, std::fabs(v));
+        double resid = gnorms[0] / (gnorms[1] * xn * N * 2.220446049250313e-16);
+        double flops = 2.0 / 3.0 * (double)N * N * N;
+        std::cout << "Task2: N=" << N << " procs=" << p << " grid=" << d.Pr << "x" << d.Pc
+                  << " nb=" << nb << " matrix=" << linsys_name(kind) << " ";
+        hybrid_print(std::cout);
+        std::cout << "\n";
+        std::cout << "Example x[0]=" << x[0] << ", x[N-1]=" << x[N - 1] << "\n";
+        std::cout << "Execution time: " << (t2 - t0) << " s (factor " << (t1 - t0) << " s, "
+                  << flops / (t1 - t0) / 1e9 << " GFLOP/s; solve " << (t2 - t1) << " s)\n";
+        std::cout << "Generation time (rank 0): " << (tg1 - tg0) << " s\n";
+        std::cout << "Residual ||Ax-b||/(||A|| ||x|| N eps) = " << resid
+                  << (all_ok ? "" : " (matrix is singular)") << (resid < 16.0 ? " OK" : " FAILED") << "\n";
+    }
+
+    // ===== compare: Якоби и CG на той же системе (строки кусками, x_gauss есть у всех) =====
+    if (compare) {
+        std::vector<double>().swap(d.A);                 // матрица Гаусса больше не нужна
+        LinsysLocal sys = linsys_local_mpi(N, kind, MPI_COMM_WORLD);
+        IterConfig cfg;
+        for (int method = 0; method < 2; ++method) {
+            // Якоби сходится при строгом диагональном преобладании, CG — только на симметричной
+            bool applicable = method == 0 ? kind != LinsysKind::Random : kind == LinsysKind::SymDominant;
+            if (!applicable) {
+                if (rank == 0) std::cout << (method == 0 ? "Jacobi" : "CG") << ": skipped (needs "
+                                         << (method == 0 ? "dd or spd" : "spd") << " matrix)\n";
+                continue;
+            }
+            std::vector<double> xi(N, 0.0);
+            MPI_Barrier(MPI_COMM_WORLD);
+            IterResult res = method == 0 ? jacobi_mpi(sys, xi, MPI_COMM_WORLD, cfg) : cg_mpi(sys, xi, MPI_COMM_WORLD, cfg);
+            double tmax = 0.0, diff = 0.0;
+            MPI_Reduce(&res.time, &tmax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            for (int i = 0; i < N; ++i) diff = std::max(diff, std::fabs(xi[i] - x[i]));
+            if (rank == 0)
+                std::cout << (method == 0 ? "Jacobi" : "CG") << ": " << res.iters << " iterations, " << tmax
+                          << " s (Gauss " << (t2 - t0) << " s, speedup " << (t2 - t0) / tmax << "), resid "
+                          << res.resid << (res.converged ? " <= tol (converged)" : " > tol (NOT CONVERGED)")
+                          << ", max|x - x_gauss| = " << diff << "\n";
+        }
+    }
+
+    MPI_Comm_free(&d.row_comm);
+    MPI_Comm_free(&d.col_comm);
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <mpi.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+#include "../common/mpi_hybrid.hpp"     // MPI_Init_thread + потоки OpenMP на процесс
+#include "../common/iter_solve_mpi.hpp" // система задания 2, Якоби и CG по строкам
+
+// Задание 2 итерационными методами: та же система, что у task2_gauss (тот же Philox и seed),
+// строки — кусками по процессам, внутри процесса — потоки OpenMP (произведение на вектор, SIMD).
+//   ./task2_iter [N=8192] [spd|dd] [tol=1e-13] [max_iter=1000]
+// spd — симметричная с диагональным преобладанием: решают оба метода; dd — только Якоби
+// (CG требует симметричной матрицы). Печать: итерации, время до решения, среднее / максимальное
+// время итерации и доля обменов (MPI_Allgatherv + MPI_Allreduce); каждая итерация каждого
+// метода — строка iter_history.csv (время — максимум по процессам).
+// Для сравнения с Гауссом на той же системе: task2_gauss N nb Pr spd compare.
+int main(int argc, char** argv) {
+    hybrid_init(&argc, &argv);
+
+    int rank = 0, p = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    int N = (argc >= 2) ? std::max(1, std::atoi(argv[1])) : 8192;
+    std::string mat = (argc >= 3) ? argv[2] : "spd";
+    LinsysKind kind = mat == "dd" ? LinsysKind::DiagDominant : LinsysKind::SymDominant;
+    IterConfig cfg;
+    if (argc >= 4) cfg.tol = std::atof(argv[3]);
+    if (argc >= 5) cfg.max_iter = std::max(1, std::atoi(argv[4]));
+
+    double tg0 = MPI_Wtime();
+    LinsysLocal sys = linsys_local_mpi(N, kind, MPI_COMM_WORLD);
+    double tg1 = MPI_Wtime();
+
+    if (rank == 0) {
+        std::cout << "Task2 (iterative): N=" << N << " procs=" << p << " matrix=" << linsys_name(kind)
+                  << " tol=" << cfg.tol << " ";
+        hybrid_print(std::cout);
+        std::cout << "\nGeneration time (rank 0): " << (tg1 - tg0) << " s, "
+                  << (double)sys.A.size() * sizeof(double) / 1e6 << " MB per process\n";
+    }
+
+    std::ofstream csv;
+    if (rank == 0) {
+        csv.open("iter_history.csv");
+        csv << "method,N,procs,iter,resid,t_iter_s,t_matvec_s,t_comm_s\n";
+    }
+    bool ok = true;
+    for (int method = 0; method < 2; ++method) {
+        if (method == 1 && kind != LinsysKind::SymDominant) {
+            if (rank == 0) std::cout << "CG: skipped (needs spd matrix)\n";
+            continue;
+        }
+        const char* name = method == 0 ? "Jacobi" : "CG";
+        std::vector<double> x(N, 0.0);
+        MPI_Barrier(MPI_COMM_WORLD);
+        IterResult res = method == 0 ? jacobi_mpi(sys, x, MPI_COMM_WORLD, cfg) : cg_mpi(sys, x, MPI_COMM_WORLD, cfg);
+
+        // время итераций — максимум по процессам (итерации синхронны из-за Allreduce)
+        int n = (int)res.history.size();
+        std::vector<double> loc(3 * (size_t)n), mx(3 * (size_t)n);
+        for (int i = 0; i < n; ++i) {
+            loc[3 * (size_t)i] = res.history[(size_t)i].t_total;
+            loc[3 * (size_t)i + 1] = res.history[(size_t)i].t_matvec;
+            loc[3 * (size_t)i + 2] = res.history[(size_t)i].t_comm;
+        }
+        MPI_Reduce(loc.data(), mx.data(), 3 * n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        double tmax = 0.0;
+        MPI_Reduce(&res.time, &tmax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+        // проверка: ||b - A x||_inf / (||A||_inf ||x||_inf N eps) по своим строкам
+        std::vector<double> ax((size_t)sys.rows());
+        linsys_matvec_par(sys, x.data(), ax.data());
+        double nrm[2] = {0.0, 0.0}, gnrm[2] = {0.0, 0.0};   // ||r||_inf, ||A||_inf
+        for (int li = 0; li < sys.rows(); ++li) {
+            nrm[0] = std::max(nrm[0], std::fabs(ax[(size_t)li] - sys.b[(size_t)li]));
+            double an = 0.0;
+            for (int j = 0; j < N; ++j) an += std::fabs(sys.row(li)[j]);
+            nrm[1] = std::max(nrm[1], an);
+        }
+        MPI_Reduce(nrm, gnrm, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+        if (rank == 0) {
+            double sumIt = 0.0, maxIt = 0.0, sumComm = 0.0;
+            for (int i = 0; i < n; ++i) {
+                sumIt += mx[3 * (size_t)i];
+                maxIt = std::max(maxIt, mx[3 * (size_t)i]);
+                sumComm += mx[3 * (size_t)i + 2];
+                csv << name << "," << N << "," << p << "," << res.history[(size_t)i].iter << ","
+                    << res.history[(size_t)i].resid << "," << mx[3 * (size_t)i] << "," << mx[3 * (size_t)i + 1]
+                    << "," << mx[3 * (size_t)i + 2] << "\n";
+            }
+            double xn = 0.0;
+            for (double v : x) xn = std::max(xn, std::fabs(v));
+            double resid = gnrm[0] / (gnrm[1] * xn * N * 2.220446049250313e-16);
+            std::cout << name << ": " << res.iters << " iterations, time to solution " << tmax << " s, iteration avg "
+                      << (n ? sumIt / n : 0.0) << " s / max " << maxIt << " s, comm " << (sumIt > 0 ? 100.0 * sumComm / sumIt : 0.0)
+                      << "%, " << 2.0 * N * N * n / std::max(sumIt, 1e-12) / 1e9 << " GFLOP/s (mat-vec)\n";
+            // вердикт — только по критерию останова; масштабированная невязка — справочно (без порога:
+            // у task2_gauss / task2_lu_omp порог 16 для прямых методов, итерационным до него далеко)
+            std::cout << "  ||b-Ax||/||b|| = " << res.resid << (res.converged ? " <= " : " > ") << cfg.tol
+                      << (res.converged ? " (converged)" : " (NOT CONVERGED)") << ", x[0]=" << x[0] << ", x[N-1]=" << x[N - 1]
+                      << "\n  scaled residual ||Ax-b||/(||A|| ||x|| N eps) = " << resid << "\n";
+            ok = ok && res.converged;
+        }
+    }
+    if (rank == 0) std::cout << "saved iter_history.csv\n";
+
+    MPI_Finalize();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+#include <omp.h>
+
+#include "../common/lu_tiled.hpp"   // плиточное LU (OpenMP tasks + depend), прямой и обратный ход
+#include "../common/iter_solve.hpp" // linsys_gen — та же система, что у task2_gauss
+
+// Задание 2 на одном узле без MPI: плиточное LU с частичным выбором ведущего элемента,
+// задачи OpenMP с зависимостями по плиткам (панель, перестановки + TRSM, GEMM).
+//   ./task2_lu_omp [N=4096] [nb=128] [dd|spd]
+// Система [A | b] — linsys_gen (тот же Philox и seed, что у task2_gauss): x[0] и x[N-1]
+// совпадают с выводом task2_gauss для тех же N и матрицы. Проверка — невязка
+// ||Ax-b|| / (||A|| ||x|| N eps) на заново сгенерированной матрице.
+// Для сравнения печатается скорость ядра gemm на одном потоке (потолок для разложения).
+int main(int argc, char** argv) {
+    int N = (argc >= 2) ? std::max(1, std::atoi(argv[1])) : 4096;
+    int nb = (argc >= 3) ? std::max(LU_MR, std::atoi(argv[2])) : LU_NB;
+    std::string mat = (argc >= 4) ? argv[3] : "";
+    LinsysKind kind = mat == "dd" ? LinsysKind::DiagDominant : mat == "spd" ? LinsysKind::SymDominant : LinsysKind::Random;
+
+    // ---------- генерация сразу в плитки ----------
+    double tg0 = omp_get_wtime();
+    TiledMatrix M(N, nb);
+    std::vector<double> b((size_t)M.size(), 0.0);
+    #pragma omp parallel
+    {
+        std::vector<double> row((size_t)N + 1);
+        #pragma omp for schedule(static)
+        for (int i = 0; i < N; ++i) {
+            linsys_gen(i, N, 0, N + 1, kind, row.data());
+            for (int J = 0; J * nb < N; ++J)
+                std::copy(row.begin() + (size_t)J * nb, row.begin() + std::min(N, (J + 1) * nb),
+                          M.tile(i / nb, J) + (size_t)(i % nb) * nb);
+            b[(size_t)i] = row[(size_t)N];
+        }
+    }
+    double tg1 = omp_get_wtime();
+
+    // ---------- ядро gemm на одном потоке ----------
+    std::vector<double> ta((size_t)nb * nb, 1e-3), tb((size_t)nb * nb, 1e-3), tc((size_t)nb * nb, 0.0);
+    int reps = std::max(1, (int)(2e8 / ((double)nb * nb * nb)));
+    double tk0 = omp_get_wtime();
+    for (int r = 0; r < reps; ++r) lu_gemm_tile(tc.data(), ta.data(), tb.data(), nb);
+    double kernelGflops = 2.0 * nb * nb * nb * reps / (omp_get_wtime() - tk0) / 1e9;
+
+    // ---------- разложение и решение ----------
+    std::vector<int> ipiv;
+    double t0 = omp_get_wtime();
+    bool ok = lu_tiled_par(M, ipiv);
+    double t1 = omp_get_wtime();
+    lu_solve_tiled(M, ipiv, b);
+    double t2 = omp_get_wtime();
+    std::vector<double> x(b.begin(), b.begin() + N);
+
+    // ---------- проверка: r = A x - b по строкам исходной матрицы ----------
+    double rn = 0.0, an = 0.0, xn = 0.0;
+    #pragma omp parallel reduction(max:rn, an)
+    {
+        std::vector<double> row((size_t)N + 1);
+        #pragma omp for schedule(static)
+        for (int i = 0; i < N; ++i) {
+            linsys_gen(i, N, 0, N + 1, kind, row.data());
+            double r = -row[(size_t)N], a = 0.0;
+            for (int j = 0; j < N; ++j) {
+                r += row[(size_t)j] * x[(size_t)j];
+                a += std::fabs(row[(size_t)j]);
+            }
+            rn = std::max(rn, std::fabs(r));
+            an = std::max(an, a);
+        }
+    }
+    for (double v : x) xn = std::max(xn, std::fabs(v));
+    double resid = rn / (an * xn * N * 2.220446049250313e-16);
+    double flops = 2.0 / 3.0 * (double)N * N * N;
+
+    std::cout << "Task2 (tiled LU, OpenMP tasks): N=" << N << " nb=" << nb << " tiles=" << M.nt << "x" << M.nt
+              << " matrix=" << linsys_name(kind) << " threads=" << omp_get_max_threads() << "\n";
+    std::cout << "Example x[0]=" << x[0] << ", x[N-1]=" << x[(size_t)N - 1] << "\n";
+    std::cout << "Execution time: " << (t2 - t0) << " s (factor " << (t1 - t0) << " s, "
+              << flops / (t1 - t0) / 1e9 << " GFLOP/s; solve " << (t2 - t1) << " s)\n";
+    std::cout << "gemm tile kernel (1 thread): " << kernelGflops << " GFLOP/s, factor efficiency "
+              << 100.0 * flops / (t1 - t0) / 1e9 / (kernelGflops * omp_get_max_threads()) << "%\n";
+    std::cout << "Generation time: " << (tg1 - tg0) << " s\n";
+    std::cout << "Residual ||Ax-b||/(||A|| ||x|| N eps) = " << resid << (ok ? "" : " (matrix is singular)")
+              << (resid < 16.0 ? " OK" : " FAILED") << "\n";
+    return resid < 16.0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include "../common/csr_graph.hpp"   // CSR и генераторы (одинаковый граф на всех процессах)
+#include "../common/sssp.hpp"        // APSP по источникам (Дейкстра на поток)
+#include "../common/mpi_hybrid.hpp"  // MPI_Init_thread + потоки OpenMP на процесс
+
+// Задание 3 на разреженном графе, много источников сразу: граф O(N + M) есть у каждого
+// процесса целиком (каждый строит его сам по Philox — без рассылки), источники 0..sources-1
+// делятся между процессами кусками, внутри процесса — между потоками (schedule(dynamic)).
+// Обмен — только одна MPI_Reduce контрольных сумм строк, вместо N раундов рассылки строки k.
+//   ./task3_apsp_mpi [gen=sparse|floyd] [N] [deg=8] [sources=N] [check]
+// Для gen=floyd и sources=N checksum та же, что печатает task3_floyd (тот же граф и та же сумма);
+// check (N <= 4096) — на root плотный floyd_blocked_par того же графа.
+int main(int argc, char** argv) {
+    hybrid_init(&argc, &argv);
+
+    int rank = 0, p = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    std::string gen = (argc >= 2) ? argv[1] : "sparse";
+    bool floydGen = gen == "floyd";
+    int N = (argc >= 3) ? std::max(1, std::atoi(argv[2])) : (floydGen ? 2048 : 100000);
+    int deg = (argc >= 4) ? std::max(1, std::atoi(argv[3])) : 8;
+    int sources = (argc >= 5 && std::atoi(argv[4]) > 0) ? std::min(N, std::atoi(argv[4])) : N;
+    bool check = (argc >= 6) && std::string(argv[5]) == "check";
+
+    double t0 = MPI_Wtime();
+    CsrGraph g;
+    if (floydGen) {
+        g = csr_gen_floyd(N);
+    } else {
+        long long m = (long long)N * deg;
+        std::vector<GraphEdge> edges = graph_gen_edges(N, m);
+        g = csr_from_edges_par(N, edges.data(), m);
+    }
+    double tGraph = MPI_Wtime() - t0;
+
+    // источники процесса: [s0; s1), куски почти равной длины
+    int s0 = (int)((long long)sources * rank / p), s1 = (int)((long long)sources * (rank + 1) / p);
+    MPI_Barrier(MPI_COMM_WORLD);
+    t0 = MPI_Wtime();
+    unsigned long long csLocal = apsp_checksum_par(g, s0, s1), cs = 0;
+    double tLocal = MPI_Wtime() - t0;
+    MPI_Reduce(&csLocal, &cs, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    double t1 = MPI_Wtime();
+
+    // дисбаланс: у источников разное число достижимых вершин
+    double tMax = 0.0, tSum = 0.0, gMax = 0.0;
+    MPI_Reduce(&tLocal, &tMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&tLocal, &tSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&tGraph, &gMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    bool ok = true;
+    if (rank == 0) {
+        std::cout << "Task3 (CSR APSP, MPI): gen=" << gen << " N=" << N << " M=" << g.edges()
+                  << " sources=" << sources << " procs=" << p << " ";
+        hybrid_print(std::cout);
+        std::cout << "\n";
+        std::cout << "graph build " << gMax << " s, CSR " << (double)g.bytes() / 1e6 << " MB per process (dense "
+                  << (double)N * N * sizeof(int) / 1e6 << " MB)\n";
+        std::cout << "Execution time: " << (t1 - t0) << " s (" << sources / (t1 - t0) << " rows/s, imbalance max/avg "
+                  << tMax / (tSum / p) << "), checksum=" << std::hex << cs << std::dec << "\n";
+        if (check && N <= 4096) {
+            std::vector<int> D((size_t)N * N);
+            if (floydGen) {
+                #pragma omp parallel for schedule(static)
+                for (int i = 0; i < N; ++i) floyd_gen(D.data() + (size_t)i * N, N, i, 0, N);
+            } else {
+                csr_to_dense(g, D.data());
+            }
+            floyd_blocked_par(D.data(), N);
+            unsigned long long csRef = philox_checksum(D.data(), (long long)sources * N);
+            ok = csRef == cs;
+            std::cout << "Check vs dense Floyd: " << (ok ? "OK" : "MISMATCH") << "\n";
+        }
+    }
+
+    MPI_Finalize();
+    return ok ? 0 : 1;
+}
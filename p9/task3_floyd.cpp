@@ -0,0 +1,183 @@
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <string>
+
+#include "../common/floyd_tiled.hpp" // плитки, min-plus ядра без ветвлений, граф по глобальным индексам
+#include "../common/mpi_hybrid.hpp"  // MPI_Init_thread + потоки OpenMP на процесс
+
+// Блочный Флойд–Уоршелл на 2D решётке процессов Pr x Pc.
+// Плитки B x B распределены блочно-циклически: плитка (I, J) у процесса
+// (I mod Pr, J mod Pc). Раунд K (B промежуточных вершин сразу):
+//   1) владелец ведущей плитки (K, K) считает её;
+//   2) ведущая плитка — MPI_Bcast по строке и по столбцу процессов,
+//      они обновляют свои плитки строки K / столбца K;
+//   3) строка плиток K — MPI_Bcast по столбцам процессов, столбец плиток K —
+//      по строкам процессов (у каждого процесса: B x N/Pc и N/Pr x B);
+//   4) все обновляют свои остальные плитки min-plus ядром (OpenMP по плиткам).
+// За раунд процесс получает ~B*(N/Pr + N/Pc) чисел, т.е. на одну вершину k —
+// N/Pr + N/Pc вместо p*N при MPI_Allgather строки k с "пустыми" строками от всех.
+
+// Сколько из n глобальных индексов (блоки по nb, циклически по np) у процесса ip
+static int numroc(int n, int nb, int ip, int np) {
+    int nblocks = n / nb;
+    int count = (nblocks / np) * nb;
+    int extra = nblocks % np;
+    if (ip < extra) count += nb;
+    else if (ip == extra) count += n % nb;
+    return count;
+}
+
+// Глобальный индекс -> локальный (у владельца) и обратно
+static int g2l(int g, int nb, int np) { return (g / nb / np) * nb + g % nb; }
+static int l2g(int l, int nb, int ip, int np) { return ((l / nb) * np + ip) * nb + l % nb; }
+
+int main(int argc, char** argv) {
+    // гибридный режим: процесс на сокет / узел, плитки обновляют потоки OpenMP
+    hybrid_init(&argc, &argv);
+
+    int rank = 0, p = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    // ./task3 N [B] [Pr] [check]
+    int N = 256;
+    if (argc >= 2) N = std::max(1, std::atoi(argv[1]));
+    int B = (argc >= 3) ? std::max(1, std::atoi(argv[2])) : FLOYD_BLOCK;
+    int Pr = (argc >= 4) ? std::atoi(argv[3]) : 0;
+    bool check = (argc >= 5) && std::string(argv[4]) == "check";
+
+    // решётка процессов: по умолчанию ближе к квадрату (Pr <= Pc)
+    if (Pr <= 0 || p % Pr != 0) {
+        Pr = 1;
+        for (int r = 1; r * r <= p; ++r)
+            if (p % r == 0) Pr = r;
+    }
+    int Pc = p / Pr;
+    int myrow = rank / Pc, mycol = rank % Pc;
+    MPI_Comm row_comm, col_comm;                     // ранг в row_comm = mycol, в col_comm = myrow
+    MPI_Comm_split(MPI_COMM_WORLD, myrow, mycol, &row_comm);
+    MPI_Comm_split(MPI_COMM_WORLD, mycol, myrow, &col_comm);
+
+    int mloc = numroc(N, B, myrow, Pr);             // локальные строки и столбцы
+    int nloc = numroc(N, B, mycol, Pc);
+    int mt = (mloc + B - 1) / B, ntl = (nloc + B - 1) / B;   // локальные плитки
+
+    // Каждый процесс генерирует свои элементы сам (Philox по (i, j)): без Scatterv
+    std::vector<int> D((size_t)mloc * nloc);
+    #pragma omp parallel for schedule(static)
+    for (int li = 0; li < mloc; ++li)
+        for (int lc0 = 0; lc0 < nloc; lc0 += B)
+            floyd_gen(D.data() + (size_t)li * nloc + lc0, N, l2g(li, B, myrow, Pr),
+                      l2g(lc0, B, mycol, Pc), std::min(B, nloc - lc0));
+
+    auto tile = [&](int lI, int lJ) { return D.data() + (size_t)lI * B * nloc + (size_t)lJ * B; };
+    auto ldim = [&](int l, int n) { return std::min(B, n - l * B); };
+
+    std::vector<int> piv((size_t)B * B), rowp((size_t)B * nloc), colp((size_t)mloc * B);
+    double t_comm = 0.0;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t0 = MPI_Wtime();
+
+    int nt = (N + B - 1) / B;
+    for (int K = 0; K < nt; ++K) {
+        int kb = std::min(B, N - K * B);
+        int pr = K % Pr, pc = K % Pc;
+        int lK_r = K / Pr, lK_c = K / Pc;            // локальные номера плитки K у владельцев
+
+        // 1) ведущая плитка
+        if (myrow == pr && mycol == pc) {
+            int* kk = tile(lK_r, lK_c);
+            fw_tile_dep(kk, nloc, kk, nloc, kk, nloc, kb, kb, kb);
+            for (int i = 0; i < kb; ++i) std::copy(kk + (size_t)i * nloc, kk + (size_t)i * nloc + kb, piv.begin() + (size_t)i * kb);
+        }
+
+        // 2) ведущая плитка -> строка и столбец процессов; обновление строки / столбца плиток K
+        double c0 = MPI_Wtime();
+        if (myrow == pr) MPI_Bcast(piv.data(), kb * kb, MPI_INT, pc, row_comm);
+        if (mycol == pc) MPI_Bcast(piv.data(), kb * kb, MPI_INT, pr, col_comm);
+        t_comm += MPI_Wtime() - c0;
+        if (myrow == pr) {
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (int lJ = 0; lJ < ntl; ++lJ) {
+                if (mycol == pc && lJ == lK_c) continue;
+                int* c = tile(lK_r, lJ);
+                fw_tile_dep(c, nloc, piv.data(), kb, c, nloc, kb, ldim(lJ, nloc), kb);
+            }
+        }
+        if (mycol == pc) {
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (int lI = 0; lI < mt; ++lI) {
+                if (myrow == pr && lI == lK_r) continue;
+                int* c = tile(lI, lK_c);
+                fw_tile_dep(c, nloc, c, nloc, piv.data(), kb, ldim(lI, mloc), kb, kb);
+            }
+        }
+
+        // 3) строка плиток K (kb x nloc) — вниз по столбцу, столбец плиток K (mloc x kb) — вдоль строки
+        if (myrow == pr)
+            std::copy(tile(lK_r, 0), tile(lK_r, 0) + (size_t)kb * nloc, rowp.begin());
+        if (mycol == pc)
+            for (int li = 0; li < mloc; ++li)
+                std::copy(D.begin() + (size_t)li * nloc + (size_t)lK_c * B,
+                          D.begin() + (size_t)li * nloc + (size_t)lK_c * B + kb, colp.begin() + (size_t)li * kb);
+        // шагу 4 нужны обе полосы почти каждому процессу — перекрывать рассылки нечем
+        c0 = MPI_Wtime();
+        MPI_Bcast(rowp.data(), kb * nloc, MPI_INT, pr, col_comm);
+        MPI_Bcast(colp.data(), mloc * kb, MPI_INT, pc, row_comm);
+        t_comm += MPI_Wtime() - c0;
+
+        // 4) остальные плитки: D_IJ = min(D_IJ, D_IK (x) D_KJ)
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int lI = 0; lI < mt; ++lI)
+            for (int lJ = 0; lJ < ntl; ++lJ) {
+                if ((myrow == pr && lI == lK_r) || (mycol == pc && lJ == lK_c)) continue;
+                minplus_tile(tile(lI, lJ), nloc, colp.data() + (size_t)lI * B * kb, kb,
+                             rowp.data() + (size_t)lJ * B, nloc, ldim(lI, mloc), ldim(lJ, nloc), kb);
+            }
+    }
+
+    double t1 = MPI_Wtime();
+
+    // Контрольная сумма результата: куски складываются, не зависит от решётки и B
+    unsigned long long cs_local = 0, cs = 0;
+    for (int li = 0; li < mloc; ++li)
+        for (int lc0 = 0; lc0 < nloc; lc0 += B)
+            cs_local += philox_checksum(D.data() + (size_t)li * nloc + lc0, std::min(B, nloc - lc0),
+                                        (long long)l2g(li, B, myrow, Pr) * N + l2g(lc0, B, mycol, Pc));
+    MPI_Reduce(&cs_local, &cs, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    // D[0][0] и D[0][N-1] — у процессов строки 0
+    int ex[2] = {INT_MAX, INT_MAX}, gex[2];
+    if (myrow == 0 && mycol == 0) ex[0] = D[0];
+    if (myrow == 0 && mycol == (N - 1) / B % Pc) ex[1] = D[g2l(N - 1, B, Pc)];
+    MPI_Reduce(ex, gex, 2, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+    double comm_max = 0.0;
+    MPI_Reduce(&t_comm, &comm_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        std::cout << "Task3: N=" << N << " procs=" << p << " grid=" << Pr << "x" << Pc << " B=" << B << " ";
+        hybrid_print(std::cout);
+        std::cout << "\n";
+        std::cout << "Example: D[0][0]=" << gex[0] << ", D[0][N-1]=" << gex[1] << "\n";
+        std::cout << "Execution time: " << (t1 - t0) << " s (comm max " << comm_max << " s), checksum="
+                  << std::hex << cs << std::dec << "\n";
+        if (check) {
+            // проверка: исходный алгоритм на одном процессе
+            std::vector<int> R((size_t)N * N);
+            for (int i = 0; i < N; ++i) floyd_gen(R.data() + (size_t)i * N, N, i, 0, N);
+            floyd_naive(R.data(), N);
+            unsigned long long cs_ref = philox_checksum(R.data(), (long long)N * N);
+            std::cout << "Check vs naive: " << (cs_ref == cs ? "OK" : "MISMATCH") << "\n";
+        }
+    }
+
+    MPI_Comm_free(&row_comm);
+    MPI_Comm_free(&col_comm);
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include <omp.h>
+
+#include "../common/floyd_tiled.hpp" // блочный Флойд (OpenMP) и исходный алгоритм для сравнения
+
+// Задание 3 на одном узле: тот же граф, что в task3_floyd (MPI), и те же
+// плиточные ядра, параллельно по плиткам OpenMP. Печатает время исходного
+// алгоритма (если N не слишком большое) и блочного, и их контрольные суммы.
+// ./task3_floyd_omp N [B]
+int main(int argc, char** argv) {
+    int N = 2048;
+    if (argc >= 2) N = std::max(1, std::atoi(argv[1]));
+    int B = (argc >= 3) ? std::max(1, std::atoi(argv[2])) : FLOYD_BLOCK;
+
+    std::vector<int> D((size_t)N * N);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; ++i) floyd_gen(D.data() + (size_t)i * N, N, i, 0, N);
+
+    std::cout << "Task3 (OpenMP): N=" << N << " B=" << B << " threads=" << omp_get_max_threads() << "\n";
+
+    // исходный алгоритм — только для N <= 4096 (O(N^3) с ветвлениями, один поток)
+    unsigned long long cs_ref = 0;
+    bool have_ref = N <= 4096;
+    if (have_ref) {
+        std::vector<int> R = D;
+        double t0 = omp_get_wtime();
+        floyd_naive(R.data(), N);
+        double t1 = omp_get_wtime();
+        cs_ref = philox_checksum(R.data(), (long long)N * N);
+        std::cout << "naive:   " << (t1 - t0) << " s, checksum=" << std::hex << cs_ref << std::dec << "\n";
+    }
+
+    double t0 = omp_get_wtime();
+    floyd_blocked_par(D.data(), N, B);
+    double t1 = omp_get_wtime();
+    unsigned long long cs = philox_checksum(D.data(), (long long)N * N);
+    std::cout << "blocked: " << (t1 - t0) << " s, checksum=" << std::hex << cs << std::dec
+              << ", " << (double)N * N * N / (t1 - t0) / 1e9 << " Gupdates/s"
+              << (have_ref ? (cs == cs_ref ? " OK" : " MISMATCH") : "") << "\n";
+    std::cout << "Example: D[0][0]=" << D[0] << ", D[0][N-1]=" << D[N - 1] << "\n";
+    return 0;
+}
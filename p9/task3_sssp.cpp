@@ -0,0 +1,97 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include <omp.h>
+
+#include "../common/csr_graph.hpp"   // CSR, построение из списка рёбер, генераторы
+#include "../common/sssp.hpp"        // Дейкстра, delta-stepping, APSP по источникам
+#include "../common/floyd_tiled.hpp" // плотный Флойд для проверки
+
+// Задание 3 на разреженном графе: CSR вместо матрицы N x N, кратчайшие пути от
+// источников вместо O(N^3) Флойда.
+//   ./task3_sssp [gen=sparse|floyd] [N] [deg=8] [sources] [delta] [check]
+//   gen=sparse — N*deg случайных рёбер (веса 1..20), CSR строится из списка рёбер параллельно;
+//   gen=floyd  — граф задания 3 (floyd_gen, 30% рёбер): тот же, что у task3_floyd / task3_floyd_omp.
+// SSSP от вершины 0: Дейкстра (1 поток) и delta-stepping (все потоки), расстояния сравниваются.
+// APSP: строки 0..sources-1 (по умолчанию все при N <= 4096, иначе 16), источники — по потокам.
+// check (N <= 4096): плотная матрица того же графа + floyd_blocked_par, сравнение контрольных сумм
+// строк 0..sources-1 (для gen=floyd при sources=N — та же checksum, что печатает task3_floyd).
+int main(int argc, char** argv) {
+    std::string gen = (argc >= 2) ? argv[1] : "sparse";
+    bool floydGen = gen == "floyd";
+    int N = (argc >= 3) ? std::max(1, std::atoi(argv[2])) : (floydGen ? 2048 : 1000000);
+    int deg = (argc >= 4) ? std::max(1, std::atoi(argv[3])) : 8;
+    int sources = (argc >= 5 && std::atoi(argv[4]) > 0) ? std::min(N, std::atoi(argv[4])) : (N <= 4096 ? N : 16);
+    int delta = (argc >= 6) ? std::atoi(argv[5]) : 0;
+    bool check = (argc >= 7) && std::string(argv[6]) == "check";
+
+    std::cout << "Task3 (CSR, OpenMP): gen=" << gen << " N=" << N << " threads=" << omp_get_max_threads() << "\n";
+
+    // ---------- граф ----------
+    double t0 = omp_get_wtime();
+    CsrGraph g;
+    double tEdges = 0.0;
+    if (floydGen) {
+        g = csr_gen_floyd(N);
+    } else {
+        long long m = (long long)N * deg;
+        std::vector<GraphEdge> edges = graph_gen_edges(N, m);
+        tEdges = omp_get_wtime() - t0;
+        g = csr_from_edges_par(N, edges.data(), m);
+    }
+    double t1 = omp_get_wtime();
+    if (delta <= 0) delta = sssp_delta_auto(g);
+    std::cout << "graph: M=" << g.edges() << " avg_deg=" << (double)g.edges() / N
+              << ", CSR " << (double)g.bytes() / 1e6 << " MB (dense " << (double)N * N * sizeof(int) / 1e6 << " MB)"
+              << ", build " << (t1 - t0) << " s" << (floydGen ? "" : " (edges " + std::to_string(tEdges) + " s)") << "\n";
+
+    // ---------- SSSP от вершины 0 ----------
+    std::vector<int> ref((size_t)N), dist((size_t)N);
+    t0 = omp_get_wtime();
+    sssp_dijkstra(g, 0, ref.data());
+    double tDij = omp_get_wtime() - t0;
+
+    SsspStats st;
+    double tDelta = 1e30;
+    for (int r = 0; r < 3; ++r) {
+        t0 = omp_get_wtime();
+        sssp_delta_par(g, 0, delta, dist.data(), &st);
+        tDelta = std::min(tDelta, omp_get_wtime() - t0);
+    }
+    bool okSssp = dist == ref;
+    long long reached = std::count_if(ref.begin(), ref.end(), [](int x) { return x < FLOYD_INF; });
+    std::cout << "SSSP: dijkstra " << tDij << " s, delta-stepping (delta=" << delta << ") " << tDelta
+              << " s, speedup " << tDij / tDelta << ", reached " << reached << ", buckets=" << st.buckets
+              << " rounds=" << st.rounds << " relax/M=" << (double)st.relaxations / std::max(1LL, g.edges())
+              << (okSssp ? " OK" : " MISMATCH") << "\n";
+
+    // ---------- APSP: строки 0..sources-1 ----------
+    t0 = omp_get_wtime();
+    unsigned long long cs = apsp_checksum_par(g, 0, sources);
+    double tApsp = omp_get_wtime() - t0;
+    std::cout << "APSP: " << sources << " sources, " << tApsp << " s (" << sources / tApsp << " rows/s), checksum="
+              << std::hex << cs << std::dec << "\n";
+
+    bool ok = okSssp;
+    if (check && N <= 4096) {
+        // тот же граф плотной матрицей: для gen=floyd — прямо floyd_gen, как в task3_floyd_omp
+        std::vector<int> D((size_t)N * N);
+        if (floydGen) {
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < N; ++i) floyd_gen(D.data() + (size_t)i * N, N, i, 0, N);
+        } else {
+            csr_to_dense(g, D.data());
+        }
+        t0 = omp_get_wtime();
+        floyd_blocked_par(D.data(), N);
+        double tFloyd = omp_get_wtime() - t0;
+        unsigned long long csRef = philox_checksum(D.data(), (long long)sources * N);
+        bool okRow0 = std::equal(ref.begin(), ref.end(), D.begin());
+        std::cout << "Check vs dense Floyd (" << tFloyd << " s): checksum=" << std::hex << csRef << std::dec
+                  << ((csRef == cs && okRow0) ? " OK" : " MISMATCH") << "\n";
+        ok = ok && csRef == cs && okRow0;
+    }
+    return ok ? 0 : 1;
+}